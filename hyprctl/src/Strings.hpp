@@ -19,6 +19,11 @@ commands:
     dismissnotify [amount] → Dismisses all or up to AMOUNT notifications
     dispatch <dispatcher> [args] → Issue a dispatch to call a keybind
                           dispatcher with arguments
+    framebuffers        → Prints the offscreen framebuffers every monitor keeps
+                          and how much memory they take
+    frametimes [trace]  → Prints how long each stage of recent frames took on
+                          every monitor. 'frametimes trace' dumps the recent
+                          timeline as a Chrome trace (JSON)
     getoption <option>  → Gets the config option status (values)
     globalshortcuts     → Lists all global shortcuts
     hyprpaper ...       → Issue a hyprpaper request
@@ -51,6 +56,8 @@ commands:
     setprop ...         → Sets a window property
     getprop ...         → Gets a window property
     splash              → Get the current splash
+    spawnstats          → Prints how many processes exec dispatchers started and
+                          how long starting them took
     switchxkblayout ... → Sets the xkb layout index for a keyboard
     systeminfo          → Get system info
     version             → Prints the hyprland version, meaning flags, commit
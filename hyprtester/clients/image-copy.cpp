@@ -0,0 +1,282 @@
+#include <cstring>
+#include <sys/poll.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <print>
+#include <format>
+#include <string>
+
+#include <wayland-client.h>
+#include <wayland.hpp>
+#include <ext-image-capture-source-v1.hpp>
+#include <ext-image-copy-capture-v1.hpp>
+
+#include <hyprutils/memory/SharedPtr.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+
+using Hyprutils::Math::Vector2D;
+using namespace Hyprutils::Memory;
+
+// one capture session and the frame in flight on it
+struct SCapture {
+    std::string                                    name;
+    CSharedPointer<CCExtImageCopyCaptureSessionV1> session;
+    CSharedPointer<CCExtImageCopyCaptureFrameV1>   frame;
+    CSharedPointer<CCWlShmPool>                    shmPool;
+    CSharedPointer<CCWlBuffer>                     shmBuf;
+    Vector2D                                       size;
+    int                                            shmFd     = -1;
+    uint32_t                                       format    = 0;
+    bool                                           hasFormat = false;
+};
+
+struct SWlState {
+    wl_display*                  display;
+    CSharedPointer<CCWlRegistry> registry;
+
+    // protocols
+    CSharedPointer<CCWlSeat>                               wlSeat;
+    CSharedPointer<CCWlShm>                                wlShm;
+    CSharedPointer<CCWlOutput>                             wlOutput;
+    CSharedPointer<CCExtOutputImageCaptureSourceManagerV1> sourceManager;
+    CSharedPointer<CCExtImageCopyCaptureManagerV1>         copyManager;
+
+    // capture stuff
+    CSharedPointer<CCWlPointer>                          pointer;
+    CSharedPointer<CCExtImageCaptureSourceV1>            source;
+    CSharedPointer<CCExtImageCopyCaptureCursorSessionV1> cursorSession;
+    SCapture                                             output, cursor;
+};
+
+static bool debug, shouldExit;
+
+template <typename... Args>
+//NOLINTNEXTLINE
+static void clientLog(std::format_string<Args...> fmt, Args&&... args) {
+    std::println("{}", std::vformat(fmt.get(), std::make_format_args(args...)));
+    std::fflush(stdout);
+}
+
+template <typename... Args>
+//NOLINTNEXTLINE
+static void debugLog(std::format_string<Args...> fmt, Args&&... args) {
+    if (!debug)
+        return;
+    std::println("{}", std::vformat(fmt.get(), std::make_format_args(args...)));
+    std::fflush(stdout);
+}
+
+static bool bindRegistry(SWlState& state) {
+    state.registry = makeShared<CCWlRegistry>((wl_proxy*)wl_display_get_registry(state.display));
+
+    state.registry->setGlobal([&](CCWlRegistry* r, uint32_t id, const char* name, uint32_t version) {
+        const std::string NAME = name;
+        if (NAME == "wl_shm") {
+            debugLog("  > binding to global: {} (version {}) with id {}", name, version, id);
+            state.wlShm = makeShared<CCWlShm>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_shm_interface, 1));
+        } else if (NAME == "wl_seat") {
+            debugLog("  > binding to global: {} (version {}) with id {}", name, version, id);
+            state.wlSeat = makeShared<CCWlSeat>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_seat_interface, 9));
+        } else if (NAME == "wl_output" && !state.wlOutput) {
+            debugLog("  > binding to global: {} (version {}) with id {}", name, version, id);
+            state.wlOutput = makeShared<CCWlOutput>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_output_interface, 4));
+        } else if (NAME == "ext_output_image_capture_source_manager_v1") {
+            debugLog("  > binding to global: {} (version {}) with id {}", name, version, id);
+            state.sourceManager = makeShared<CCExtOutputImageCaptureSourceManagerV1>(
+                (wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &ext_output_image_capture_source_manager_v1_interface, 1));
+        } else if (NAME == "ext_image_copy_capture_manager_v1") {
+            debugLog("  > binding to global: {} (version {}) with id {}", name, version, id);
+            state.copyManager = makeShared<CCExtImageCopyCaptureManagerV1>(
+                (wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &ext_image_copy_capture_manager_v1_interface, 1));
+        }
+    });
+    state.registry->setGlobalRemove([](CCWlRegistry* r, uint32_t id) { debugLog("Global {} removed", id); });
+
+    wl_display_roundtrip(state.display);
+
+    if (!state.wlShm || !state.wlSeat || !state.wlOutput || !state.sourceManager || !state.copyManager) {
+        clientLog("Failed to get protocols from Hyprland");
+        return false;
+    }
+
+    return true;
+}
+
+static bool createShm(SWlState& state, SCapture& capture) {
+    const size_t STRIDE = capture.size.x * 4;
+    const size_t SIZE   = capture.size.y * STRIDE;
+
+    if (capture.shmBuf) {
+        capture.shmBuf->sendDestroy();
+        capture.shmBuf.reset();
+    }
+
+    if (capture.shmPool) {
+        capture.shmPool->sendDestroy();
+        capture.shmPool.reset();
+        close(capture.shmFd);
+        capture.shmFd = -1;
+    }
+
+    const auto NAME = std::format("/wl-shm-image-copy-{}", capture.name);
+    capture.shmFd   = shm_open(NAME.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (capture.shmFd < 0)
+        return false;
+
+    if (shm_unlink(NAME.c_str()) < 0 || ftruncate(capture.shmFd, SIZE) < 0) {
+        close(capture.shmFd);
+        capture.shmFd = -1;
+        return false;
+    }
+
+    capture.shmPool = makeShared<CCWlShmPool>(state.wlShm->sendCreatePool(capture.shmFd, SIZE));
+    if (!capture.shmPool->resource())
+        return false;
+
+    capture.shmBuf = makeShared<CCWlBuffer>(capture.shmPool->sendCreateBuffer(0, capture.size.x, capture.size.y, STRIDE, capture.format));
+    return capture.shmBuf->resource();
+}
+
+static void captureFrame(SWlState& state, SCapture& capture) {
+    if (capture.frame) {
+        capture.frame->sendDestroy();
+        capture.frame.reset();
+    }
+
+    capture.frame = makeShared<CCExtImageCopyCaptureFrameV1>(capture.session->sendCreateFrame());
+
+    capture.frame->setReady([&](CCExtImageCopyCaptureFrameV1* f) { clientLog("{} frame ready {}x{}", capture.name, (int)capture.size.x, (int)capture.size.y); });
+    capture.frame->setFailed([&](CCExtImageCopyCaptureFrameV1* f, uint32_t reason) { clientLog("{} frame failed {}", capture.name, reason); });
+
+    capture.frame->sendAttachBuffer(capture.shmBuf->resource());
+    capture.frame->sendDamageBuffer(0, 0, capture.size.x, capture.size.y);
+    capture.frame->sendCapture();
+}
+
+static void setupCapture(SWlState& state, SCapture& capture) {
+    capture.session->setBufferSize([&](CCExtImageCopyCaptureSessionV1* s, uint32_t w, uint32_t h) { capture.size = {w, h}; });
+
+    capture.session->setShmFormat([&](CCExtImageCopyCaptureSessionV1* s, uint32_t format) {
+        if (capture.hasFormat)
+            return;
+
+        capture.format    = format;
+        capture.hasFormat = true;
+    });
+
+    capture.session->setDone([&](CCExtImageCopyCaptureSessionV1* s) {
+        debugLog("{} session done, {}x{} format {}", capture.name, (int)capture.size.x, (int)capture.size.y, capture.format);
+
+        if (!capture.hasFormat || !createShm(state, capture)) {
+            clientLog("{} session has no usable buffer", capture.name);
+            return;
+        }
+
+        captureFrame(state, capture);
+    });
+
+    capture.session->setStopped([&](CCExtImageCopyCaptureSessionV1* s) { clientLog("{} session stopped", capture.name); });
+}
+
+static bool setupSessions(SWlState& state) {
+    state.pointer = makeShared<CCWlPointer>(state.wlSeat->sendGetPointer());
+    if (!state.pointer->resource())
+        return false;
+
+    state.source = makeShared<CCExtImageCaptureSourceV1>(state.sourceManager->sendCreateSource(state.wlOutput->resource()));
+    if (!state.source->resource())
+        return false;
+
+    state.output.name    = "output";
+    state.output.session = makeShared<CCExtImageCopyCaptureSessionV1>(state.copyManager->sendCreateSession(state.source->resource(), (extImageCopyCaptureManagerV1Options)0));
+    if (!state.output.session->resource())
+        return false;
+
+    setupCapture(state, state.output);
+
+    state.cursorSession = makeShared<CCExtImageCopyCaptureCursorSessionV1>(state.copyManager->sendCreatePointerCursorSession(state.source->resource(), state.pointer->resource()));
+    if (!state.cursorSession->resource())
+        return false;
+
+    state.cursorSession->setEnter([&](CCExtImageCopyCaptureCursorSessionV1* s) { clientLog("cursor enter"); });
+    state.cursorSession->setLeave([&](CCExtImageCopyCaptureCursorSessionV1* s) { clientLog("cursor leave"); });
+    state.cursorSession->setPosition([&](CCExtImageCopyCaptureCursorSessionV1* s, int32_t x, int32_t y) { clientLog("cursor position {} {}", x, y); });
+    state.cursorSession->setHotspot([&](CCExtImageCopyCaptureCursorSessionV1* s, int32_t x, int32_t y) { debugLog("cursor hotspot {} {}", x, y); });
+
+    state.cursor.name    = "cursor";
+    state.cursor.session = makeShared<CCExtImageCopyCaptureSessionV1>(state.cursorSession->sendGetCaptureSession());
+    if (!state.cursor.session->resource())
+        return false;
+
+    setupCapture(state, state.cursor);
+
+    return true;
+}
+
+static void parseRequest(SWlState& state, std::string req) {
+    if (req.contains("exit"))
+        shouldExit = true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 1 && argc != 2)
+        clientLog("Only the \"--debug\" switch is allowed, it turns on debug logs.");
+
+    if (argc == 2 && std::string{argv[1]} == "--debug")
+        debug = true;
+
+    SWlState state;
+
+    // WAYLAND_DISPLAY env should be set to the correct one
+    state.display = wl_display_connect(nullptr);
+    if (!state.display) {
+        clientLog("Failed to connect to wayland display");
+        return -1;
+    }
+
+    if (!bindRegistry(state) || !setupSessions(state))
+        return -1;
+
+    clientLog("started");
+
+    std::array<char, 1024> readBuf;
+    readBuf.fill(0);
+
+    wl_display_flush(state.display);
+
+    struct pollfd fds[2] = {{.fd = wl_display_get_fd(state.display), .events = POLLIN | POLLOUT}, {.fd = STDIN_FILENO, .events = POLLIN}};
+    while (!shouldExit && poll(fds, 2, 0) != -1) {
+        if (fds[0].revents & POLLIN) {
+            wl_display_flush(state.display);
+
+            if (wl_display_prepare_read(state.display) == 0) {
+                wl_display_read_events(state.display);
+                wl_display_dispatch_pending(state.display);
+            } else
+                wl_display_dispatch(state.display);
+
+            int ret = 0;
+            do {
+                ret = wl_display_dispatch_pending(state.display);
+                wl_display_flush(state.display);
+            } while (ret > 0);
+        }
+
+        if (fds[1].revents & POLLIN) {
+            ssize_t bytesRead = read(fds[1].fd, readBuf.data(), 1023);
+            if (bytesRead == -1)
+                continue;
+            readBuf[bytesRead] = 0;
+
+            parseRequest(state, std::string{readBuf.data()});
+            wl_display_flush(state.display);
+        }
+    }
+
+    wl_display* display = state.display;
+    state               = {};
+
+    wl_display_disconnect(display);
+    return 0;
+}
@@ -135,4 +135,74 @@ std::string getFromSocket(const std::string& cmd) {
     close(SERVERSOCKET);
 
     return reply;
-}
\ No newline at end of file
+}
+std::vector<std::string> getFromSocketKeepAlive(const std::vector<std::string>& cmds) {
+    const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (SERVERSOCKET < 0) {
+        std::println("socket: Couldn't open a socket (1)");
+        return {};
+    }
+
+    auto t = timeval{.tv_sec = 5, .tv_usec = 0};
+    setsockopt(SERVERSOCKET, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(struct timeval));
+
+    sockaddr_un serverAddress = {0};
+    serverAddress.sun_family  = AF_UNIX;
+
+    std::string socketPath = getRuntimeDir() + "/" + HIS + "/.socket.sock";
+
+    strncpy(serverAddress.sun_path, socketPath.c_str(), sizeof(serverAddress.sun_path) - 1);
+
+    if (connect(SERVERSOCKET, rc<sockaddr*>(&serverAddress), SUN_LEN(&serverAddress)) < 0) {
+        std::println("Couldn't connect to {}. (3)", socketPath);
+        close(SERVERSOCKET);
+        return {};
+    }
+
+    // all requests go out in one go, the replies have to come back in order
+    std::string request = "[[KEEPALIVE]]";
+    for (const auto& cmd : cmds) {
+        request += cmd;
+        request += '\0';
+    }
+
+    if (write(SERVERSOCKET, request.data(), request.size()) < 0) {
+        std::println("Couldn't write (4)");
+        close(SERVERSOCKET);
+        return {};
+    }
+
+    const auto readExactly = [SERVERSOCKET](char* data, size_t len) {
+        size_t got = 0;
+        while (got < len) {
+            const auto LEN = read(SERVERSOCKET, data + got, len - got);
+            if (LEN <= 0)
+                return false;
+            got += LEN;
+        }
+        return true;
+    };
+
+    std::vector<std::string> replies;
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        uint8_t lenBytes[4] = {0};
+        if (!readExactly(rc<char*>(lenBytes), sizeof(lenBytes))) {
+            std::println("Couldn't read (5)");
+            break;
+        }
+
+        const uint32_t LEN   = lenBytes[0] | (lenBytes[1] << 8) | (lenBytes[2] << 16) | (sc<uint32_t>(lenBytes[3]) << 24);
+        std::string    reply = std::string(LEN, '\0');
+        if (!readExactly(reply.data(), LEN)) {
+            std::println("Couldn't read (5)");
+            break;
+        }
+
+        replies.emplace_back(std::move(reply));
+    }
+
+    close(SERVERSOCKET);
+
+    return replies;
+}
@@ -13,4 +13,5 @@ struct SInstanceData {
 };
 
 std::vector<SInstanceData> instances();
-std::string                getFromSocket(const std::string& cmd);
\ No newline at end of file
+std::string                getFromSocket(const std::string& cmd);
+std::vector<std::string>   getFromSocketKeepAlive(const std::vector<std::string>& cmds);
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "tests.hpp"
+#include "build.hpp"
+
+#include <hyprutils/os/FileDescriptor.hpp>
+#include <hyprutils/os/Process.hpp>
+
+#include <sys/poll.h>
+#include <csignal>
+#include <chrono>
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+#define SP CSharedPointer
+
+struct SClient {
+    SP<CProcess>           proc;
+    std::array<char, 1024> readBuf;
+    CFileDescriptor        readFd, writeFd;
+    struct pollfd          fds;
+
+    // everything the client printed so far
+    std::string output;
+};
+
+static int ret = 0;
+
+// reads from the client until it has printed the needle, or the timeout is up
+static bool waitForOutput(SClient& client, const std::string& needle, int timeoutMs = 2000) {
+    const auto DEADLINE = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (!client.output.contains(needle)) {
+        const auto LEFT = std::chrono::duration_cast<std::chrono::milliseconds>(DEADLINE - std::chrono::steady_clock::now()).count();
+        if (LEFT <= 0 || poll(&client.fds, 1, LEFT) != 1 || !(client.fds.revents & POLLIN))
+            break;
+
+        ssize_t bytesRead = read(client.fds.fd, client.readBuf.data(), client.readBuf.size() - 1);
+        if (bytesRead <= 0)
+            break;
+
+        client.output.append(client.readBuf.data(), bytesRead);
+    }
+
+    if (!client.output.contains(needle)) {
+        NLog::log("{}image-copy client never printed \"{}\", got: {}", Colors::RED, needle, client.output);
+        return false;
+    }
+
+    return true;
+}
+
+static bool startClient(SClient& client) {
+    client.proc = makeShared<CProcess>(binaryDir + "/image-copy", std::vector<std::string>{});
+
+    client.proc->addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+
+    int pipeFds1[2], pipeFds2[2];
+    if (pipe(pipeFds1) != 0 || pipe(pipeFds2) != 0) {
+        NLog::log("{}Unable to open pipe to client", Colors::RED);
+        return false;
+    }
+
+    client.writeFd = CFileDescriptor(pipeFds1[1]);
+    client.proc->setStdinFD(pipeFds1[0]);
+
+    client.readFd = CFileDescriptor(pipeFds2[0]);
+    client.proc->setStdoutFD(pipeFds2[1]);
+
+    client.proc->runAsync();
+
+    close(pipeFds1[0]);
+    close(pipeFds2[1]);
+
+    client.fds = {.fd = client.readFd.get(), .events = POLLIN};
+
+    if (!waitForOutput(client, "started"))
+        return false;
+
+    NLog::log("{}Started image-copy client", Colors::YELLOW);
+
+    return true;
+}
+
+static void stopClient(SClient& client) {
+    std::string cmd = "exit\n";
+    write(client.writeFd.get(), cmd.c_str(), cmd.length());
+
+    kill(client.proc->pid(), SIGKILL);
+    client.proc.reset();
+}
+
+static bool test() {
+    SClient client;
+
+    OK(getFromSocket("/dispatch movecursor 0 0"));
+
+    if (!startClient(client))
+        return false;
+
+    // both sessions share their first frame right away
+    EXPECT(waitForOutput(client, "output frame ready"), true);
+    EXPECT(waitForOutput(client, "cursor frame ready"), true);
+
+    NLog::log("{}Moving the cursor over the captured output", Colors::YELLOW);
+    OK(getFromSocket("/dispatch movecursor 100 100"));
+    EXPECT(waitForOutput(client, "cursor enter"), true);
+    EXPECT(waitForOutput(client, "cursor position"), true);
+
+    client.output.clear();
+    OK(getFromSocket("/dispatch movecursor 120 130"));
+    EXPECT(waitForOutput(client, "cursor position"), true);
+    EXPECT_NOT_CONTAINS(client.output, "cursor leave");
+    EXPECT_NOT_CONTAINS(client.output, "session stopped");
+
+    stopClient(client);
+
+    return !ret;
+}
+
+REGISTER_CLIENT_TEST_FN(test);
@@ -163,6 +163,38 @@ static bool testGetprop() {
     return true;
 }
 
+static bool testKeepAlive() {
+    NLog::log("{}Testing hyprctl keep-alive connections", Colors::GREEN);
+
+    const auto REPLIES = getFromSocketKeepAlive({"/version", "j/activeworkspace", "/nonexistantrequest"});
+
+    EXPECT(REPLIES.size(), 3UL);
+    if (REPLIES.size() != 3)
+        return false;
+
+    EXPECT(REPLIES[0], getFromSocket("/version"));
+    EXPECT_CONTAINS(REPLIES[1], R"("monitor": )");
+    EXPECT(REPLIES[2], "unknown request");
+
+    return true;
+}
+
+static bool testFramebuffers() {
+    NLog::log("{}Testing hyprctl framebuffers", Colors::GREEN);
+
+    // every monitor that rendered is listed, how much it holds depends on how long it's been idle
+    EXPECT_CONTAINS(getFromSocket("j/framebuffers"), R"("name": "HEADLESS-)");
+
+    CProcess jqProc("bash", {"-c", "hyprctl -j framebuffers | jq -e 'all(.[]; .inUse <= .framebuffers)'"});
+    jqProc.addEnv("HYPRLAND_INSTANCE_SIGNATURE", HIS);
+    jqProc.runSync();
+    EXPECT(jqProc.exitCode(), 0);
+
+    EXPECT_CONTAINS(getFromSocket("/framebuffers"), "without allocating");
+
+    return true;
+}
+
 static bool test() {
     NLog::log("{}Testing hyprctl", Colors::GREEN);
 
@@ -176,6 +208,8 @@ static bool test() {
 
     testGetprop();
     testDevicesActiveLayoutIndex();
+    testKeepAlive();
+    testFramebuffers();
     getFromSocket("/reload");
 
     return !ret;
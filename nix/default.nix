@@ -226,6 +226,7 @@ in
           install hyprtester/pointer-scroll -t $out/bin
           install hyprland_gtests -t $out/bin
           install hyprtester/child-window -t $out/bin
+          install hyprtester/image-copy -t $out/bin
         ''}
       '';
 
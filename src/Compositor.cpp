@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <aquamarine/output/Output.hpp>
 #include <bit>
+#include <charconv>
 #include <ctime>
 #include <random>
 #include <print>
@@ -29,6 +30,7 @@
 #include <filesystem>
 #include <unordered_set>
 #include "debug/HyprCtl.hpp"
+#include "debug/FrameProfiler.hpp"
 #include "debug/crash/CrashReporter.hpp"
 #ifdef USES_SYSTEMD
 #include <helpers/SdDaemon.hpp> // for SdNotify
@@ -48,6 +50,7 @@
 #include "render/Renderer.hpp"
 #include "xwayland/XWayland.hpp"
 #include "helpers/ByteOperations.hpp"
+#include "helpers/RegexCache.hpp"
 #include "render/decorations/CHyprGroupBarDecoration.hpp"
 
 #include "managers/KeybindManager.hpp"
@@ -164,6 +167,13 @@ void CCompositor::restoreNofile() {
         Log::logger->log(Log::ERR, "Failed restoring NOFILE limits");
 }
 
+std::optional<rlimit> CCompositor::originalNofile() {
+    if (m_originalNofile.rlim_max <= 0)
+        return std::nullopt;
+
+    return m_originalNofile;
+}
+
 bool CCompositor::supportsDrmSyncobjTimeline() const {
     return m_drm.syncobjSupport || m_drmRenderNode.syncObjSupport;
 }
@@ -561,6 +571,7 @@ void CCompositor::cleanup() {
 
     m_workspaces.clear();
     m_windows.clear();
+    invalidateWindowIndex();
 
     for (auto const& m : m_monitors) {
         g_pHyprOpenGL->destroyMonitorResources(m);
@@ -602,6 +613,7 @@ void CCompositor::cleanup() {
     g_pANRManager.reset();
     g_pConfigWatcher.reset();
     g_pAsyncResourceGatherer.reset();
+    g_pFrameProfiler.reset();
 
     if (m_aqBackend)
         m_aqBackend.reset();
@@ -616,6 +628,9 @@ void CCompositor::cleanup() {
 void CCompositor::initManagers(eManagersInitStage stage) {
     switch (stage) {
         case STAGE_PRIORITY: {
+            Log::logger->log(Log::DEBUG, "Creating the FrameProfiler!");
+            g_pFrameProfiler = makeUnique<CFrameProfiler>();
+
             Log::logger->log(Log::DEBUG, "Creating the EventLoopManager!");
             g_pEventLoopManager = makeUnique<CEventLoopManager>(m_wlDisplay, m_wlEventLoop);
 
@@ -876,6 +891,7 @@ void CCompositor::removeWindowFromVectorSafe(PHLWINDOW pWindow) {
 
         std::erase_if(m_windows, [&](SP<Desktop::View::CWindow>& el) { return el == pWindow; });
         std::erase_if(m_windowsFadingOut, [&](PHLWINDOWREF el) { return el.lock() == pWindow; });
+        invalidateWindowIndex();
     }
 }
 
@@ -900,9 +916,16 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
         return *PMODALPARENTBLOCKING && w->m_xdgSurface && w->m_xdgSurface->m_toplevel && w->m_xdgSurface->m_toplevel->anyChildModal();
     };
 
+    // only windows on visible workspaces can be hit. Pinned windows always follow the visible workspace of their monitor.
+    const auto VISIBLEWINDOWS = windowsOnVisibleWorkspaces();
+
     // pinned windows on top of floating regardless
     if (properties & Desktop::View::ALLOW_FLOATING) {
-        for (auto const& w : m_windows | std::views::reverse) {
+        for (auto const& ww : *VISIBLEWINDOWS | std::views::reverse) {
+            const auto w = ww.lock();
+            if (!w || !w->m_workspace || !w->m_workspace->isVisible())
+                continue;
+
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -923,12 +946,12 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
 
     auto windowForWorkspace = [&](bool special) -> PHLWINDOW {
         auto floating = [&](bool aboveFullscreen) -> PHLWINDOW {
-            for (auto const& w : m_windows | std::views::reverse) {
-
-                if (special && !w->onSpecialWorkspace()) // because special floating may creep up into regular
+            for (auto const& ww : *VISIBLEWINDOWS | std::views::reverse) {
+                const auto w = ww.lock();
+                if (!w || !w->m_workspace)
                     continue;
 
-                if (!w->m_workspace)
+                if (special && !w->onSpecialWorkspace()) // because special floating may creep up into regular
                     continue;
 
                 if (ONLY_PRIORITY && !w->priorityFocus())
@@ -1003,8 +1026,14 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
         if (found)
             return found;
 
+        const auto& WORKSPACEWINDOWS = windowsOnWorkspace(WSPID);
+
         // for windows, we need to check their extensions too, first.
-        for (auto const& w : m_windows) {
+        for (auto const& ww : WORKSPACEWINDOWS) {
+            const auto w = ww.window.lock();
+            if (!w)
+                continue;
+
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -1021,7 +1050,11 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             }
         }
 
-        for (auto const& w : m_windows) {
+        for (auto const& ww : WORKSPACEWINDOWS) {
+            const auto w = ww.window.lock();
+            if (!w)
+                continue;
+
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -1186,10 +1219,21 @@ PHLWINDOW CCompositor::getWindowFromSurface(SP<CWLSurfaceResource> pSurface) {
 }
 
 PHLWINDOW CCompositor::getWindowFromHandle(uint32_t handle) {
-    for (auto const& w : m_windows) {
-        if (sc<uint32_t>(rc<uint64_t>(w.get()) & 0xFFFFFFFF) == handle) {
-            return w;
-        }
+    if (m_windowIndex.dirty)
+        rebuildWindowIndex();
+
+    const auto IT = m_windowIndex.byHandle.find(handle);
+    return IT == m_windowIndex.byHandle.end() ? nullptr : IT->second.lock();
+}
+
+PHLWINDOW CCompositor::getWindowFromAddress(uintptr_t address) {
+    if (m_windowIndex.dirty)
+        rebuildWindowIndex();
+
+    const auto [BEGIN, END] = m_windowIndex.byHandle.equal_range(sc<uint32_t>(address & 0xFFFFFFFF));
+    for (auto it = BEGIN; it != END; ++it) {
+        if (rc<uintptr_t>(it->second.get()) == address)
+            return it->second.lock();
     }
 
     return nullptr;
@@ -1252,6 +1296,8 @@ void CCompositor::changeWindowZOrder(PHLWINDOW pWindow, bool top) {
             }
         }
 
+        invalidateWindowIndex();
+
         if (pw->m_isMapped)
             g_pHyprRenderer->damageMonitor(pw->m_monitor.lock());
     };
@@ -1283,6 +1329,95 @@ void CCompositor::changeWindowZOrder(PHLWINDOW pWindow, bool top) {
     }
 }
 
+void CCompositor::invalidateWindowIndex() {
+    m_windowIndex.dirty = true;
+}
+
+void CCompositor::rebuildWindowIndex() {
+    // keep the buckets and their capacity around, workspaces rarely come and go. Ones left empty are dropped below.
+    for (auto& [id, windows] : m_windowIndex.byWorkspace) {
+        windows.clear();
+    }
+    m_windowIndex.byHandle.clear();
+
+    for (size_t z = 0; z < m_windows.size(); ++z) {
+        const auto& w = m_windows[z];
+        m_windowIndex.byHandle.emplace(sc<uint32_t>(rc<uintptr_t>(w.get()) & 0xFFFFFFFF), w);
+
+        if (!w->m_workspace)
+            continue;
+
+        m_windowIndex.byWorkspace[w->workspaceID()].emplace_back(SIndexedWindow{.window = w, .z = z});
+    }
+
+    std::erase_if(m_windowIndex.byWorkspace, [](const auto& e) { return e.second.empty(); });
+
+    m_windowIndex.visible.reset();
+    m_windowIndex.dirty = false;
+}
+
+const std::vector<CCompositor::SIndexedWindow>& CCompositor::windowsOnWorkspace(WORKSPACEID id) {
+    static const std::vector<SIndexedWindow> EMPTY;
+
+    if (m_windowIndex.dirty)
+        rebuildWindowIndex();
+
+    const auto IT = m_windowIndex.byWorkspace.find(id);
+    if (IT == m_windowIndex.byWorkspace.end())
+        return EMPTY;
+
+    return IT->second;
+}
+
+SP<const std::vector<PHLWINDOWREF>> CCompositor::windowsOnVisibleWorkspaces() {
+    if (m_windowIndex.dirty)
+        rebuildWindowIndex();
+
+    // switching workspaces doesn't touch the index, so check the cached list is still for the visible ones
+    size_t visibleCount = 0;
+    bool   upToDate     = !!m_windowIndex.visible;
+    for (auto const& ws : getWorkspaces()) {
+        if (!ws->isVisible())
+            continue;
+
+        upToDate = upToDate && visibleCount < m_windowIndex.visibleWorkspaces.size() && m_windowIndex.visibleWorkspaces[visibleCount] == ws->m_id;
+        visibleCount++;
+    }
+
+    if (upToDate && visibleCount == m_windowIndex.visibleWorkspaces.size())
+        return m_windowIndex.visible;
+
+    m_windowIndex.visibleWorkspaces.clear();
+
+    std::vector<const SIndexedWindow*> entries;
+    for (auto const& ws : getWorkspaces()) {
+        if (!ws->isVisible())
+            continue;
+
+        m_windowIndex.visibleWorkspaces.emplace_back(ws->m_id);
+
+        const auto IT = m_windowIndex.byWorkspace.find(ws->m_id);
+        if (IT == m_windowIndex.byWorkspace.end())
+            continue;
+
+        for (auto const& e : IT->second) {
+            entries.emplace_back(&e);
+        }
+    }
+
+    // only a couple of workspaces are visible at once, re-sorting their few windows is cheap
+    std::ranges::sort(entries, {}, &SIndexedWindow::z);
+
+    auto result = makeShared<std::vector<PHLWINDOWREF>>();
+    result->reserve(entries.size());
+    for (auto const& e : entries) {
+        result->emplace_back(e->window);
+    }
+
+    m_windowIndex.visible = result;
+    return result;
+}
+
 void CCompositor::cleanupFadingOut(const MONITORID& monid) {
     for (auto const& ww : m_windowsFadingOut) {
 
@@ -1765,7 +1900,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_windows) {
         if (w->m_workspace == PWORKSPACEA) {
             if (w->m_pinned) {
-                w->m_workspace = PWORKSPACEB;
+                w->setWorkspace(PWORKSPACEB);
                 continue;
             }
 
@@ -1790,7 +1925,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_windows) {
         if (w->m_workspace == PWORKSPACEB) {
             if (w->m_pinned) {
-                w->m_workspace = PWORKSPACEA;
+                w->setWorkspace(PWORKSPACEA);
                 continue;
             }
 
@@ -1973,7 +2108,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, PHLMONITOR pMo
     for (auto const& w : m_windows) {
         if (w->m_workspace == pWorkspace) {
             if (w->m_pinned) {
-                w->m_workspace = g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID);
+                w->setWorkspace(g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID));
                 continue;
             }
 
@@ -2261,39 +2396,54 @@ PHLWINDOW CCompositor::getWindowByRegex(const std::string& regexp_) {
         matchCheck = regexp.substr(4);
     }
 
+    const auto isReachable = [](const PHLWINDOW& w) { return w->m_isMapped && (!w->isHidden() || g_pLayoutManager->getCurrentLayout()->isWindowReachable(w)); };
+
+    if (mode == MODE_ADDRESS) {
+        const auto END     = matchCheck.data() + matchCheck.size();
+        uintptr_t  address = 0;
+        if (!matchCheck.starts_with("0x"))
+            return nullptr;
+
+        if (const auto [PTR, EC] = std::from_chars(matchCheck.data() + 2, END, address, 16); EC != std::errc{} || PTR != END)
+            return nullptr;
+
+        const auto PWINDOW = getWindowFromAddress(address);
+        return PWINDOW && isReachable(PWINDOW) ? PWINDOW : nullptr;
+    }
+
+    // scripts keep sending the same few selectors, don't compile them for every window every time
+    static CRegexCache regexCache(64);
+    const auto&        REGEX = regexCache.get(regexCheck);
+
     for (auto const& w : g_pCompositor->m_windows) {
-        if (!w->m_isMapped || (w->isHidden() && !g_pLayoutManager->getCurrentLayout()->isWindowReachable(w)))
+        if (!isReachable(w))
             continue;
 
         switch (mode) {
             case MODE_CLASS_REGEX: {
-                const auto windowClass = w->m_class;
-                if (!RE2::FullMatch(windowClass, regexCheck))
+                if (!RE2::FullMatch(w->m_class, REGEX))
                     continue;
                 break;
             }
             case MODE_INITIAL_CLASS_REGEX: {
-                const auto initialWindowClass = w->m_initialClass;
-                if (!RE2::FullMatch(initialWindowClass, regexCheck))
+                if (!RE2::FullMatch(w->m_initialClass, REGEX))
                     continue;
                 break;
             }
             case MODE_TITLE_REGEX: {
-                const auto windowTitle = w->m_title;
-                if (!RE2::FullMatch(windowTitle, regexCheck))
+                if (!RE2::FullMatch(w->m_title, REGEX))
                     continue;
                 break;
             }
             case MODE_INITIAL_TITLE_REGEX: {
-                const auto initialWindowTitle = w->m_initialTitle;
-                if (!RE2::FullMatch(initialWindowTitle, regexCheck))
+                if (!RE2::FullMatch(w->m_initialTitle, REGEX))
                     continue;
                 break;
             }
             case MODE_TAG_REGEX: {
                 bool tagMatched = false;
                 for (auto const& t : w->m_ruleApplicator->m_tagKeeper.getTags()) {
-                    if (RE2::FullMatch(t, regexCheck)) {
+                    if (RE2::FullMatch(t, REGEX)) {
                         tagMatched = true;
                         break;
                     }
@@ -2302,12 +2452,6 @@ PHLWINDOW CCompositor::getWindowByRegex(const std::string& regexp_) {
                     continue;
                 break;
             }
-            case MODE_ADDRESS: {
-                std::string addr = std::format("0x{:x}", rc<uintptr_t>(w.get()));
-                if (matchCheck != addr)
-                    continue;
-                break;
-            }
             case MODE_PID: {
                 std::string pid = std::format("{}", w->getPID());
                 if (matchCheck != pid)
@@ -2526,7 +2670,7 @@ void CCompositor::openSafeModeBox() {
 
         if (RES.starts_with(OPT_LOAD)) {
             m_safeMode = false;
-            g_pConfigManager->reload();
+            g_pConfigManager->reload(true);
         } else if (RES.starts_with(OPT_OPEN)) {
             std::string reportPath;
             const auto  HOME       = getenv("HOME");
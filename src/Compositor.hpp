@@ -27,6 +27,11 @@ class CCompositor {
     CCompositor(bool onlyConfig = false);
     ~CCompositor();
 
+    struct SIndexedWindow {
+        PHLWINDOWREF window;
+        size_t       z = 0;
+    };
+
     wl_display*    m_wlDisplay   = nullptr;
     wl_event_loop* m_wlEventLoop = nullptr;
     struct {
@@ -67,6 +72,7 @@ class CCompositor {
     void                                         cleanup();
     void                                         bumpNofile();
     void                                         restoreNofile();
+    std::optional<rlimit>                        originalNofile(); // nullopt if it wasn't bumped
     bool                                         setWatchdogFd(int fd);
 
     bool                                         m_readyToProcess = false;
@@ -106,12 +112,14 @@ class CCompositor {
     PHLMONITOR             getRealMonitorFromOutput(SP<Aquamarine::IOutput>);
     PHLWINDOW              getWindowFromSurface(SP<CWLSurfaceResource>);
     PHLWINDOW              getWindowFromHandle(uint32_t);
+    PHLWINDOW              getWindowFromAddress(uintptr_t);
     PHLWORKSPACE           getWorkspaceByID(const WORKSPACEID&);
     PHLWORKSPACE           getWorkspaceByName(const std::string&);
     PHLWORKSPACE           getWorkspaceByString(const std::string&);
     PHLWINDOW              getUrgentWindow();
     bool                   isWindowActive(PHLWINDOW);
     void                   changeWindowZOrder(PHLWINDOW, bool);
+    void                   invalidateWindowIndex(); // call when m_windows changes, CWindow::setWorkspace() does it for workspace changes
     void                   cleanupFadingOut(const MONITORID& monid);
     PHLWINDOW              getWindowInDirection(PHLWINDOW, char);
     PHLWINDOW              getWindowInDirection(const CBox& box, PHLWORKSPACE pWorkspace, char dir, PHLWINDOW ignoreWindow = nullptr, bool useVectorAngles = false);
@@ -169,6 +177,10 @@ class CCompositor {
     bool                                supportsDrmSyncobjTimeline() const;
     std::string                         m_explicitConfigPath;
 
+    // windows whose workspace was id when the index was last rebuilt, bottom to top. Check the window is still there before using it.
+    // The bucket lives until the next lookup after an invalidation, copy it if the loop may move windows or look them up again.
+    const std::vector<SIndexedWindow>&  windowsOnWorkspace(WORKSPACEID id);
+
   private:
     void                           initAllSignals();
     void                           removeAllSignals();
@@ -181,6 +193,23 @@ class CCompositor {
     void                           setMallocThreshold();
     void                           openSafeModeBox();
 
+    // windows bucketed by workspace, keeping their z-order from m_windows.
+    // Rebuilt lazily. Entries are re-validated on use, so a stale entry is harmless, but a window
+    // missing from its bucket won't be found: windows change workspace through CWindow::setWorkspace().
+    // Also every window by its handle, the low 32 bits of its address, which may collide.
+    struct {
+        std::unordered_map<WORKSPACEID, std::vector<SIndexedWindow>> byWorkspace;
+        std::unordered_multimap<uint32_t, PHLWINDOWREF>              byHandle;
+        bool                                                         dirty = true;
+
+        // windowsOnVisibleWorkspaces(), until the index or the visible workspaces change
+        SP<const std::vector<PHLWINDOWREF>> visible;
+        std::vector<WORKSPACEID>            visibleWorkspaces;
+    } m_windowIndex;
+
+    void                                rebuildWindowIndex();
+    SP<const std::vector<PHLWINDOWREF>> windowsOnVisibleWorkspaces(); // bottom to top, windows may have moved since
+
     uint64_t                       m_hyprlandPID    = 0;
     wl_event_source*               m_critSigSource  = nullptr;
     rlimit                         m_originalNofile = {};
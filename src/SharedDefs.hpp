@@ -44,7 +44,8 @@ struct SCallbackInfo {
 
 enum eHyprCtlOutputFormat : uint8_t {
     FORMAT_NORMAL = 0,
-    FORMAT_JSON
+    FORMAT_JSON,
+    FORMAT_BINARY, // only supported by a few requests, see HyprCtlBinary.hpp
 };
 
 struct SHyprCtlCommand {
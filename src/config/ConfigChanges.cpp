@@ -0,0 +1,79 @@
+#include "ConfigChanges.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace NConfigChanges {
+    // whether a key categoryOf() puts in misc really belongs there
+    static bool isKnownMisc(std::string_view key) {
+        constexpr std::array<std::string_view, 9> NAMESPACES = {"misc:", "cursor:", "debug:", "render:", "opengl:", "quirks:", "xwayland:", "ecosystem:", "experimental:"};
+        constexpr std::array<std::string_view, 8> KEYWORDS   = {"exec", "execr", "exec-once", "execr-once", "exec-shutdown", "source", "plugin", "permission"};
+
+        if (key.contains(':'))
+            return std::ranges::any_of(NAMESPACES, [key](const auto& ns) { return key.starts_with(ns); });
+
+        // env has flags after it (envd)
+        return key.starts_with("env") || std::ranges::contains(KEYWORDS, key);
+    }
+
+    eConfigChange categoryOf(std::string_view key) {
+        if (key.starts_with("device"))
+            return CONFIG_CHANGE_INPUT;
+        if (key.starts_with("monitorv2"))
+            return CONFIG_CHANGE_MONITORS;
+        if (key.starts_with("windowrule") || key.starts_with("layerrule"))
+            return CONFIG_CHANGE_RULES;
+
+        if (key.contains(':')) {
+            if (key.starts_with("input:"))
+                return CONFIG_CHANGE_INPUT;
+            if (key.starts_with("decoration:") || key.starts_with("group:") || key.starts_with("general:col."))
+                return CONFIG_CHANGE_DECORATION;
+            if (key.starts_with("general:") || key.starts_with("dwindle:") || key.starts_with("master:"))
+                return CONFIG_CHANGE_LAYOUT;
+            if (key.starts_with("animations:"))
+                return CONFIG_CHANGE_ANIMATIONS;
+            if (key.starts_with("binds:") || key.starts_with("gestures:"))
+                return CONFIG_CHANGE_BINDS;
+
+            return CONFIG_CHANGE_MISC;
+        }
+
+        // bind has flags after it (binde, bindm, ...)
+        if (key.starts_with("bind") || key == "unbind" || key == "submap" || key == "gesture")
+            return CONFIG_CHANGE_BINDS;
+        if (key == "monitor")
+            return CONFIG_CHANGE_MONITORS;
+        if (key == "animation" || key == "bezier")
+            return CONFIG_CHANGE_ANIMATIONS;
+        if (key == "workspace")
+            return CONFIG_CHANGE_RULES;
+
+        return CONFIG_CHANGE_MISC;
+    }
+
+    CONFIG_CHANGES changesOf(std::string_view key) {
+        const auto CATEGORY = categoryOf(key);
+
+        if (CATEGORY == CONFIG_CHANGE_MISC && !isKnownMisc(key))
+            return CONFIG_CHANGES{}.set();
+
+        return CONFIG_CHANGES{}.set(CATEGORY);
+    }
+
+    std::string toString(const CONFIG_CHANGES& changes) {
+        constexpr const char* NAMES[CONFIG_CHANGE_COUNT] = {"input", "decoration", "animations", "monitors", "rules", "binds", "layout", "misc"};
+
+        std::string           result;
+        for (size_t i = 0; i < CONFIG_CHANGE_COUNT; ++i) {
+            if (!changes.test(i))
+                continue;
+
+            if (!result.empty())
+                result += ',';
+            result += NAMES[i];
+        }
+
+        return result;
+    }
+};
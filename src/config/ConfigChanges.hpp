@@ -0,0 +1,32 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace NConfigChanges {
+    // parts of the config that get re-applied separately on a reload
+    enum eConfigChange : uint8_t {
+        CONFIG_CHANGE_INPUT = 0,  // input:*, device {}
+        CONFIG_CHANGE_DECORATION, // decoration:*, group:*, general:col.*
+        CONFIG_CHANGE_ANIMATIONS, // animations:*, animation, bezier
+        CONFIG_CHANGE_MONITORS,   // monitor, monitorv2 {}
+        CONFIG_CHANGE_RULES,      // window, layer and workspace rules
+        CONFIG_CHANGE_BINDS,      // binds:*, gestures:*, bind, submap, gesture
+        CONFIG_CHANGE_LAYOUT,     // the rest of general:*, dwindle:*, master:*
+        CONFIG_CHANGE_MISC,       // everything else
+        CONFIG_CHANGE_COUNT,
+    };
+
+    using CONFIG_CHANGES = std::bitset<CONFIG_CHANGE_COUNT>;
+
+    // key is an option (general:gaps_in), a special category (device[name]:sensitivity) or a keyword (bind)
+    eConfigChange categoryOf(std::string_view key);
+
+    // what a change of key has to re-apply. Keys we don't know, a plugin's most likely, may affect anything.
+    CONFIG_CHANGES changesOf(std::string_view key);
+
+    // comma separated, as sent with the configreloaded event
+    std::string toString(const CONFIG_CHANGES& changes);
+};
@@ -252,6 +252,8 @@ static Hyprlang::CParseResult handleMonitor(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -264,6 +266,8 @@ static Hyprlang::CParseResult handleBezier(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -276,6 +280,8 @@ static Hyprlang::CParseResult handleAnimation(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -288,6 +294,8 @@ static Hyprlang::CParseResult handleBind(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -300,6 +308,8 @@ static Hyprlang::CParseResult handleUnbind(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -312,6 +322,8 @@ static Hyprlang::CParseResult handleWorkspaceRules(const char* c, const char* v)
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -324,6 +336,8 @@ static Hyprlang::CParseResult handleSubmap(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -384,6 +398,8 @@ static Hyprlang::CParseResult handleGesture(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -396,6 +412,8 @@ static Hyprlang::CParseResult handleWindowrule(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
@@ -408,34 +426,48 @@ static Hyprlang::CParseResult handleLayerrule(const char* c, const char* v) {
     Hyprlang::CParseResult result;
     if (RESULT.has_value())
         result.setError(RESULT.value().c_str());
+
+    g_pConfigManager->recordReloadKeyword(COMMAND, VALUE);
     return result;
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::INT& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::FLOAT& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::VEC2& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::STRING& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, std::move(val));
 }
 
+void CConfigManager::registerSpecialConfigVar(const char* category, const char* name, const Hyprlang::CConfigValue& val) {
+    auto& names = m_specialConfigValueNames[category];
+    if (!std::ranges::contains(names, name))
+        names.emplace_back(name);
+    m_config->addSpecialConfigValue(category, name, val);
+}
+
 CConfigManager::CConfigManager() {
     const auto ERR = verifyConfigExists();
 
@@ -775,78 +807,78 @@ CConfigManager::CConfigManager() {
 
     // devices
     m_config->addSpecialCategory("device", {"name"});
-    m_config->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_config->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "rotation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_config->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_config->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_config->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_factor", Hyprlang::FLOAT{-1});
-    m_config->addSpecialConfigValue("device", "transform", Hyprlang::INT{-1});
-    m_config->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_config->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_config->addSpecialConfigValue("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_config->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
-    m_config->addSpecialConfigValue("device", "flip_x", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "flip_y", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "drag_3fg", Hyprlang::INT{0});                 // only for touchpads
-    m_config->addSpecialConfigValue("device", "keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
-    m_config->addSpecialConfigValue("device", "share_states", Hyprlang::INT{0});             // only for virtualkeyboards
-    m_config->addSpecialConfigValue("device", "release_pressed_on_close", Hyprlang::INT{0}); // only for virtualkeyboards
+    registerSpecialConfigVar("device", "sensitivity", {0.F});
+    registerSpecialConfigVar("device", "accel_profile", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "rotation", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "kb_file", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "kb_layout", {"us"});
+    registerSpecialConfigVar("device", "kb_variant", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "kb_options", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "kb_rules", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "kb_model", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "repeat_rate", Hyprlang::INT{25});
+    registerSpecialConfigVar("device", "repeat_delay", Hyprlang::INT{600});
+    registerSpecialConfigVar("device", "natural_scroll", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "tap_button_map", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "numlock_by_default", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "resolve_binds_by_sym", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "disable_while_typing", Hyprlang::INT{1});
+    registerSpecialConfigVar("device", "clickfinger_behavior", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "middle_button_emulation", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "tap-to-click", Hyprlang::INT{1});
+    registerSpecialConfigVar("device", "tap-and-drag", Hyprlang::INT{1});
+    registerSpecialConfigVar("device", "drag_lock", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "left_handed", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "scroll_method", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "scroll_button", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "scroll_button_lock", Hyprlang::INT{0});
+    registerSpecialConfigVar("device", "scroll_points", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "scroll_factor", Hyprlang::FLOAT{-1});
+    registerSpecialConfigVar("device", "transform", Hyprlang::INT{-1});
+    registerSpecialConfigVar("device", "output", {STRVAL_EMPTY});
+    registerSpecialConfigVar("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    registerSpecialConfigVar("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    registerSpecialConfigVar("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
+    registerSpecialConfigVar("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    registerSpecialConfigVar("device", "relative_input", Hyprlang::INT{0});           // only for tablets
+    registerSpecialConfigVar("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    registerSpecialConfigVar("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    registerSpecialConfigVar("device", "flip_x", Hyprlang::INT{0});                   // only for touchpads
+    registerSpecialConfigVar("device", "flip_y", Hyprlang::INT{0});                   // only for touchpads
+    registerSpecialConfigVar("device", "drag_3fg", Hyprlang::INT{0});                 // only for touchpads
+    registerSpecialConfigVar("device", "keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
+    registerSpecialConfigVar("device", "share_states", Hyprlang::INT{0});             // only for virtualkeyboards
+    registerSpecialConfigVar("device", "release_pressed_on_close", Hyprlang::INT{0}); // only for virtualkeyboards
 
     m_config->addSpecialCategory("monitorv2", {.key = "output"});
-    m_config->addSpecialConfigValue("monitorv2", "disabled", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("monitorv2", "mode", {"preferred"});
-    m_config->addSpecialConfigValue("monitorv2", "position", {"auto"});
-    m_config->addSpecialConfigValue("monitorv2", "scale", {"auto"});
-    m_config->addSpecialConfigValue("monitorv2", "addreserved", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("monitorv2", "mirror", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("monitorv2", "bitdepth", {STRVAL_EMPTY}); // TODO use correct type
-    m_config->addSpecialConfigValue("monitorv2", "cm", {"auto"});
-    m_config->addSpecialConfigValue("monitorv2", "sdr_eotf", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("monitorv2", "sdrbrightness", Hyprlang::FLOAT{1.0});
-    m_config->addSpecialConfigValue("monitorv2", "sdrsaturation", Hyprlang::FLOAT{1.0});
-    m_config->addSpecialConfigValue("monitorv2", "vrr", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("monitorv2", "transform", {STRVAL_EMPTY}); // TODO use correct type
-    m_config->addSpecialConfigValue("monitorv2", "supports_wide_color", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("monitorv2", "supports_hdr", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("monitorv2", "sdr_min_luminance", Hyprlang::FLOAT{0.2});
-    m_config->addSpecialConfigValue("monitorv2", "sdr_max_luminance", Hyprlang::INT{80});
-    m_config->addSpecialConfigValue("monitorv2", "min_luminance", Hyprlang::FLOAT{-1.0});
-    m_config->addSpecialConfigValue("monitorv2", "max_luminance", Hyprlang::INT{-1});
-    m_config->addSpecialConfigValue("monitorv2", "max_avg_luminance", Hyprlang::INT{-1});
+    registerSpecialConfigVar("monitorv2", "disabled", Hyprlang::INT{0});
+    registerSpecialConfigVar("monitorv2", "mode", {"preferred"});
+    registerSpecialConfigVar("monitorv2", "position", {"auto"});
+    registerSpecialConfigVar("monitorv2", "scale", {"auto"});
+    registerSpecialConfigVar("monitorv2", "addreserved", {STRVAL_EMPTY});
+    registerSpecialConfigVar("monitorv2", "mirror", {STRVAL_EMPTY});
+    registerSpecialConfigVar("monitorv2", "bitdepth", {STRVAL_EMPTY}); // TODO use correct type
+    registerSpecialConfigVar("monitorv2", "cm", {"auto"});
+    registerSpecialConfigVar("monitorv2", "sdr_eotf", Hyprlang::INT{0});
+    registerSpecialConfigVar("monitorv2", "sdrbrightness", Hyprlang::FLOAT{1.0});
+    registerSpecialConfigVar("monitorv2", "sdrsaturation", Hyprlang::FLOAT{1.0});
+    registerSpecialConfigVar("monitorv2", "vrr", Hyprlang::INT{0});
+    registerSpecialConfigVar("monitorv2", "transform", {STRVAL_EMPTY}); // TODO use correct type
+    registerSpecialConfigVar("monitorv2", "supports_wide_color", Hyprlang::INT{0});
+    registerSpecialConfigVar("monitorv2", "supports_hdr", Hyprlang::INT{0});
+    registerSpecialConfigVar("monitorv2", "sdr_min_luminance", Hyprlang::FLOAT{0.2});
+    registerSpecialConfigVar("monitorv2", "sdr_max_luminance", Hyprlang::INT{80});
+    registerSpecialConfigVar("monitorv2", "min_luminance", Hyprlang::FLOAT{-1.0});
+    registerSpecialConfigVar("monitorv2", "max_luminance", Hyprlang::INT{-1});
+    registerSpecialConfigVar("monitorv2", "max_avg_luminance", Hyprlang::INT{-1});
 
     // windowrule v3
     m_config->addSpecialCategory("windowrule", {.key = "name"});
-    m_config->addSpecialConfigValue("windowrule", "enable", Hyprlang::INT{1});
+    registerSpecialConfigVar("windowrule", "enable", Hyprlang::INT{1});
 
     // layerrule v2
     m_config->addSpecialCategory("layerrule", {.key = "name"});
-    m_config->addSpecialConfigValue("layerrule", "enable", Hyprlang::INT{1});
+    registerSpecialConfigVar("layerrule", "enable", Hyprlang::INT{1});
 
     reloadRuleConfigs();
 
@@ -897,19 +929,19 @@ void CConfigManager::reloadRuleConfigs() {
     // FIXME: this should also remove old values if they are removed
 
     for (const auto& r : Desktop::Rule::allMatchPropStrings()) {
-        m_config->addSpecialConfigValue("windowrule", ("match:" + r).c_str(), Hyprlang::STRING{""});
+        registerSpecialConfigVar("windowrule", ("match:" + r).c_str(), Hyprlang::STRING{""});
     }
 
     for (const auto& r : Desktop::Rule::windowEffects()->allEffectStrings()) {
-        m_config->addSpecialConfigValue("windowrule", r.c_str(), Hyprlang::STRING{""});
+        registerSpecialConfigVar("windowrule", r.c_str(), Hyprlang::STRING{""});
     }
 
     for (const auto& r : Desktop::Rule::allMatchPropStrings()) {
-        m_config->addSpecialConfigValue("layerrule", ("match:" + r).c_str(), Hyprlang::STRING{""});
+        registerSpecialConfigVar("layerrule", ("match:" + r).c_str(), Hyprlang::STRING{""});
     }
 
     for (const auto& r : Desktop::Rule::layerEffects()->allEffectStrings()) {
-        m_config->addSpecialConfigValue("layerrule", r.c_str(), Hyprlang::STRING{""});
+        registerSpecialConfigVar("layerrule", r.c_str(), Hyprlang::STRING{""});
     }
 }
 
@@ -1030,7 +1062,10 @@ static void clearHlVersionVars() {
     }
 }
 
-void CConfigManager::reload() {
+void CConfigManager::reload(bool full) {
+    if (full)
+        m_changedSinceReload.set();
+
     EMIT_HOOK_EVENT("preConfigReload", nullptr);
     setDefaultAnimationVars();
     resetHLConfig();
@@ -1122,6 +1157,7 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     m_failedPluginConfigValues.clear();
     m_finalExecRequests.clear();
     m_keywordRules.clear();
+    m_reloadKeywords = {};
 
     // paths
     m_configPaths.clear();
@@ -1304,27 +1340,52 @@ Hyprlang::CParseResult CConfigManager::reloadRules() {
 }
 
 void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
+    using namespace NConfigChanges;
+
     updateWatcher();
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        w->uncacheWindowDecos();
+    // only re-apply what the reload actually changed, or what keywords changed since the last one
+    auto           state   = captureReloadState();
+    CONFIG_CHANGES changed = m_changedSinceReload;
+    for (size_t i = 0; i < CONFIG_CHANGE_COUNT; ++i) {
+        if (state[i] != m_reloadState[i])
+            changed.set(i);
+    }
+
+    if (m_isFirstLaunch)
+        changed.set();
+
+    m_reloadState = std::move(state);
+    m_changedSinceReload.reset();
+
+    const auto CHANGED = [&changed](std::initializer_list<eConfigChange> categories) { return std::ranges::any_of(categories, [&changed](auto c) { return changed.test(c); }); };
+
+    Log::logger->log(Log::DEBUG, "Config reload changed: {}", changed.any() ? toString(changed) : "nothing");
+
+    if (CHANGED({CONFIG_CHANGE_DECORATION, CONFIG_CHANGE_LAYOUT})) {
+        for (auto const& w : g_pCompositor->m_windows) {
+            w->uncacheWindowDecos();
+        }
     }
 
     static auto PZOOMFACTOR = CConfigValue<Hyprlang::FLOAT>("cursor:zoom_factor");
     for (auto const& m : g_pCompositor->m_monitors) {
         *(m->m_cursorZoom) = *PZOOMFACTOR;
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+
+        if (CHANGED({CONFIG_CHANGE_LAYOUT, CONFIG_CHANGE_DECORATION, CONFIG_CHANGE_MONITORS, CONFIG_CHANGE_RULES}))
+            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
     }
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
-    if (!m_isFirstLaunch) {
+    if (!m_isFirstLaunch && changed.test(CONFIG_CHANGE_INPUT)) {
         g_pInputManager->setKeyboardLayout();
         g_pInputManager->setPointerConfigs();
         g_pInputManager->setTouchDeviceConfigs();
         g_pInputManager->setTabletConfigs();
+    }
 
+    if (!m_isFirstLaunch && changed.test(CONFIG_CHANGE_DECORATION))
         g_pHyprOpenGL->m_reloadScreenShader = true;
-    }
 
     // parseError will be displayed next frame
 
@@ -1347,13 +1408,15 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     // not on first launch because monitors might not exist yet
     // and they'll be taken care of in the newMonitor event
     // ignore if nomonitorreload is set
-    if (!m_isFirstLaunch && !m_noMonitorReload) {
+    if (!m_isFirstLaunch && !m_noMonitorReload && changed.test(CONFIG_CHANGE_MONITORS)) {
         // check
         performMonitorReload();
         ensureMonitorStatus();
-        ensureVRR();
     }
 
+    if (!m_isFirstLaunch && !m_noMonitorReload && CHANGED({CONFIG_CHANGE_MONITORS, CONFIG_CHANGE_MISC}))
+        ensureVRR();
+
 #ifndef NO_XWAYLAND
     const auto PENABLEXWAYLAND     = std::any_cast<Hyprlang::INT>(m_config->getConfigValue("xwayland:enabled"));
     g_pCompositor->m_wantsXwayland = PENABLEXWAYLAND;
@@ -1367,22 +1430,26 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
         g_pCompositor->m_wantsXwayland = PENABLEXWAYLAND;
 #endif
 
-    if (!m_isFirstLaunch && !g_pCompositor->m_unsafeState)
+    if (!m_isFirstLaunch && !g_pCompositor->m_unsafeState && changed.test(CONFIG_CHANGE_DECORATION))
         refreshGroupBarGradients();
 
     // Updates dynamic window and workspace rules
-    for (auto const& w : g_pCompositor->getWorkspaces()) {
-        if (w->inert())
-            continue;
-        w->updateWindows();
-        w->updateWindowData();
+    if (CHANGED({CONFIG_CHANGE_RULES, CONFIG_CHANGE_LAYOUT, CONFIG_CHANGE_DECORATION})) {
+        for (auto const& w : g_pCompositor->getWorkspaces()) {
+            if (w->inert())
+                continue;
+            w->updateWindows();
+            w->updateWindowData();
+        }
     }
 
     // Update window border colors
-    g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+    if (CHANGED({CONFIG_CHANGE_DECORATION, CONFIG_CHANGE_RULES, CONFIG_CHANGE_ANIMATIONS}))
+        g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
     // update layout
-    g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("general:layout")));
+    if (changed.test(CONFIG_CHANGE_LAYOUT))
+        g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("general:layout")));
 
     // manual crash
     if (std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:manual_crash")) && !m_manualCrashInitiated) {
@@ -1398,18 +1465,24 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     if (disableStdout && m_isFirstLaunch)
         Log::logger->log(Log::DEBUG, "Disabling stdout logs! Check the log for further logs.");
 
-    for (auto const& m : g_pCompositor->m_monitors) {
-        // mark blur dirty
-        g_pHyprOpenGL->markBlurDirtyForMonitor(m);
+    // input and binds don't change what's on screen
+    const bool REDRAW = CHANGED({CONFIG_CHANGE_DECORATION, CONFIG_CHANGE_ANIMATIONS, CONFIG_CHANGE_MONITORS, CONFIG_CHANGE_RULES, CONFIG_CHANGE_LAYOUT, CONFIG_CHANGE_MISC});
+
+    if (REDRAW) {
+        for (auto const& m : g_pCompositor->m_monitors) {
+            // mark blur dirty
+            if (changed.test(CONFIG_CHANGE_DECORATION))
+                g_pHyprOpenGL->markBlurDirtyForMonitor(m);
 
-        g_pCompositor->scheduleFrameForMonitor(m);
+            g_pCompositor->scheduleFrameForMonitor(m);
 
-        // Force the compositor to fully re-render all monitors
-        m->m_forceFullFrames = 2;
+            // Force the compositor to fully re-render all monitors
+            m->m_forceFullFrames = 2;
 
-        // also force mirrors, as the aspect ratio could've changed
-        for (auto const& mirror : m->m_mirrors)
-            mirror->m_forceFullFrames = 3;
+            // also force mirrors, as the aspect ratio could've changed
+            for (auto const& mirror : m->m_mirrors)
+                mirror->m_forceFullFrames = 3;
+        }
     }
 
     // Reset no monitor reload
@@ -1419,12 +1492,14 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     handlePluginLoads();
 
     // update persistent workspaces
-    if (!m_isFirstLaunch)
+    if (!m_isFirstLaunch && changed.test(CONFIG_CHANGE_RULES))
         ensurePersistentWorkspacesPresent();
 
+    notifySubscribers();
+
     EMIT_HOOK_EVENT("configReloaded", nullptr);
     if (g_pEventManager)
-        g_pEventManager->postEvent(SHyprIPCEvent{"configreloaded", ""});
+        g_pEventManager->postEvent(SHyprIPCEvent{"configreloaded", toString(changed)});
 }
 
 void CConfigManager::init() {
@@ -1442,6 +1517,12 @@ void CConfigManager::init() {
 std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::string& VALUE) {
     const auto RET = m_config->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
+    // the next reload has to undo this, even if the file didn't change
+    if (COMMAND == "source")
+        m_changedSinceReload.set();
+    else
+        m_changedSinceReload |= NConfigChanges::changesOf(COMMAND);
+
     // invalidate layouts if they changed
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
         for (auto const& m : g_pCompositor->m_monitors)
@@ -1463,6 +1544,8 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
         g_pHyprRenderer->initiateManualCrash();
     }
 
+    notifySubscribers();
+
     return RET.error ? RET.getError() : "";
 }
 
@@ -1728,6 +1811,110 @@ Hyprlang::CConfigValue* CConfigManager::getHyprlangConfigValuePtr(const std::str
     return m_config->getConfigValuePtr(name.c_str());
 }
 
+static std::string valueToString(Hyprlang::CConfigValue* value) {
+    if (!value)
+        return "";
+
+    const auto VAL  = value->getValue();
+    const auto TYPE = std::type_index(VAL.type());
+
+    if (TYPE == typeid(Hyprlang::INT))
+        return std::to_string(std::any_cast<Hyprlang::INT>(VAL));
+    if (TYPE == typeid(Hyprlang::FLOAT))
+        return std::format("{}", std::any_cast<Hyprlang::FLOAT>(VAL));
+    if (TYPE == typeid(Hyprlang::VEC2))
+        return std::format("{} {}", std::any_cast<Hyprlang::VEC2>(VAL).x, std::any_cast<Hyprlang::VEC2>(VAL).y);
+    if (TYPE == typeid(Hyprlang::STRING))
+        return std::any_cast<Hyprlang::STRING>(VAL);
+    if (TYPE == typeid(void*))
+        return sc<ICustomConfigValueData*>(std::any_cast<void*>(VAL))->toString();
+
+    return "";
+}
+
+std::string CConfigManager::configValueString(const std::string& key) {
+    return valueToString(getHyprlangConfigValuePtr(key));
+}
+
+// a key that may affect several parts goes into each of them
+static void addToReloadState(std::array<std::string, NConfigChanges::CONFIG_CHANGE_COUNT>& state, std::string_view key, const std::string& line) {
+    const auto CHANGES = NConfigChanges::changesOf(key);
+
+    for (size_t i = 0; i < NConfigChanges::CONFIG_CHANGE_COUNT; ++i) {
+        if (CHANGES.test(i))
+            state[i] += line;
+    }
+}
+
+CConfigManager::ReloadState CConfigManager::captureReloadState() {
+    auto state = m_reloadKeywords;
+
+    for (const auto& name : m_configValueNames) {
+        addToReloadState(state, name, std::format("{}={}\n", name, valueToString(m_config->getConfigValuePtr(name.c_str()))));
+    }
+
+    for (const auto& [category, names] : m_specialConfigValueNames) {
+        for (const auto& key : m_config->listKeysForSpecialCategory(category.c_str())) {
+            for (const auto& name : names) {
+                const auto VAL = m_config->getSpecialConfigValuePtr(category.c_str(), name.c_str(), key.c_str());
+                if (VAL && VAL->m_bSetByUser)
+                    addToReloadState(state, category, std::format("{}[{}]:{}={}\n", category, key, name, valueToString(VAL)));
+            }
+        }
+    }
+
+    // plugins re-apply their own values, but they may drive layouts and decorations we have to refresh
+    for (const auto& v : m_pluginVariables) {
+        addToReloadState(state, "plugin:" + v.name, std::format("plugin:{}={}\n", v.name, configValueString("plugin:" + v.name)));
+    }
+
+    return state;
+}
+
+void CConfigManager::recordReloadKeyword(const std::string& command, const std::string& value) {
+    addToReloadState(m_reloadKeywords, command, std::format("{}={}\n", command, value));
+}
+
+SP<CONFIG_CHANGE_FN> CConfigManager::subscribe(const std::vector<std::string>& keys, CONFIG_CHANGE_FN fn) {
+    auto                sub = makeShared<CONFIG_CHANGE_FN>(std::move(fn));
+
+    SConfigSubscription subscription = {.fn = sub, .keys = keys};
+    subscription.values.reserve(keys.size());
+    for (const auto& k : keys) {
+        subscription.values.emplace_back(configValueString(k));
+    }
+
+    m_subscriptions.emplace_back(std::move(subscription));
+
+    return sub;
+}
+
+void CConfigManager::notifySubscribers() {
+    std::erase_if(m_subscriptions, [](const auto& s) { return s.fn.expired(); });
+
+    // a callback may subscribe or reload, so gather first and call after
+    std::vector<SP<CONFIG_CHANGE_FN>> changed;
+
+    for (auto& s : m_subscriptions) {
+        bool dirty = false;
+        for (size_t i = 0; i < s.keys.size(); ++i) {
+            auto value = configValueString(s.keys[i]);
+            if (value == s.values[i])
+                continue;
+
+            s.values[i] = std::move(value);
+            dirty       = true;
+        }
+
+        if (dirty)
+            changed.emplace_back(s.fn.lock());
+    }
+
+    for (const auto& fn : changed) {
+        (*fn)();
+    }
+}
+
 bool CConfigManager::deviceConfigExists(const std::string& dev) {
     auto copy = dev;
     std::ranges::replace(copy, ' ', '-');
@@ -1866,7 +2053,7 @@ void CConfigManager::handlePluginLoads() {
 
     if (pluginsChanged) {
         g_pHyprError->destroy();
-        reload();
+        reload(true);
     }
 }
 
@@ -2561,7 +2748,7 @@ std::optional<std::string> CConfigManager::handleUnbind(const std::string& comma
     const auto ARGS = CVarList(value);
 
     if (ARGS.size() == 1 && ARGS[0] == "all") {
-        g_pKeybindManager->m_keybinds.clear();
+        g_pKeybindManager->clearKeybinds();
         g_pKeybindManager->m_activeKeybinds.clear();
         g_pKeybindManager->m_lastLongPressKeybind.reset();
         return {};
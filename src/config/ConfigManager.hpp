@@ -8,6 +8,7 @@
 #include "../defines.hpp"
 #include <variant>
 #include <vector>
+#include <array>
 #include <optional>
 #include <functional>
 #include <xf86drmMode.h>
@@ -15,6 +16,7 @@
 #include "../desktop/view/Window.hpp"
 
 #include "ConfigDataValues.hpp"
+#include "ConfigChanges.hpp"
 #include "../SharedDefs.hpp"
 #include "../helpers/Color.hpp"
 #include "../desktop/DesktopTypes.hpp"
@@ -186,12 +188,15 @@ class CMonitorRuleParser {
     std::string  m_error = "";
 };
 
+using CONFIG_CHANGE_FN = std::function<void()>;
+
 class CConfigManager {
   public:
     CConfigManager();
 
     void                                         init();
-    void                                         reload();
+    // full re-applies everything, otherwise only what changed since the last reload is
+    void                                         reload(bool full = false);
     std::string                                  verify();
 
     int                                          getDeviceInt(const std::string&, const std::string&, const std::string& fallback = "");
@@ -207,6 +212,10 @@ class CConfigManager {
     std::string                                  getMainConfigPath();
     std::string                                  getConfigString();
 
+    // fn is called after a reload or a keyword that changed the value of any of the keys.
+    // Losing the pointer unsubscribes.
+    [[nodiscard("Losing this pointer instantly unsubscribes")]] SP<CONFIG_CHANGE_FN> subscribe(const std::vector<std::string>& keys, CONFIG_CHANGE_FN fn);
+
     SMonitorRule                                 getMonitorRuleFor(const PHLMONITOR);
     SWorkspaceRule                               getWorkspaceRuleFor(PHLWORKSPACE workspace);
     std::string                                  getDefaultWorkspaceFor(const std::string&);
@@ -237,6 +246,8 @@ class CConfigManager {
     void                                               updateWatcher();
 
     std::string                                        parseKeyword(const std::string&, const std::string&);
+    // keywords that aren't values, so that a reload can tell whether they changed
+    void recordReloadKeyword(const std::string& command, const std::string& value);
 
     void                                               addParseError(const std::string&);
 
@@ -314,6 +325,21 @@ class CConfigManager {
 
     uint32_t                                         m_configValueNumber = 0;
 
+    struct SConfigSubscription {
+        WP<CONFIG_CHANGE_FN>     fn;
+        std::vector<std::string> keys;
+        std::vector<std::string> values; // as of the last notify
+    };
+    std::vector<SConfigSubscription> m_subscriptions;
+
+    // what a reload compares against the previous one
+    using ReloadState = std::array<std::string, NConfigChanges::CONFIG_CHANGE_COUNT>;
+    ReloadState                                               m_reloadState;
+    ReloadState                                               m_reloadKeywords;
+    NConfigChanges::CONFIG_CHANGES                            m_changedSinceReload; // by keywords, which the reload reverts
+    std::vector<std::string>                                  m_configValueNames;
+    std::unordered_map<std::string, std::vector<std::string>> m_specialConfigValueNames;
+
     // internal methods
     void                                      setDefaultAnimationVars();
     std::optional<std::string>                resetHLConfig();
@@ -322,6 +348,9 @@ class CConfigManager {
     void                                      reloadRuleConfigs();
 
     void                                      postConfigReload(const Hyprlang::CParseResult& result);
+    void                                      notifySubscribers();
+    std::string                               configValueString(const std::string& key);
+    ReloadState                               captureReloadState();
     SWorkspaceRule                            mergeWorkspaceRules(const SWorkspaceRule&, const SWorkspaceRule&);
 
     void                                      registerConfigVar(const char* name, const Hyprlang::INT& val);
@@ -329,6 +358,7 @@ class CConfigManager {
     void                                      registerConfigVar(const char* name, const Hyprlang::VEC2& val);
     void                                      registerConfigVar(const char* name, const Hyprlang::STRING& val);
     void                                      registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val);
+    void                                      registerSpecialConfigVar(const char* category, const char* name, const Hyprlang::CConfigValue& val);
 
     std::unordered_map<SFloatCache, Vector2D> m_mStoredFloatingSizes;
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <typeindex>
 #include <hyprlang.hpp>
 #include "../macros.hpp"
@@ -36,6 +38,14 @@ class CConfigValue {
         return *ptr();
     }
 
+    // no copy, points into the parser's storage and is only valid until the next reload
+    std::string_view view() const
+        requires(std::is_same_v<T, std::string> || std::is_same_v<T, Hyprlang::STRING>)
+    {
+        const auto STR = *rc<const Hyprlang::STRING*>(p_);
+        return STR ? std::string_view{STR} : std::string_view{};
+    }
+
   private:
     void* const* p_ = nullptr;
 };
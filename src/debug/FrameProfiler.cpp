@@ -0,0 +1,219 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <format>
+
+using namespace std::chrono;
+
+void CFrameProfiler::beginFrame(MONITORID monitor) {
+    auto& m = m_monitors[monitor];
+
+    if (m.ring.empty())
+        m.ring.resize(FRAMES_PER_MONITOR);
+
+    m.current = SFrame{.start = Time::steadyNow()};
+    m.inFrame = true;
+}
+
+void CFrameProfiler::endFrame(MONITORID monitor) {
+    const auto IT = m_monitors.find(monitor);
+    if (IT == m_monitors.end() || !IT->second.inFrame)
+        return;
+
+    auto& m   = IT->second;
+    m.inFrame = false;
+
+    // nothing was drawn (no damage, direct scanout), not a frame worth keeping
+    if (m.current.stages[PROFILER_STAGE_PLAN] == Time::steady_dur{} && m.current.stages[PROFILER_STAGE_RENDER] == Time::steady_dur{})
+        return;
+
+    for (size_t i = 0; i < PROFILER_STAGE_COUNT; ++i) {
+        m.current.stages[i] += m_unboundTotals[i] - m.unboundAtLastFrame[i];
+    }
+    m.unboundAtLastFrame = m_unboundTotals;
+
+    m.current.total = Time::steadyNow() - m.current.start;
+    m.ring[m.next]  = m.current;
+    m.next          = (m.next + 1) % m.ring.size();
+    m.frames        = std::min(m.frames + 1, m.ring.size());
+
+    TRACY_FRAME_MARK;
+}
+
+void CFrameProfiler::removeMonitor(MONITORID monitor) {
+    m_monitors.erase(monitor);
+}
+
+void CFrameProfiler::enterZone() {
+    m_openZones.emplace_back();
+}
+
+void CFrameProfiler::leaveZone(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end) {
+    // the profiler came up while the zone was open
+    if (m_openZones.empty()) {
+        record(stage, name, monitor, begin, end, {});
+        return;
+    }
+
+    const auto NESTED = m_openZones.back();
+    m_openZones.pop_back();
+
+    record(stage, name, monitor, begin, end, NESTED);
+}
+
+void CFrameProfiler::addZone(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end) {
+    record(stage, name, monitor, begin, end, {});
+}
+
+void CFrameProfiler::record(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end, const Time::steady_dur& nested) {
+    const auto DURATION = end - begin;
+
+    if (const auto IT = m_monitors.find(monitor); IT != m_monitors.end() && IT->second.inFrame)
+        IT->second.current.stages[stage] += DURATION - nested;
+    else
+        m_unboundTotals[stage] += DURATION - nested;
+
+    if (!m_openZones.empty())
+        m_openZones.back() += DURATION;
+
+    if (m_zones.empty())
+        m_zones.resize(ZONES);
+
+    m_zones[m_nextZone] = SZone{.name = name, .monitor = monitor, .start = begin, .duration = DURATION};
+    m_nextZone          = (m_nextZone + 1) % m_zones.size();
+}
+
+std::vector<MONITORID> CFrameProfiler::monitors() const {
+    std::vector<MONITORID> result;
+    for (const auto& [id, m] : m_monitors) {
+        result.emplace_back(id);
+    }
+    std::ranges::sort(result);
+    return result;
+}
+
+std::vector<CFrameProfiler::SFrame> CFrameProfiler::frames(MONITORID monitor) const {
+    const auto IT = m_monitors.find(monitor);
+    if (IT == m_monitors.end())
+        return {};
+
+    const auto&         m = IT->second;
+
+    std::vector<SFrame> result;
+    result.reserve(m.frames);
+    for (size_t i = 0; i < m.frames; ++i) {
+        result.emplace_back(m.ring[(m.next + m.ring.size() - m.frames + i) % m.ring.size()]);
+    }
+
+    return result;
+}
+
+static CFrameProfiler::SStageStats statsOf(std::vector<Time::steady_dur>& samples) {
+    if (samples.empty())
+        return {};
+
+    std::ranges::sort(samples);
+
+    Time::steady_dur sum = {};
+    for (const auto& s : samples) {
+        sum += s;
+    }
+
+    return {
+        .avg = sum / sc<int64_t>(samples.size()),
+        .p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)],
+        .max = samples.back(),
+    };
+}
+
+CFrameProfiler::SSummary CFrameProfiler::summarize(MONITORID monitor) const {
+    const auto                    FRAMES = frames(monitor);
+
+    SSummary                      result = {.frames = FRAMES.size()};
+
+    std::vector<Time::steady_dur> samples;
+    samples.reserve(FRAMES.size());
+
+    for (size_t stage = 0; stage < PROFILER_STAGE_COUNT; ++stage) {
+        samples.clear();
+        for (const auto& f : FRAMES) {
+            samples.emplace_back(f.stages[stage]);
+        }
+        result.stages[stage] = statsOf(samples);
+    }
+
+    samples.clear();
+    for (const auto& f : FRAMES) {
+        samples.emplace_back(f.total);
+    }
+    result.total = statsOf(samples);
+
+    return result;
+}
+
+std::string CFrameProfiler::chromeTrace() const {
+    const auto  toUs = [](const Time::steady_tp& tp) { return duration_cast<nanoseconds>(tp.time_since_epoch()).count() / 1000.0; };
+    const auto  tid  = [](MONITORID monitor) { return monitor == MONITOR_INVALID ? 0 : monitor + 1; };
+
+    std::string result = "{\"traceEvents\":[\n";
+
+    result += R"#({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"main"}})#";
+    for (const auto& id : monitors()) {
+        result += std::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"monitor {}\"}}}}", tid(id), id);
+
+        for (const auto& f : frames(id)) {
+            result += std::format(",\n{{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", tid(id), toUs(f.start),
+                                  duration_cast<nanoseconds>(f.total).count() / 1000.0);
+        }
+    }
+
+    // oldest first, the slot we'd write next is the oldest one if the ring has wrapped
+    for (size_t i = 0; i < m_zones.size(); ++i) {
+        const auto& ZONE = m_zones[(m_nextZone + i) % m_zones.size()];
+        if (!ZONE.name)
+            continue;
+
+        result += std::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", ZONE.name, tid(ZONE.monitor), toUs(ZONE.start),
+                              duration_cast<nanoseconds>(ZONE.duration).count() / 1000.0);
+    }
+
+    result += "\n]}\n";
+
+    return result;
+}
+
+const char* CFrameProfiler::stageName(eProfilerStage stage) {
+    switch (stage) {
+        case PROFILER_STAGE_ANIMATION: return "animation";
+        case PROFILER_STAGE_LAYOUT: return "layout";
+        case PROFILER_STAGE_PLAN: return "plan";
+        case PROFILER_STAGE_RENDER: return "render";
+        case PROFILER_STAGE_COMMIT: return "commit";
+        case PROFILER_STAGE_INPUT: return "input";
+        case PROFILER_STAGE_RULES: return "rules";
+        case PROFILER_STAGE_IPC: return "ipc";
+        default: break;
+    }
+
+    return "unknown";
+}
+
+CProfilerZone::CProfilerZone(eProfilerStage stage, const char* name, MONITORID monitor) : m_stage(stage), m_name(name), m_monitor(monitor), m_begin(Time::steadyNow()) {
+    if (g_pFrameProfiler)
+        g_pFrameProfiler->enterZone();
+}
+
+CProfilerZone::~CProfilerZone() {
+    if (g_pFrameProfiler)
+        g_pFrameProfiler->leaveZone(m_stage, m_name, m_monitor, m_begin, Time::steadyNow());
+}
+
+CProfilerFrame::CProfilerFrame(MONITORID monitor) : m_monitor(monitor) {
+    if (g_pFrameProfiler)
+        g_pFrameProfiler->beginFrame(monitor);
+}
+
+CProfilerFrame::~CProfilerFrame() {
+    if (g_pFrameProfiler)
+        g_pFrameProfiler->endFrame(m_monitor);
+}
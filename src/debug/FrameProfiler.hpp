@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../SharedDefs.hpp"
+#include "../macros.hpp"
+#include "../helpers/time/Time.hpp"
+#include "../helpers/memory/Memory.hpp"
+#include "TracyDefines.hpp"
+
+enum eProfilerStage : uint8_t {
+    PROFILER_STAGE_ANIMATION = 0,
+    PROFILER_STAGE_LAYOUT,
+    PROFILER_STAGE_PLAN,   // building the render pass
+    PROFILER_STAGE_RENDER, // executing it
+    PROFILER_STAGE_COMMIT,
+
+    // not tied to a monitor, counted towards the next frame of every monitor
+    PROFILER_STAGE_INPUT,
+    PROFILER_STAGE_RULES,
+    PROFILER_STAGE_IPC,
+
+    PROFILER_STAGE_COUNT,
+};
+
+/*
+    Always-on recorder of where the main thread spends its time. Every monitor keeps the
+    last few seconds of frames with a per-stage breakdown, and every zone goes into a shared
+    ring that can be dumped as a Chrome trace (chrome://tracing, Perfetto).
+    With Tracy built in, the same zones show up there too.
+*/
+class CFrameProfiler {
+  public:
+    static constexpr size_t FRAMES_PER_MONITOR = 512;
+    static constexpr size_t ZONES              = 16384;
+
+    struct SFrame {
+        Time::steady_tp                                    start;
+        Time::steady_dur                                   total  = {};
+        std::array<Time::steady_dur, PROFILER_STAGE_COUNT> stages = {};
+    };
+
+    struct SStageStats {
+        Time::steady_dur avg = {};
+        Time::steady_dur p99 = {};
+        Time::steady_dur max = {};
+    };
+
+    struct SSummary {
+        size_t                                        frames = 0;
+        SStageStats                                   total;
+        std::array<SStageStats, PROFILER_STAGE_COUNT> stages;
+    };
+
+    void                   beginFrame(MONITORID monitor);
+    void                   endFrame(MONITORID monitor);
+    void                   removeMonitor(MONITORID monitor);
+
+    // zones nest, a stage is only charged for the time not spent in zones within it
+    void                   enterZone();
+    void                   leaveZone(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end);
+    // for a zone that can't be a scope, must not contain other zones
+    void                   addZone(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end);
+
+    std::vector<MONITORID> monitors() const;
+    // oldest first
+    std::vector<SFrame> frames(MONITORID monitor) const;
+    SSummary            summarize(MONITORID monitor) const;
+
+    // the trace event format, one thread per monitor and one for the rest
+    std::string        chromeTrace() const;
+
+    static const char* stageName(eProfilerStage stage);
+
+  private:
+    using StageTimes = std::array<Time::steady_dur, PROFILER_STAGE_COUNT>;
+
+    void record(eProfilerStage stage, const char* name, MONITORID monitor, const Time::steady_tp& begin, const Time::steady_tp& end, const Time::steady_dur& nested);
+
+    struct SZone {
+        const char*      name    = nullptr;
+        MONITORID        monitor = MONITOR_INVALID;
+        Time::steady_tp  start;
+        Time::steady_dur duration = {};
+    };
+
+    struct SMonitorFrames {
+        std::vector<SFrame> ring;
+        size_t              next   = 0;
+        size_t              frames = 0; // how much of the ring is filled
+
+        SFrame              current;
+        bool                inFrame            = false;
+        StageTimes          unboundAtLastFrame = {};
+    };
+
+    std::unordered_map<MONITORID, SMonitorFrames> m_monitors;
+    StageTimes                                    m_unboundTotals = {}; // running totals of zones outside of any frame
+    std::vector<SZone>                            m_zones;
+    size_t                                        m_nextZone = 0;
+    std::vector<Time::steady_dur>                 m_openZones; // time spent in zones nested in each open one
+};
+
+inline UP<CFrameProfiler> g_pFrameProfiler;
+
+// times the rest of the scope
+class CProfilerZone {
+  public:
+    CProfilerZone(eProfilerStage stage, const char* name, MONITORID monitor = MONITOR_INVALID);
+    ~CProfilerZone();
+
+    CProfilerZone(const CProfilerZone&)            = delete;
+    CProfilerZone& operator=(const CProfilerZone&) = delete;
+
+  private:
+    eProfilerStage  m_stage;
+    const char*     m_name;
+    MONITORID       m_monitor;
+    Time::steady_tp m_begin;
+};
+
+// everything profiled on the monitor until the end of the scope belongs to one frame
+class CProfilerFrame {
+  public:
+    CProfilerFrame(MONITORID monitor);
+    ~CProfilerFrame();
+
+    CProfilerFrame(const CProfilerFrame&)            = delete;
+    CProfilerFrame& operator=(const CProfilerFrame&) = delete;
+
+  private:
+    MONITORID m_monitor;
+};
+
+#define PROFILER_ZONE(stage, name, ...)                                                                                                                                            \
+    TRACY_CPU_ZONE(name);                                                                                                                                                          \
+    CProfilerZone profilerZone(stage, name __VA_OPT__(, ) __VA_ARGS__)
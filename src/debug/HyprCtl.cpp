@@ -16,6 +16,7 @@
 #include <sys/un.h>
 #include <unistd.h>
 #include <sys/poll.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <ranges>
 #include <sys/eventfd.h>
@@ -47,7 +48,10 @@ using namespace Hyprutils::OS;
 #include "../desktop/rule/Engine.hpp"
 #include "../desktop/history/WindowHistoryTracker.hpp"
 #include "../desktop/state/FocusState.hpp"
+#include "../helpers/Launcher.hpp"
+#include "FrameProfiler.hpp"
 #include "../version.h"
+#include "HyprCtlBinary.hpp"
 
 #include "../Compositor.hpp"
 #include "../managers/input/InputManager.hpp"
@@ -58,6 +62,7 @@ using namespace Hyprutils::OS;
 #include "../debug/HyprNotificationOverlay.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
 
 #if defined(__DragonFly__) || defined(__FreeBSD__)
 #include <sys/ucred.h>
@@ -286,6 +291,63 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
     return result;
 }
 
+// reused between requests so serializing doesn't have to regrow a buffer every time
+static HyprCtl::CBinaryWriter& binaryWriter() {
+    static HyprCtl::CBinaryWriter writer;
+    return writer;
+}
+
+// id i64, name str, description str, make str, model str, serial str, width i32, height i32, physicalWidth i32, physicalHeight i32,
+// refreshRate f32, x i32, y i32, activeWorkspace (id i64, name str), specialWorkspace (id i64, name str), reserved 4x i32 (l, t, r, b),
+// scale f32, transform u8, focused bool, dpmsStatus bool, vrr bool, solitary u64, activelyTearing bool, directScanoutTo u64, disabled bool,
+// currentFormat str, mirrorOf i64 (-1 for none), availableModes list<str>, colorManagementPreset str, sdrBrightness f32, sdrSaturation f32,
+// sdrMinLuminance f32, sdrMaxLuminance i32
+static void writeMonitorBinary(HyprCtl::CBinaryWriter& out, PHLMONITOR m) {
+    out.beginRecord();
+    out.writeI64(m->m_id);
+    out.writeString(m->m_name);
+    out.writeString(m->m_shortDescription);
+    out.writeString(m->m_output->make);
+    out.writeString(m->m_output->model);
+    out.writeString(m->m_output->serial);
+    out.writeI32(m->m_pixelSize.x);
+    out.writeI32(m->m_pixelSize.y);
+    out.writeI32(m->m_output->physicalSize.x);
+    out.writeI32(m->m_output->physicalSize.y);
+    out.writeF32(m->m_refreshRate);
+    out.writeI32(m->m_position.x);
+    out.writeI32(m->m_position.y);
+    out.writeI64(m->activeWorkspaceID());
+    out.writeString(m->m_activeWorkspace ? m->m_activeWorkspace->m_name : "");
+    out.writeI64(m->activeSpecialWorkspaceID());
+    out.writeString(m->m_activeSpecialWorkspace ? m->m_activeSpecialWorkspace->m_name : "");
+    out.writeI32(m->m_reservedArea.left());
+    out.writeI32(m->m_reservedArea.top());
+    out.writeI32(m->m_reservedArea.right());
+    out.writeI32(m->m_reservedArea.bottom());
+    out.writeF32(m->m_scale);
+    out.writeU8(sc<uint8_t>(m->m_transform));
+    out.writeBool(m == Desktop::focusState()->monitor());
+    out.writeBool(m->m_dpmsStatus);
+    out.writeBool(m->m_output->state->state().adaptiveSync);
+    out.writeU64(rc<uint64_t>(m->m_solitaryClient.get()));
+    out.writeBool(m->m_tearingState.activelyTearing);
+    out.writeU64(rc<uint64_t>(m->m_lastScanout.get()));
+    out.writeBool(!m->m_enabled);
+    out.writeString(formatToString(m->m_output->state->state().drmFormat));
+    out.writeI64(m->m_mirrorOf ? m->m_mirrorOf->m_id : -1);
+    out.writeU32(m->m_output->modes.size());
+    for (auto const& mode : m->m_output->modes) {
+        out.writeString(std::format("{}x{}@{:.2f}Hz", mode->pixelSize.x, mode->pixelSize.y, mode->refreshRate / 1000.0));
+    }
+    out.writeString(NCMType::toString(m->m_cmType));
+    out.writeF32(m->m_sdrBrightness);
+    out.writeF32(m->m_sdrSaturation);
+    out.writeF32(m->m_sdrMinLuminance);
+    out.writeI32(m->m_sdrMaxLuminance);
+    out.endRecord();
+}
+
 static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string request) {
     CVarList vars(request, 0, ' ');
     auto     allMonitors = false;
@@ -296,6 +358,20 @@ static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string requ
     if (vars.size() == 2 && vars[1] == "all")
         allMonitors = true;
 
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_MONITORS);
+
+        for (auto const& m : allMonitors ? g_pCompositor->m_realMonitors : g_pCompositor->m_monitors) {
+            if (!m->m_output || m->m_id == -1)
+                continue;
+
+            writeMonitorBinary(out, m);
+        }
+
+        return out.finish();
+    }
+
     std::string result = "";
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
@@ -353,16 +429,74 @@ static std::string getGroupedData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     return result.str();
 }
 
-std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
-        const auto& HISTORY = Desktop::History::windowTracker()->fullHistory();
-        for (size_t i = 0; i < HISTORY.size(); ++i) {
-            if (HISTORY[i].lock() == wnd)
-                return HISTORY.size() - i - 1; // reverse order for backwards compat
+static int getFocusHistoryID(PHLWINDOW wnd) {
+    const auto& HISTORY = Desktop::History::windowTracker()->fullHistory();
+    for (size_t i = 0; i < HISTORY.size(); ++i) {
+        if (HISTORY[i].lock() == wnd)
+            return HISTORY.size() - i - 1; // reverse order for backwards compat
+    }
+    return -1;
+}
+
+// address u64, mapped bool, hidden bool, x i32, y i32, w i32, h i32, workspace (id i64, name str), floating bool, pseudo bool,
+// monitor i64, class str, title str, initialClass str, initialTitle str, pid i32, xwayland bool, pinned bool, fullscreen u8,
+// fullscreenClient u8, grouped list<u64>, tags list<str>, swallowing u64, focusHistoryID i32, inhibitingIdle bool, xdgTag str,
+// xdgDescription str, contentType str
+static void writeWindowBinary(HyprCtl::CBinaryWriter& out, PHLWINDOW w) {
+    out.beginRecord();
+    out.writeU64(rc<uintptr_t>(w.get()));
+    out.writeBool(w->m_isMapped);
+    out.writeBool(w->isHidden());
+    out.writeI32(w->m_realPosition->goal().x);
+    out.writeI32(w->m_realPosition->goal().y);
+    out.writeI32(w->m_realSize->goal().x);
+    out.writeI32(w->m_realSize->goal().y);
+    out.writeI64(w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID);
+    out.writeString(w->m_workspace ? w->m_workspace->m_name : "");
+    out.writeBool(w->m_isFloating);
+    out.writeBool(w->m_isPseudotiled);
+    out.writeI64(w->monitorID());
+    out.writeString(w->m_class);
+    out.writeString(w->m_title);
+    out.writeString(w->m_initialClass);
+    out.writeString(w->m_initialTitle);
+    out.writeI32(w->getPID());
+    out.writeBool(w->m_isX11);
+    out.writeBool(w->m_pinned);
+    out.writeU8(sc<uint8_t>(w->m_fullscreenState.internal));
+    out.writeU8(sc<uint8_t>(w->m_fullscreenState.client));
+
+    if (w->m_groupData.pNextWindow.expired())
+        out.writeU32(0);
+    else {
+        const auto HEAD    = w->getGroupHead();
+        uint32_t   members = 0;
+        for (auto curr = HEAD; members == 0 || curr != HEAD; curr = curr->m_groupData.pNextWindow.lock()) {
+            members++;
         }
-        return -1;
-    };
 
+        out.writeU32(members);
+        for (auto curr = HEAD; members > 0; curr = curr->m_groupData.pNextWindow.lock(), --members) {
+            out.writeU64(rc<uintptr_t>(curr.get()));
+        }
+    }
+
+    const auto& TAGS = w->m_ruleApplicator->m_tagKeeper.getTags();
+    out.writeU32(TAGS.size());
+    for (auto const& tag : TAGS) {
+        out.writeString(tag);
+    }
+
+    out.writeU64(rc<uintptr_t>(w->m_swallowed.get()));
+    out.writeI32(getFocusHistoryID(w));
+    out.writeBool(g_pInputManager->isWindowInhibiting(w, false));
+    out.writeString(w->xdgTag().value_or(""));
+    out.writeString(w->xdgDescription().value_or(""));
+    out.writeString(NContentType::toString(w->getContentType()));
+    out.endRecord();
+}
+
+std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         return std::format(
             R"#({{
@@ -421,6 +555,20 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
 }
 
 static std::string clientsRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_CLIENTS);
+
+        for (auto const& w : g_pCompositor->m_windows) {
+            if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
+                continue;
+
+            writeWindowBinary(out, w);
+        }
+
+        return out.finish();
+    }
+
     std::string result = "";
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
@@ -475,6 +623,25 @@ std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat form
     }
 }
 
+// id i64, name str, monitor str, monitorID i64 (-1 for none), windows i32, hasfullscreen bool, lastwindow u64, lastwindowtitle str,
+// ispersistent bool
+static void writeWorkspaceBinary(HyprCtl::CBinaryWriter& out, PHLWORKSPACE w) {
+    const auto PLASTW   = w->getLastFocusedWindow();
+    const auto PMONITOR = w->m_monitor.lock();
+
+    out.beginRecord();
+    out.writeI64(w->m_id);
+    out.writeString(w->m_name);
+    out.writeString(PMONITOR ? PMONITOR->m_name : "?");
+    out.writeI64(PMONITOR ? PMONITOR->m_id : -1);
+    out.writeI32(w->getWindows());
+    out.writeBool(w->m_hasFullscreenWindow);
+    out.writeU64(rc<uintptr_t>(PLASTW.get()));
+    out.writeString(PLASTW ? PLASTW->m_title : "");
+    out.writeBool(w->isPersistent());
+    out.endRecord();
+}
+
 static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputFormat format) {
     const auto boolToString = [](const bool b) -> std::string { return b ? "true" : "false"; };
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
@@ -536,10 +703,28 @@ static std::string activeWorkspaceRequest(eHyprCtlOutputFormat format, std::stri
     if (!valid(w))
         return "internal error";
 
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_ACTIVEWORKSPACE);
+        writeWorkspaceBinary(out, w);
+        return out.finish();
+    }
+
     return CHyprCtl::getWorkspaceData(w, format);
 }
 
 static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_WORKSPACES);
+
+        for (auto const& w : g_pCompositor->getWorkspaces()) {
+            writeWorkspaceBinary(out, w.lock());
+        }
+
+        return out.finish();
+    }
+
     std::string result = "";
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
@@ -583,6 +768,17 @@ static std::string workspaceRulesRequest(eHyprCtlOutputFormat format, std::strin
 static std::string activeWindowRequest(eHyprCtlOutputFormat format, std::string request) {
     const auto PWINDOW = Desktop::focusState()->window();
 
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        // no records if nothing is focused
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_ACTIVEWINDOW);
+
+        if (validMapped(PWINDOW))
+            writeWindowBinary(out, PWINDOW);
+
+        return out.finish();
+    }
+
     if (!validMapped(PWINDOW))
         return format == eHyprCtlOutputFormat::FORMAT_JSON ? "{}" : "Invalid";
 
@@ -595,6 +791,39 @@ static std::string activeWindowRequest(eHyprCtlOutputFormat format, std::string
 }
 
 static std::string layersRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (format == eHyprCtlOutputFormat::FORMAT_BINARY) {
+        // one record per monitor: name str, levels list<list<layer>>
+        // layer: address u64, x i32, y i32, w i32, h i32, namespace str, pid i32
+        auto& out = binaryWriter();
+        out.begin(HyprCtl::CBinaryWriter::KIND_LAYERS);
+
+        for (auto const& mon : g_pCompositor->m_monitors) {
+            out.beginRecord();
+            out.writeString(mon->m_name);
+            out.writeU32(mon->m_layerSurfaceLayers.size());
+
+            for (auto const& level : mon->m_layerSurfaceLayers) {
+                out.writeU32(level.size());
+
+                for (auto const& layer : level) {
+                    out.beginRecord();
+                    out.writeU64(rc<uintptr_t>(layer.get()));
+                    out.writeI32(layer->m_geometry.x);
+                    out.writeI32(layer->m_geometry.y);
+                    out.writeI32(layer->m_geometry.width);
+                    out.writeI32(layer->m_geometry.height);
+                    out.writeString(layer->m_namespace);
+                    out.writeI32(layer->getPID());
+                    out.endRecord();
+                }
+            }
+
+            out.endRecord();
+        }
+
+        return out.finish();
+    }
+
     std::string result = "";
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
@@ -1356,7 +1585,7 @@ static std::string reloadRequest(eHyprCtlOutputFormat format, std::string reques
     if (REQMODE == "config-only")
         g_pConfigManager->m_noMonitorReload = true;
 
-    g_pConfigManager->reload();
+    g_pConfigManager->reload(true);
 
     return "ok";
 }
@@ -2049,6 +2278,111 @@ static std::string submapRequest(eHyprCtlOutputFormat format, std::string reques
     return format == FORMAT_JSON ? std::format("{{\"{}\"}}\n", escapeJSONStrings(submap)) : (submap + "\n");
 }
 
+static std::string spawnStatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto& STATS = NLauncher::stats();
+
+    const auto  toUs = [](Time::steady_dur d) { return std::chrono::duration_cast<std::chrono::microseconds>(d).count(); };
+    const auto  AVG  = STATS.spawns ? toUs(STATS.total) / sc<int64_t>(STATS.spawns) : 0;
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(R"#({{
+    "spawns": {},
+    "direct": {},
+    "failures": {},
+    "lastUs": {},
+    "avgUs": {},
+    "maxUs": {}
+}})#",
+                           STATS.spawns, STATS.direct, STATS.failures, toUs(STATS.last), AVG, toUs(STATS.max));
+    }
+
+    return std::format("spawns: {} ({} without a shell)\nfailures: {}\nlatency: last {}us, avg {}us, max {}us\n", STATS.spawns, STATS.direct, STATS.failures, toUs(STATS.last), AVG,
+                       toUs(STATS.max));
+}
+
+static std::string frametimesRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (request.ends_with(" trace"))
+        return g_pFrameProfiler->chromeTrace();
+
+    const auto  toMs = [](Time::steady_dur d) { return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / 1000000.0; };
+
+    std::string result = format == FORMAT_JSON ? "[" : "";
+
+    for (const auto& id : g_pFrameProfiler->monitors()) {
+        const auto MONITOR = g_pCompositor->getMonitorFromID(id);
+        const auto NAME    = MONITOR ? MONITOR->m_name : std::format("(gone, ID {})", id);
+        const auto SUMMARY = g_pFrameProfiler->summarize(id);
+
+        if (format == FORMAT_JSON) {
+            result += std::format(R"#({{
+    "id": {},
+    "name": "{}",
+    "frames": {},
+    "total": {{"avgMs": {:.3f}, "p99Ms": {:.3f}, "maxMs": {:.3f}}},
+    "stages": {{)#",
+                                  id, escapeJSONStrings(NAME), SUMMARY.frames, toMs(SUMMARY.total.avg), toMs(SUMMARY.total.p99), toMs(SUMMARY.total.max));
+
+            for (size_t stage = 0; stage < PROFILER_STAGE_COUNT; ++stage) {
+                const auto& S = SUMMARY.stages[stage];
+                result += std::format("\n        \"{}\": {{\"avgMs\": {:.3f}, \"p99Ms\": {:.3f}, \"maxMs\": {:.3f}}},", CFrameProfiler::stageName(sc<eProfilerStage>(stage)),
+                                      toMs(S.avg), toMs(S.p99), toMs(S.max));
+            }
+
+            trimTrailingComma(result);
+            result += "\n    }\n},";
+            continue;
+        }
+
+        result += std::format("Monitor {} (ID {}): last {} frames\n{:>12} {:>9} {:>9} {:>9}\n", NAME, id, SUMMARY.frames, "ms", "avg", "p99", "max");
+        for (size_t stage = 0; stage < PROFILER_STAGE_COUNT; ++stage) {
+            const auto& S = SUMMARY.stages[stage];
+            result += std::format("{:>12} {:>9.3f} {:>9.3f} {:>9.3f}\n", CFrameProfiler::stageName(sc<eProfilerStage>(stage)), toMs(S.avg), toMs(S.p99), toMs(S.max));
+        }
+        result += std::format("{:>12} {:>9.3f} {:>9.3f} {:>9.3f}\n\n", "total", toMs(SUMMARY.total.avg), toMs(SUMMARY.total.p99), toMs(SUMMARY.total.max));
+    }
+
+    if (format == FORMAT_JSON) {
+        trimTrailingComma(result);
+        result += "]";
+    }
+
+    return result;
+}
+
+static std::string framebuffersRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto  toMiB = [](size_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+    std::string result = format == FORMAT_JSON ? "[" : "";
+
+    for (const auto& [monitor, data] : g_pHyprOpenGL->m_monitorRenderResources) {
+        const auto NAME  = monitor ? monitor->m_name : std::string{"(gone)"};
+        const auto STATS = data.framebuffers.stats();
+
+        if (format == FORMAT_JSON) {
+            result += std::format(R"#({{
+    "name": "{}",
+    "framebuffers": {},
+    "inUse": {},
+    "bytes": {},
+    "allocations": {},
+    "reuses": {}
+}},)#",
+                                  escapeJSONStrings(NAME), STATS.framebuffers, STATS.inUse, STATS.bytes, STATS.allocations, STATS.reuses);
+            continue;
+        }
+
+        result += std::format("Monitor {}: {} framebuffers ({} in use), {:.1f} MiB\n\tacquired {} times, {} of them without allocating\n\n", NAME, STATS.framebuffers, STATS.inUse,
+                              toMiB(STATS.bytes), STATS.allocations + STATS.reuses, STATS.reuses);
+    }
+
+    if (format == FORMAT_JSON) {
+        trimTrailingComma(result);
+        result += "]";
+    }
+
+    return result;
+}
+
 static std::string reloadShaders(eHyprCtlOutputFormat format, std::string request) {
     if (g_pHyprOpenGL->initShaders())
         return format == FORMAT_JSON ? "{\"ok\": true}" : "ok";
@@ -2079,6 +2413,9 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"descriptions", true, getDescriptions});
     registerCommand(SHyprCtlCommand{"submap", true, submapRequest});
     registerCommand(SHyprCtlCommand{.name = "reloadshaders", .exact = true, .fn = reloadShaders});
+    registerCommand(SHyprCtlCommand{.name = "spawnstats", .exact = true, .fn = spawnStatsRequest});
+    registerCommand(SHyprCtlCommand{.name = "frametimes", .exact = false, .fn = frametimesRequest});
+    registerCommand(SHyprCtlCommand{.name = "framebuffers", .exact = true, .fn = framebuffersRequest});
 
     registerCommand(SHyprCtlCommand{"monitors", false, monitorsRequest});
     registerCommand(SHyprCtlCommand{"reload", false, reloadRequest});
@@ -2100,8 +2437,13 @@ CHyprCtl::CHyprCtl() {
 }
 
 CHyprCtl::~CHyprCtl() {
+    m_clients.clear();
+    if (m_clientTimeoutTimer && g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_clientTimeoutTimer);
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
+    if (m_logFollowSource)
+        wl_event_source_remove(m_logFollowSource);
     if (!m_socketPath.empty())
         unlink(m_socketPath.c_str());
 }
@@ -2139,6 +2481,8 @@ std::string CHyprCtl::getReply(std::string request) {
 
             if (c == 'j')
                 format = eHyprCtlOutputFormat::FORMAT_JSON;
+            else if (c == 'b')
+                format = eHyprCtlOutputFormat::FORMAT_BINARY;
             else if (c == 'r')
                 reloadAll = true;
             else if (c == 'a')
@@ -2153,13 +2497,23 @@ std::string CHyprCtl::getReply(std::string request) {
 
     std::string result = "";
 
+    // only a handful of requests can be encoded in binary, the rest answer in the normal format
+    const auto formatFor = [format](const SP<SHyprCtlCommand>& cmd) {
+        static const std::array<std::string_view, 6> BINARY_COMMANDS = {"clients", "workspaces", "activeworkspace", "monitors", "layers", "activewindow"};
+
+        if (format == eHyprCtlOutputFormat::FORMAT_BINARY && std::ranges::find(BINARY_COMMANDS, cmd->name) == BINARY_COMMANDS.end())
+            return eHyprCtlOutputFormat::FORMAT_NORMAL;
+
+        return format;
+    };
+
     // parse exact cmds first, then non-exact.
     for (auto const& cmd : m_commands) {
         if (!cmd->exact)
             continue;
 
         if (cmd->name == request) {
-            result = cmd->fn(format, request);
+            result = cmd->fn(formatFor(cmd), request);
             break;
         }
     }
@@ -2170,7 +2524,7 @@ std::string CHyprCtl::getReply(std::string request) {
                 continue;
 
             if (request.starts_with(cmd->name)) {
-                result = cmd->fn(format, request);
+                result = cmd->fn(formatFor(cmd), request);
                 break;
             }
         }
@@ -2216,140 +2570,410 @@ std::string CHyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
 
-static bool successWrite(int fd, const std::string& data, bool needLog = true) {
-    if (write(fd, data.c_str(), data.length()) > 0)
-        return true;
+static bool isFollowUpRollingLogRequest(const std::string& request) {
+    return request.contains("rollinglog") && request.contains("f");
+}
 
-    if (errno == EAGAIN)
-        return true;
+// Keep-alive clients open the connection with this marker, then send NUL-terminated requests.
+// Every reply is prefixed with its length as a little-endian uint32.
+constexpr const char* HYPRCTL_KEEPALIVE_MAGIC   = "[[KEEPALIVE]]";
+constexpr size_t      HYPRCTL_MAX_REQUEST_SIZE  = 4 * 1024 * 1024;
+constexpr auto        HYPRCTL_REQUEST_TIMEOUT   = std::chrono::seconds(5);
+constexpr auto        HYPRCTL_KEEPALIVE_TIMEOUT = std::chrono::seconds(30);
+constexpr size_t      HYPRCTL_FOLLOW_CHUNK      = 64 * 1024;
+constexpr auto        HYPRCTL_TIMEOUT_TICK      = std::chrono::milliseconds(500);
+
+CHyprCtl::SClient::~SClient() {
+    if (eventSource)
+        wl_event_source_remove(eventSource);
+    if (logCursor)
+        Log::CRollingLogFollow::get().stopFollower();
+}
 
-    if (needLog)
-        Log::logger->log(Log::ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+int CHyprCtl::onServerEvent(int fd, uint32_t mask, void* data) {
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
+        return 0;
 
-    return false;
+    g_pHyprCtl->acceptClients();
+    return 0;
 }
 
-static void runWritingDebugLogThread(const int conn) {
-    using namespace std::chrono_literals;
-    Log::logger->log(Log::DEBUG, "In followlog thread, got connection, start writing: {}", conn);
-    //will be finished, when reading side close connection
-    std::thread([conn]() {
-        while (Log::SRollingLogFollow::get().isRunning()) {
-            if (Log::SRollingLogFollow::get().isEmpty(conn)) {
-                std::this_thread::sleep_for(1000ms);
-                continue;
-            }
+int CHyprCtl::onClientEvent(int fd, uint32_t mask, void* data) {
+    g_pHyprCtl->onClientEvent(sc<SClient*>(data), mask);
+    return 0;
+}
 
-            auto line = Log::SRollingLogFollow::get().getLog(conn);
-            if (!successWrite(conn, line))
-                // We cannot write, when connection is closed. So thread will successfully exit by itself
-                break;
+int CHyprCtl::onLogFollowEvent(int fd, uint32_t mask, void* data) {
+    Log::CRollingLogFollow::get().ackWake();
+    g_pHyprCtl->pumpLogFollowers();
+    return 0;
+}
+
+void CHyprCtl::acceptClients() {
+    if (!m_socketFD.isValid())
+        return;
+
+    // drain the backlog, the listening socket is non-blocking.
+    while (true) {
+        sockaddr_in     clientAddress;
+        socklen_t       clientSize = sizeof(clientAddress);
+
+        CFileDescriptor ACCEPTEDCONNECTION{accept4(m_socketFD.get(), rc<sockaddr*>(&clientAddress), &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK)};
 
-            std::this_thread::sleep_for(100ms);
+        if (!ACCEPTEDCONNECTION.isValid()) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                Log::logger->log(Log::ERR, "Hyprctl: failed to accept a connection, errno: {}", errno);
+            return;
         }
-        close(conn);
-        Log::SRollingLogFollow::get().stopFor(conn);
-    }).detach();
+
+        auto client = makeShared<SClient>();
+
+        // try to get creds
+        CRED_T   creds;
+        uint32_t len = sizeof(creds);
+        if (getsockopt(ACCEPTEDCONNECTION.get(), CRED_LVL, CRED_OPT, &creds, &len) == -1)
+            Log::logger->log(Log::ERR, "Hyprctl: failed to get peer creds");
+        else {
+            client->pid = creds.CRED_PID;
+            Log::logger->log(Log::DEBUG, "Hyprctl: new connection from pid {}", creds.CRED_PID);
+        }
+
+        client->fd          = std::move(ACCEPTEDCONNECTION);
+        client->deadline    = Time::steadyNow() + HYPRCTL_REQUEST_TIMEOUT;
+        client->eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, client->fd.get(), WL_EVENT_READABLE, CHyprCtl::onClientEvent, client.get());
+
+        m_clients.emplace_back(client);
+
+        if (!m_clientTimeoutTimer->armed())
+            m_clientTimeoutTimer->updateTimeout(HYPRCTL_TIMEOUT_TICK);
+    }
 }
 
-static bool isFollowUpRollingLogRequest(const std::string& request) {
-    return request.contains("rollinglog") && request.contains("f");
+void CHyprCtl::onClientEvent(SClient* client, uint32_t mask) {
+    if (mask & WL_EVENT_ERROR) {
+        removeClient(client);
+        return;
+    }
+
+    if (mask & WL_EVENT_WRITABLE) {
+        if (!flushClient(client))
+            return;
+
+        if (client->logCursor && !pumpLogFollower(client))
+            return;
+    }
+
+    if (mask & WL_EVENT_READABLE || mask & WL_EVENT_HANGUP) {
+        if (!readFromClient(client))
+            return;
+
+        if (!processClientInput(client))
+            return;
+    }
+
+    // the peer is fully gone, whatever it sent has been handled above
+    if (mask & WL_EVENT_HANGUP) {
+        removeClient(client);
+        return;
+    }
+
+    updateClientEvents(client);
 }
 
-static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
-    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
-        return 0;
+bool CHyprCtl::readFromClient(SClient* client) {
+    std::array<char, 4096> readBuffer;
 
-    if (!g_pHyprCtl->m_socketFD.isValid())
-        return 0;
+    while (true) {
+        const auto LEN = read(client->fd.get(), readBuffer.data(), readBuffer.size());
+
+        if (LEN > 0) {
+            client->inBuffer.append(readBuffer.data(), LEN);
 
-    sockaddr_in            clientAddress;
-    socklen_t              clientSize = sizeof(clientAddress);
+            if (client->inBuffer.size() > HYPRCTL_MAX_REQUEST_SIZE) {
+                Log::logger->log(Log::ERR, "Hyprctl: request from pid {} is too large, dropping", client->pid);
+                removeClient(client);
+                return false;
+            }
 
-    const auto             ACCEPTEDCONNECTION = accept4(g_pHyprCtl->m_socketFD.get(), rc<sockaddr*>(&clientAddress), &clientSize, SOCK_CLOEXEC);
+            continue;
+        }
 
-    std::array<char, 1024> readBuffer;
+        if (LEN == 0) {
+            client->peerClosed = true;
+            return true;
+        }
 
-    // try to get creds
-    CRED_T   creds;
-    uint32_t len = sizeof(creds);
-    if (getsockopt(ACCEPTEDCONNECTION, CRED_LVL, CRED_OPT, &creds, &len) == -1)
-        Log::logger->log(Log::ERR, "Hyprctl: failed to get peer creds");
-    else {
-        g_pHyprCtl->m_currentRequestParams.pid = creds.CRED_PID;
-        Log::logger->log(Log::DEBUG, "Hyprctl: new connection from pid {}", creds.CRED_PID);
+        if (errno == EINTR)
+            continue;
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return true;
+
+        Log::logger->log(Log::ERR, "Hyprctl: couldn't read from socket. Error: {}", strerror(errno));
+        removeClient(client);
+        return false;
     }
+}
 
-    //
-    pollfd pollfds[1] = {
-        {
-            .fd     = ACCEPTEDCONNECTION,
-            .events = POLLIN,
-        },
-    };
+bool CHyprCtl::processClientInput(SClient* client) {
+    // followers have nothing more to say, we only care about them hanging up
+    if (client->logCursor) {
+        client->inBuffer.clear();
 
-    int ret = poll(pollfds, 1, 5000);
+        if (client->peerClosed) {
+            removeClient(client);
+            return false;
+        }
 
-    if (ret <= 0) {
-        close(ACCEPTEDCONNECTION);
-        return 0;
+        return true;
     }
 
-    std::string request;
-    while (true) {
-        readBuffer.fill(0);
-        auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
-        if (messageSize < 1)
-            break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
-        if (messageSize < 1023)
-            break;
+    if (!client->keepAlive && client->inBuffer.starts_with(HYPRCTL_KEEPALIVE_MAGIC)) {
+        client->keepAlive = true;
+        client->inBuffer.erase(0, std::string_view{HYPRCTL_KEEPALIVE_MAGIC}.length());
+        client->deadline = Time::steadyNow() + HYPRCTL_KEEPALIVE_TIMEOUT;
     }
 
+    if (client->keepAlive) {
+        size_t offset = 0;
+        while (!client->waitingOnReply) {
+            const auto END = client->inBuffer.find('\0', offset);
+            if (END == std::string::npos)
+                break;
+
+            const auto REQUEST = client->inBuffer.substr(offset, END - offset);
+            offset             = END + 1;
+
+            if (!handleClientRequest(client, REQUEST))
+                return false;
+        }
+
+        client->inBuffer.erase(0, offset);
+
+        if (client->peerClosed && !client->waitingOnReply) {
+            client->closeAfterFlush = true;
+            return flushClient(client);
+        }
+
+        return true;
+    }
+
+    // legacy clients send exactly one request, and we take whatever arrived as a whole.
+    if (client->closeAfterFlush || client->waitingOnReply)
+        return true;
+
+    if (client->inBuffer.empty()) {
+        if (client->peerClosed) {
+            removeClient(client);
+            return false;
+        }
+
+        return true;
+    }
+
+    const auto REQUEST = std::move(client->inBuffer);
+    client->inBuffer.clear();
+    client->closeAfterFlush = true;
+
+    return handleClientRequest(client, REQUEST);
+}
+
+bool CHyprCtl::handleClientRequest(SClient* client, const std::string& request) {
+    PROFILER_ZONE(PROFILER_STAGE_IPC, "HyprCtlRequest");
+
     std::string reply = "";
 
+    m_currentRequestParams.pid = client->pid;
+
     try {
-        reply = g_pHyprCtl->getReply(request);
+        reply = getReply(request);
     } catch (std::exception& e) {
         Log::logger->log(Log::ERR, "Error in request: {}", e.what());
         reply = "Err: " + std::string(e.what());
     }
 
-    if (g_pHyprCtl->m_currentRequestParams.pendingPromise) {
-        // we have a promise pending
-        g_pHyprCtl->m_currentRequestParams.pendingPromise->then([ACCEPTEDCONNECTION, request](SP<CPromiseResult<std::string>> result) {
+    if (m_currentRequestParams.pendingPromise) {
+        // we have a promise pending. The client may be gone by the time it resolves.
+        client->waitingOnReply = true;
+        client->deadline.reset();
+
+        WP<SClient> weak;
+        for (const auto& c : m_clients) {
+            if (c.get() == client) {
+                weak = c;
+                break;
+            }
+        }
+
+        m_currentRequestParams.pendingPromise->then([weak](SP<CPromiseResult<std::string>> result) {
             const auto RES = result->hasError() ? result->error() : result->result();
-            successWrite(ACCEPTEDCONNECTION, RES);
 
-            // No rollinglog or ensureMonitor here. These are only for plugins for now.
+            // the promise may resolve right away, don't re-enter the client's state machine from here.
+            g_pEventLoopManager->doLater([weak, RES] {
+                if (!weak || !g_pHyprCtl)
+                    return;
+
+                const auto CLIENT = weak.get();
+
+                // No rollinglog or ensureMonitor here. These are only for plugins for now.
+
+                CLIENT->waitingOnReply = false;
+                g_pHyprCtl->queueClientReply(CLIENT, RES);
+
+                if (!g_pHyprCtl->flushClient(CLIENT))
+                    return;
+
+                // continue with requests pipelined behind this one
+                if (!g_pHyprCtl->processClientInput(CLIENT))
+                    return;
 
-            close(ACCEPTEDCONNECTION);
+                g_pHyprCtl->updateClientEvents(CLIENT);
+            });
         });
 
-        g_pHyprCtl->m_currentRequestParams.pendingPromise.reset();
-    } else {
-        successWrite(ACCEPTEDCONNECTION, reply);
+        m_currentRequestParams.pendingPromise.reset();
+        m_currentRequestParams.pid = 0;
+        return true;
+    }
 
-        if (isFollowUpRollingLogRequest(request)) {
-            Log::logger->log(Log::DEBUG, "Followup rollinglog request received. Starting thread to write to socket.");
-            Log::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION);
-            runWritingDebugLogThread(ACCEPTEDCONNECTION);
-            Log::logger->log(Log::DEBUG, Log::SRollingLogFollow::get().debugInfo());
-        } else
-            close(ACCEPTEDCONNECTION);
+    queueClientReply(client, reply);
+
+    if (!client->keepAlive && isFollowUpRollingLogRequest(request)) {
+        Log::logger->log(Log::DEBUG, "Followup rollinglog request received. Following the log on this connection.");
+        client->logCursor       = Log::CRollingLogFollow::get().startFollower();
+        client->closeAfterFlush = false;
+        client->deadline.reset(); // followers stay until they hang up
+        queueClientReply(client, std::format("[LOG] Following log to socket: {} started\n", client->fd.get()));
+        Log::logger->log(Log::DEBUG, Log::CRollingLogFollow::get().debugInfo());
+    }
+
+    if (g_pConfigManager->m_wantsMonitorReload)
+        g_pConfigManager->ensureMonitorStatus();
 
-        if (g_pConfigManager->m_wantsMonitorReload)
-            g_pConfigManager->ensureMonitorStatus();
+    m_currentRequestParams.pid = 0;
 
-        g_pHyprCtl->m_currentRequestParams.pid = 0;
+    return flushClient(client);
+}
+
+void CHyprCtl::queueClientReply(SClient* client, const std::string& reply) {
+    if (client->keepAlive) {
+        const uint32_t LEN = reply.size();
+        for (size_t i = 0; i < sizeof(LEN); ++i) {
+            client->outBuffer += sc<char>((LEN >> (i * 8)) & 0xFF);
+        }
     }
 
-    return 0;
+    client->outBuffer += reply;
+}
+
+bool CHyprCtl::flushClient(SClient* client) {
+    while (client->outOffset < client->outBuffer.size()) {
+        const auto LEN = write(client->fd.get(), client->outBuffer.data() + client->outOffset, client->outBuffer.size() - client->outOffset);
+
+        if (LEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // the rest goes out once the socket is writable again. A follower that can't keep up
+                // isn't stalled, it's just behind: the ring moves on and it's told what it skipped.
+                if (!client->logCursor)
+                    client->deadline = Time::steadyNow() + HYPRCTL_REQUEST_TIMEOUT;
+                return true;
+            }
+
+            Log::logger->log(Log::ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+            removeClient(client);
+            return false;
+        }
+
+        client->outOffset += LEN;
+    }
+
+    client->outBuffer.clear();
+    client->outOffset = 0;
+
+    if (client->waitingOnReply)
+        return true;
+
+    if (client->logCursor) {
+        // followers stay until they hang up
+        client->deadline.reset();
+        return true;
+    }
+
+    if (client->closeAfterFlush) {
+        removeClient(client);
+        return false;
+    }
+
+    client->deadline = Time::steadyNow() + (client->keepAlive ? HYPRCTL_KEEPALIVE_TIMEOUT : HYPRCTL_REQUEST_TIMEOUT);
+
+    return true;
+}
+
+void CHyprCtl::updateClientEvents(SClient* client) {
+    uint32_t mask = 0;
+
+    if (client->outOffset < client->outBuffer.size())
+        mask |= WL_EVENT_WRITABLE;
+
+    // legacy clients are done after their single request
+    if (!client->closeAfterFlush && !client->peerClosed)
+        mask |= WL_EVENT_READABLE;
+
+    wl_event_source_fd_update(client->eventSource, mask);
+}
+
+bool CHyprCtl::pumpLogFollower(SClient* client) {
+    // whatever's left goes out first, we're called again once the socket is writable
+    while (client->outOffset >= client->outBuffer.size()) {
+        const auto LOST = Log::CRollingLogFollow::get().read(*client->logCursor, client->outBuffer, HYPRCTL_FOLLOW_CHUNK);
+        if (LOST > 0)
+            client->outBuffer.insert(0, std::format("[LOG] Follower fell behind, skipped {} bytes\n", LOST));
+
+        if (client->outBuffer.empty())
+            break;
+
+        if (!flushClient(client))
+            return false;
+    }
+
+    return true;
+}
+
+void CHyprCtl::pumpLogFollowers() {
+    // pumping may drop clients
+    std::vector<SP<SClient>> followers;
+    std::ranges::copy_if(m_clients, std::back_inserter(followers), [](const auto& c) { return c->logCursor.has_value(); });
+
+    for (const auto& c : followers) {
+        if (pumpLogFollower(c.get()))
+            updateClientEvents(c.get());
+    }
+}
+
+void CHyprCtl::removeClient(SClient* client) {
+    std::erase_if(m_clients, [client](const auto& c) { return c.get() == client; });
+}
+
+void CHyprCtl::onClientTimeoutTick() {
+    const auto NOW = Time::steadyNow();
+
+    std::erase_if(m_clients, [NOW](const auto& c) {
+        if (!c->deadline || *c->deadline > NOW)
+            return false;
+
+        Log::logger->log(Log::DEBUG, "Hyprctl: dropping stalled connection from pid {}", c->pid);
+        return true;
+    });
+
+    if (!m_clients.empty())
+        m_clientTimeoutTimer->updateTimeout(HYPRCTL_TIMEOUT_TICK);
 }
 
 void CHyprCtl::startHyprCtlSocket() {
-    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)};
 
     if (!m_socketFD.isValid()) {
         Log::logger->log(Log::ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
@@ -2372,5 +2996,12 @@ void CHyprCtl::startHyprCtlSocket() {
 
     Log::logger->log(Log::DEBUG, "Hypr socket started at {}", m_socketPath);
 
-    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, hyprCtlFDTick, nullptr);
+    m_clientTimeoutTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { onClientTimeoutTick(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_clientTimeoutTimer);
+
+    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, CHyprCtl::onServerEvent, nullptr);
+
+    if (Log::CRollingLogFollow::get().wakeFD() >= 0)
+        m_logFollowSource =
+            wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, Log::CRollingLogFollow::get().wakeFD(), WL_EVENT_READABLE, CHyprCtl::onLogFollowEvent, nullptr);
 }
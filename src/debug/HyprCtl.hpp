@@ -5,8 +5,12 @@
 #include "../helpers/defer/Promise.hpp"
 #include "../desktop/view/Window.hpp"
 #include <functional>
+#include <optional>
 #include <sys/types.h>
 #include <hyprutils/os/FileDescriptor.hpp>
+#include "../helpers/time/Time.hpp"
+
+class CEventLoopTimer;
 
 // exposed for main.cpp
 std::string systemInfoRequest(eHyprCtlOutputFormat format, std::string request);
@@ -40,11 +44,59 @@ class CHyprCtl {
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
   private:
+    // a single connection on .socket.sock. Connections are driven entirely by the event loop:
+    // reads and writes are non-blocking, and a client that stalls past its deadline gets dropped.
+    struct SClient {
+        ~SClient();
+
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource = nullptr;
+        pid_t                          pid         = 0;
+
+        // keep-alive clients send NUL-terminated requests and get length-prefixed replies,
+        // legacy clients send a single request and get the raw reply followed by a close.
+        bool        keepAlive       = false;
+        bool        waitingOnReply  = false; // a promise is pending, don't process further requests
+        bool        closeAfterFlush = false;
+        bool        peerClosed      = false;
+
+        std::string inBuffer;
+        std::string outBuffer;
+        size_t      outOffset = 0;
+
+        // set once the client follows the rolling log, where in the log it's at
+        std::optional<uint64_t> logCursor;
+
+        // when this client gets dropped if nothing happens
+        std::optional<Time::steady_tp> deadline;
+    };
+
     void                             startHyprCtlSocket();
 
+    static int                       onServerEvent(int fd, uint32_t mask, void* data);
+    static int                       onClientEvent(int fd, uint32_t mask, void* data);
+    static int                       onLogFollowEvent(int fd, uint32_t mask, void* data);
+
+    void                             acceptClients();
+    void                             onClientEvent(SClient* client, uint32_t mask);
+    bool                             readFromClient(SClient* client);
+    bool                             processClientInput(SClient* client);
+    bool                             handleClientRequest(SClient* client, const std::string& request);
+    void                             queueClientReply(SClient* client, const std::string& reply);
+    bool                             flushClient(SClient* client);
+    void                             updateClientEvents(SClient* client);
+    bool                             pumpLogFollower(SClient* client);
+    void                             pumpLogFollowers();
+    void                             removeClient(SClient* client);
+    void                             onClientTimeoutTick();
+
     std::vector<SP<SHyprCtlCommand>> m_commands;
-    wl_event_source*                 m_eventSource = nullptr;
+    wl_event_source*                 m_eventSource     = nullptr;
+    wl_event_source*                 m_logFollowSource = nullptr;
     std::string                      m_socketPath;
+
+    std::vector<SP<SClient>>         m_clients;
+    SP<CEventLoopTimer>              m_clientTimeoutTimer;
 };
 
 inline UP<CHyprCtl> g_pHyprCtl;
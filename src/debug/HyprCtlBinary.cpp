@@ -0,0 +1,90 @@
+#include "HyprCtlBinary.hpp"
+#include "../macros.hpp"
+
+#include <bit>
+#include <cstring>
+
+using namespace HyprCtl;
+
+constexpr size_t HEADER_LENGTH_OFFSET = 4;
+constexpr size_t HEADER_COUNT_OFFSET  = 9;
+constexpr size_t HEADER_SIZE          = 13;
+
+void CBinaryWriter::begin(eKind kind) {
+    m_buffer.clear();
+    m_recordStarts.clear();
+    m_topLevelRecords = 0;
+
+    m_buffer += "HYB";
+    writeU8(VERSION);
+    writeU32(0); // length, patched in finish()
+    writeU8(kind);
+    writeU32(0); // count, patched in finish()
+}
+
+std::string CBinaryWriter::finish() {
+    ASSERT(m_recordStarts.empty());
+    ASSERT(m_buffer.size() >= HEADER_SIZE);
+
+    patchU32(HEADER_LENGTH_OFFSET, m_buffer.size() - HEADER_LENGTH_OFFSET - sizeof(uint32_t));
+    patchU32(HEADER_COUNT_OFFSET, m_topLevelRecords);
+
+    // copy out so m_buffer keeps its capacity for the next reply
+    return m_buffer;
+}
+
+void CBinaryWriter::beginRecord() {
+    if (m_recordStarts.empty())
+        m_topLevelRecords++;
+
+    m_recordStarts.emplace_back(m_buffer.size());
+    writeU32(0); // length, patched in endRecord()
+}
+
+void CBinaryWriter::endRecord() {
+    ASSERT(!m_recordStarts.empty());
+
+    const auto START = m_recordStarts.back();
+    m_recordStarts.pop_back();
+
+    patchU32(START, m_buffer.size() - START - sizeof(uint32_t));
+}
+
+void CBinaryWriter::writeBool(bool v) {
+    writeU8(v ? 1 : 0);
+}
+
+void CBinaryWriter::writeU8(uint8_t v) {
+    m_buffer += sc<char>(v);
+}
+
+void CBinaryWriter::writeI32(int32_t v) {
+    writeLE(sc<uint32_t>(v));
+}
+
+void CBinaryWriter::writeU32(uint32_t v) {
+    writeLE(v);
+}
+
+void CBinaryWriter::writeI64(int64_t v) {
+    writeLE(sc<uint64_t>(v));
+}
+
+void CBinaryWriter::writeU64(uint64_t v) {
+    writeLE(v);
+}
+
+void CBinaryWriter::writeF32(float v) {
+    writeLE(std::bit_cast<uint32_t>(v));
+}
+
+void CBinaryWriter::writeString(std::string_view v) {
+    writeU32(v.size());
+    m_buffer.append(v);
+}
+
+void CBinaryWriter::patchU32(size_t offset, uint32_t v) {
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        m_buffer[offset + i] = sc<char>((v >> (i * 8)) & 0xFF);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../helpers/memory/Memory.hpp"
+
+/*
+    Compact binary encoding for hyprctl replies, requested with the 'b' flag (e.g. "b/clients").
+
+    All integers are little-endian. A reply is laid out as:
+        char[4] magic    "HYB" followed by the schema version byte
+        u32     length   of everything after this field
+        u8      kind     see eKind
+        u32     count    of top-level records
+        records...
+
+    Every record is prefixed with its own u32 byte length, so clients can skip records
+    and ignore fields appended to the end of a record by newer schema versions.
+    Strings are a u32 byte length followed by the (non-terminated) UTF-8 bytes, lists
+    are a u32 element count followed by the elements. The fields of each record kind
+    are documented where they're written, in HyprCtl.cpp.
+*/
+namespace HyprCtl {
+    class CBinaryWriter {
+      public:
+        enum eKind : uint8_t {
+            KIND_CLIENTS = 1,
+            KIND_WORKSPACES,
+            KIND_MONITORS,
+            KIND_LAYERS,
+            KIND_ACTIVEWINDOW,
+            KIND_ACTIVEWORKSPACE,
+        };
+
+        static constexpr uint8_t VERSION = 1;
+
+        // resets the writer. The underlying buffer is kept around to avoid reallocating.
+        void        begin(eKind kind);
+        // patches the header and returns the encoded reply
+        std::string finish();
+
+        void        beginRecord();
+        void        endRecord();
+
+        void        writeBool(bool v);
+        void        writeU8(uint8_t v);
+        void        writeI32(int32_t v);
+        void        writeU32(uint32_t v);
+        void        writeI64(int64_t v);
+        void        writeU64(uint64_t v);
+        void        writeF32(float v);
+        void        writeString(std::string_view v);
+
+      private:
+        template <typename T>
+        void writeLE(T v) {
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                m_buffer += sc<char>((v >> (i * 8)) & 0xFF);
+            }
+        }
+
+        void                patchU32(size_t offset, uint32_t v);
+
+        std::string         m_buffer;
+        std::vector<size_t> m_recordStarts;
+        uint32_t            m_topLevelRecords = 0;
+    };
+};
@@ -22,6 +22,12 @@ void CHyprMonitorDebugOverlay::renderData(PHLMONITOR pMonitor, float durationUs)
     if (m_lastRenderTimes.size() > sc<long unsigned int>(pMonitor->m_refreshRate))
         m_lastRenderTimes.pop_front();
 
+    // the pass of this monitor was the last one rendered
+    m_lastPassStats.emplace_back(g_pHyprRenderer->m_renderPass.stats());
+
+    if (m_lastPassStats.size() > sc<long unsigned int>(pMonitor->m_refreshRate))
+        m_lastPassStats.pop_front();
+
     if (!m_monitor)
         m_monitor = pMonitor;
 }
@@ -125,6 +131,19 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     float varAnimMgrTick = maxAnimMgrTick - minAnimMgrTick;
     avgAnimMgrTick /= m_lastAnimationTicks.empty() ? 1 : m_lastAnimationTicks.size();
 
+    float avgPassElements = 0, avgPassDiscarded = 0, avgPassRegionOps = 0, avgPassPlanning = 0;
+    for (auto const& ps : m_lastPassStats) {
+        avgPassElements += ps.elements;
+        avgPassDiscarded += ps.discarded;
+        avgPassRegionOps += ps.regionOps;
+        avgPassPlanning += ps.planningUs;
+    }
+    const float PASSSTATSN = m_lastPassStats.empty() ? 1 : m_lastPassStats.size();
+    avgPassElements /= PASSSTATSN;
+    avgPassDiscarded /= PASSSTATSN;
+    avgPassRegionOps /= PASSSTATSN;
+    avgPassPlanning /= PASSSTATSN;
+
     const float           FPS      = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
     const float           idealFPS = m_lastFrametimes.size();
 
@@ -193,6 +212,10 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     text = std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0));
     showText(text.c_str(), 10);
 
+    text = std::format("Avg Pass: {:.1f} elements, {:.1f} discarded, {:.1f} region ops, {:.3f}ms planning", avgPassElements, avgPassDiscarded, avgPassRegionOps,
+                       avgPassPlanning / 1000.F);
+    showText(text.c_str(), 10);
+
     pango_font_description_free(pangoFD);
     g_object_unref(layoutText);
 
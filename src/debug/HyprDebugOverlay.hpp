@@ -2,6 +2,7 @@
 
 #include "../defines.hpp"
 #include "../render/Texture.hpp"
+#include "../render/pass/Pass.hpp"
 #include <cairo/cairo.h>
 #include <map>
 #include <deque>
@@ -21,6 +22,7 @@ class CHyprMonitorDebugOverlay {
     std::deque<float>                              m_lastRenderTimes;
     std::deque<float>                              m_lastRenderTimesNoOverlay;
     std::deque<float>                              m_lastAnimationTicks;
+    std::deque<CRenderPass::SPassStats>            m_lastPassStats;
     std::chrono::high_resolution_clock::time_point m_lastFrame;
     PHLMONITORREF                                  m_monitor;
     CBox                                           m_lastDrawnBox;
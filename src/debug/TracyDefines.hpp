@@ -23,4 +23,18 @@ inline PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64v;
 #define TRACY_GPU_ZONE(e)
 #define TRACY_GPU_COLLECT
 
-#endif
\ No newline at end of file
+#endif
+
+#ifdef TRACY_ENABLE
+
+#include "../../subprojects/tracy/public/tracy/Tracy.hpp"
+
+#define TRACY_CPU_ZONE(e) ZoneScopedN(e)
+#define TRACY_FRAME_MARK  FrameMark
+
+#else
+
+#define TRACY_CPU_ZONE(e)
+#define TRACY_FRAME_MARK
+
+#endif
@@ -23,8 +23,7 @@ void CLogger::log(Hyprutils::CLI::eLogLevel level, const std::string_view& str)
     if (level == Hyprutils::CLI::LOG_TRACE && !TRACE)
         return;
 
-    if (SRollingLogFollow::get().isRunning())
-        SRollingLogFollow::get().addLog(str);
+    CRollingLogFollow::get().addLog(str);
 
     m_logger.log(level, str);
 }
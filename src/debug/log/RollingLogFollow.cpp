@@ -0,0 +1,129 @@
+#include "RollingLogFollow.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <thread>
+#include <sys/eventfd.h>
+
+using namespace Log;
+using namespace Hyprutils::OS;
+
+constexpr size_t FOLLOW_RING_SIZE = 1024 * 1024;
+
+CLogRing::CLogRing(size_t capacity) : m_data(std::bit_ceil(std::max<size_t>(capacity, 2))) {
+    m_mask = m_data.size() - 1;
+}
+
+void CLogRing::push(std::string_view line) {
+    line = line.substr(0, m_data.size() / 2);
+
+    const uint64_t LEN   = line.size() + 1;
+    const uint64_t START = m_reserved.fetch_add(LEN, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        m_data[(START + i) & m_mask] = line[i];
+    }
+    m_data[(START + line.size()) & m_mask] = '\n';
+
+    // whoever reserved before us has to publish first
+    while (m_published.load(std::memory_order_acquire) != START) {
+        std::this_thread::yield();
+    }
+
+    m_published.store(START + LEN, std::memory_order_release);
+}
+
+uint64_t CLogRing::end() const {
+    return m_published.load(std::memory_order_acquire);
+}
+
+size_t CLogRing::read(uint64_t& cursor, std::string& out, size_t max) const {
+    const auto CAPACITY = m_data.size();
+    const auto OLD_SIZE = out.size();
+    size_t     lost     = 0;
+
+    while (true) {
+        const auto END = end();
+
+        if (END - cursor > CAPACITY) {
+            lost += END - CAPACITY - cursor;
+            cursor = END - CAPACITY;
+        }
+
+        const auto LEN = std::min<uint64_t>(END - cursor, max);
+
+        for (uint64_t i = 0; i < LEN; ++i) {
+            out += m_data[(cursor + i) & m_mask];
+        }
+
+        // a writer might've lapped us while we were copying, in which case the start is garbage
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto RESERVED = m_reserved.load(std::memory_order_relaxed);
+
+        if (RESERVED - cursor <= CAPACITY) {
+            cursor += LEN;
+            return lost;
+        }
+
+        out.resize(OLD_SIZE);
+        lost += RESERVED - CAPACITY - cursor;
+        cursor = RESERVED - CAPACITY;
+    }
+}
+
+CRollingLogFollow::CRollingLogFollow() : m_wakeFD(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+    ;
+}
+
+CRollingLogFollow& CRollingLogFollow::get() {
+    static CRollingLogFollow instance;
+    return instance;
+}
+
+void CRollingLogFollow::addLog(std::string_view log) {
+    if (m_followers.load(std::memory_order_acquire) == 0)
+        return;
+
+    m_ring->push(log);
+
+    // one wakeup per batch, not per line
+    if (!m_wakePending.exchange(true, std::memory_order_acq_rel) && m_wakeFD.isValid())
+        eventfd_write(m_wakeFD.get(), 1);
+}
+
+uint64_t CRollingLogFollow::startFollower() {
+    // never freed, other threads may still be pushing after the last follower leaves
+    if (!m_ring)
+        m_ring = makeUnique<CLogRing>(FOLLOW_RING_SIZE);
+
+    m_followers.fetch_add(1, std::memory_order_release);
+
+    return m_ring->end();
+}
+
+void CRollingLogFollow::stopFollower() {
+    m_followers.fetch_sub(1, std::memory_order_release);
+}
+
+size_t CRollingLogFollow::read(uint64_t& cursor, std::string& out, size_t max) {
+    return m_ring ? m_ring->read(cursor, out, max) : 0;
+}
+
+int CRollingLogFollow::wakeFD() {
+    return m_wakeFD.get();
+}
+
+void CRollingLogFollow::ackWake() {
+    // drain first: a line logged in between sees the flag still set and doesn't write, but it's
+    // served anyway since followers are read after this. The other way around, its write could
+    // be drained while the flag stays set, and nothing would ever wake us again.
+    eventfd_t value = 0;
+    eventfd_read(m_wakeFD.get(), &value);
+
+    m_wakePending.store(false, std::memory_order_release);
+}
+
+std::string CRollingLogFollow::debugInfo() {
+    return std::format("RollingLogFollow, got {} connections", m_followers.load());
+}
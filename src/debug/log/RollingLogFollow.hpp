@@ -1,70 +1,70 @@
 #pragma once
 
-#include <shared_mutex>
-#include <unordered_map>
-#include <format>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include <hyprutils/os/FileDescriptor.hpp>
+
+#include "../../helpers/memory/Memory.hpp"
+
 namespace Log {
-    struct SRollingLogFollow {
-        std::unordered_map<int, std::string> m_socketToRollingLogFollowQueue;
-        std::shared_mutex                    m_mutex;
-        bool                                 m_running                  = false;
-        static constexpr size_t              ROLLING_LOG_FOLLOW_TOO_BIG = 8192;
+    /*
+        Fixed size ring of log text. Writers never block on readers: each reader keeps its own cursor
+        (an absolute byte offset) and if it falls more than a ring behind, it's told how much it lost.
+        Writers reserve their range with a single fetch_add, and only wait for each other when two
+        threads log at the very same time, so that lines get published in order.
+    */
+    class CLogRing {
+      public:
+        // capacity is rounded up to a power of two
+        explicit CLogRing(size_t capacity);
 
-        // Returns true if the queue is empty for the given socket
-        bool isEmpty(int socket) {
-            std::shared_lock<std::shared_mutex> r(m_mutex);
-            return m_socketToRollingLogFollowQueue[socket].empty();
-        }
+        // appends the line and a '\n'. Lines longer than half the ring are cut.
+        void push(std::string_view line);
 
-        std::string debugInfo() {
-            std::shared_lock<std::shared_mutex> r(m_mutex);
-            return std::format("RollingLogFollow, got {} connections", m_socketToRollingLogFollowQueue.size());
-        }
+        // offset right past the last published byte
+        uint64_t end() const;
 
-        std::string getLog(int socket) {
-            std::unique_lock<std::shared_mutex> w(m_mutex);
+        // appends up to max bytes from cursor to out and moves the cursor past them.
+        // Returns how many bytes were overwritten before this reader got to them.
+        size_t read(uint64_t& cursor, std::string& out, size_t max) const;
+
+      private:
+        std::vector<char>     m_data;
+        uint64_t              m_mask      = 0;
+        std::atomic<uint64_t> m_reserved  = 0;
+        std::atomic<uint64_t> m_published = 0;
+    };
 
-            const std::string                   ret = m_socketToRollingLogFollowQueue[socket];
-            m_socketToRollingLogFollowQueue[socket] = "";
+    /*
+        Feeds `hyprctl rollinglog -f`. Any thread may add logs, followers are read on the main thread
+        by hyprctl, which polls wakeFD() to learn there's something new.
+    */
+    class CRollingLogFollow {
+      public:
+        static CRollingLogFollow& get();
 
-            return ret;
-        };
+        void                      addLog(std::string_view log);
 
-        void addLog(const std::string_view& log) {
-            std::unique_lock<std::shared_mutex> w(m_mutex);
-            m_running = true;
-            std::vector<int> to_erase;
-            for (const auto& p : m_socketToRollingLogFollowQueue) {
-                m_socketToRollingLogFollowQueue[p.first] += log;
-                m_socketToRollingLogFollowQueue[p.first] += "\n";
-            }
-        }
+        // returns the new follower's cursor, at the current end of the log
+        uint64_t    startFollower();
+        void        stopFollower();
+        size_t      read(uint64_t& cursor, std::string& out, size_t max);
 
-        bool isRunning() {
-            std::shared_lock<std::shared_mutex> r(m_mutex);
-            return m_running;
-        }
+        int         wakeFD();
+        void        ackWake();
 
-        void stopFor(int socket) {
-            std::unique_lock<std::shared_mutex> w(m_mutex);
-            m_socketToRollingLogFollowQueue.erase(socket);
-            if (m_socketToRollingLogFollowQueue.empty())
-                m_running = false;
-        }
+        std::string debugInfo();
 
-        void startFor(int socket) {
-            std::unique_lock<std::shared_mutex> w(m_mutex);
-            m_socketToRollingLogFollowQueue[socket] = std::format("[LOG] Following log to socket: {} started\n", socket);
-            m_running                               = true;
-        }
+      private:
+        CRollingLogFollow();
 
-        static SRollingLogFollow& get() {
-            static SRollingLogFollow    instance;
-            static std::mutex           gm;
-            std::lock_guard<std::mutex> lock(gm);
-            return instance;
-        };
+        UP<CLogRing>                   m_ring;
+        std::atomic<size_t>            m_followers   = 0;
+        std::atomic<bool>              m_wakePending = false;
+        Hyprutils::OS::CFileDescriptor m_wakeFD;
     };
 }
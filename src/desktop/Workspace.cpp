@@ -384,8 +384,9 @@ MONITORID CWorkspace::monitorID() {
 }
 
 PHLWINDOW CWorkspace::getFullscreenWindow() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace == m_self && w->isFullscreen())
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (w && w->m_workspace == m_self && w->isFullscreen())
             return w;
     }
 
@@ -406,8 +407,9 @@ bool CWorkspace::isVisibleNotCovered() {
 
 int CWorkspace::getWindows(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->workspaceID() != m_id || !w->m_isMapped)
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (!w || w->workspaceID() != m_id || !w->m_isMapped)
             continue;
         if (onlyTiled.has_value() && w->m_isFloating == onlyTiled.value())
             continue;
@@ -423,8 +425,9 @@ int CWorkspace::getWindows(std::optional<bool> onlyTiled, std::optional<bool> on
 
 int CWorkspace::getGroups(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->workspaceID() != m_id || !w->m_isMapped)
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (!w || w->workspaceID() != m_id || !w->m_isMapped)
             continue;
         if (!w->m_groupData.head)
             continue;
@@ -440,8 +443,9 @@ int CWorkspace::getGroups(std::optional<bool> onlyTiled, std::optional<bool> onl
 }
 
 PHLWINDOW CWorkspace::getFirstWindow() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace == m_self && w->m_isMapped && !w->isHidden())
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (w && w->m_workspace == m_self && w->m_isMapped && !w->isHidden())
             return w;
     }
 
@@ -451,8 +455,9 @@ PHLWINDOW CWorkspace::getFirstWindow() {
 PHLWINDOW CWorkspace::getTopLeftWindow() {
     const auto PMONITOR = m_monitor.lock();
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (!w || w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
             continue;
 
         const auto WINDOWIDEALBB = w->getWindowIdealBoundingBoxIgnoreReserved();
@@ -464,12 +469,19 @@ PHLWINDOW CWorkspace::getTopLeftWindow() {
 }
 
 bool CWorkspace::hasUrgentWindow() {
-    return std::ranges::any_of(g_pCompositor->m_windows, [this](const auto& w) { return w->m_workspace == m_self && w->m_isMapped && w->m_isUrgent; });
+    return std::ranges::any_of(g_pCompositor->windowsOnWorkspace(m_id), [this](const auto& e) {
+        const auto w = e.window.lock();
+        return w && w->m_workspace == m_self && w->m_isMapped && w->m_isUrgent;
+    });
 }
 
 void CWorkspace::updateWindowDecos() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self)
+    // a copy, updating decorations can end up looking windows up again
+    const auto WINDOWS = g_pCompositor->windowsOnWorkspace(m_id);
+
+    for (auto const& e : WINDOWS) {
+        const auto w = e.window.lock();
+        if (!w || w->m_workspace != m_self)
             continue;
 
         w->updateWindowDecos();
@@ -488,8 +500,9 @@ void CWorkspace::updateWindowData() {
 }
 
 void CWorkspace::forceReportSizesToWindows() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
+    for (auto const& e : g_pCompositor->windowsOnWorkspace(m_id)) {
+        const auto w = e.window.lock();
+        if (!w || w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
             continue;
 
         w->sendWindowSize(true);
@@ -514,7 +527,10 @@ void CWorkspace::rename(const std::string& name) {
 }
 
 void CWorkspace::updateWindows() {
-    m_hasFullscreenWindow = std::ranges::any_of(g_pCompositor->m_windows, [this](const auto& w) { return w->m_isMapped && w->m_workspace == m_self && w->isFullscreen(); });
+    m_hasFullscreenWindow = std::ranges::any_of(g_pCompositor->windowsOnWorkspace(m_id), [this](const auto& e) {
+        const auto w = e.window.lock();
+        return w && w->m_isMapped && w->m_workspace == m_self && w->isFullscreen();
+    });
 
     for (auto const& w : g_pCompositor->m_windows) {
         if (!w->m_isMapped || w->m_workspace != m_self)
@@ -13,22 +13,26 @@ SP<CRuleEngine> Rule::ruleEngine() {
 
 void CRuleEngine::registerRule(SP<IRule>&& rule) {
     m_rules.emplace_back(std::move(rule));
+    m_indexDirty = true;
 }
 
 void CRuleEngine::unregisterRule(const std::string& name) {
     if (name.empty())
         return;
 
-    std::erase_if(m_rules, [&name](const auto& el) { return el->name() == name; });
+    if (std::erase_if(m_rules, [&name](const auto& el) { return el->name() == name; }) > 0)
+        m_indexDirty = true;
 }
 
 void CRuleEngine::unregisterRule(const SP<IRule>& rule) {
-    std::erase(m_rules, rule);
+    if (std::erase(m_rules, rule) > 0)
+        m_indexDirty = true;
     cleanExecRules();
 }
 
 void CRuleEngine::cleanExecRules() {
-    std::erase_if(m_rules, [](const auto& e) { return e->isExecRule() && e->execExpired(); });
+    if (std::erase_if(m_rules, [](const auto& e) { return e->isExecRule() && e->execExpired(); }) > 0)
+        m_indexDirty = true;
 }
 
 void CRuleEngine::updateAllRules() {
@@ -49,8 +53,18 @@ void CRuleEngine::updateAllRules() {
 
 void CRuleEngine::clearAllRules() {
     std::erase_if(m_rules, [](const auto& e) { return !e->isExecRule() || e->execExpired(); });
+    m_indexDirty = true;
 }
 
 const std::vector<SP<IRule>>& CRuleEngine::rules() {
     return m_rules;
 }
+
+CRuleIndex& CRuleEngine::index() {
+    if (m_indexDirty) {
+        m_index.rebuild(m_rules);
+        m_indexDirty = false;
+    }
+
+    return m_index;
+}
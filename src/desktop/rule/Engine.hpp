@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Rule.hpp"
+#include "RuleIndex.hpp"
 
 namespace Desktop::Rule {
     class CRuleEngine {
@@ -16,8 +17,13 @@ namespace Desktop::Rule {
         void                          clearAllRules();
         const std::vector<SP<IRule>>& rules();
 
+        // rebuilt lazily, indices match rules()
+        CRuleIndex& index();
+
       private:
         std::vector<SP<IRule>> m_rules;
+        CRuleIndex             m_index;
+        bool                   m_indexDirty = true;
     };
 
     SP<CRuleEngine> ruleEngine();
@@ -70,6 +70,8 @@ namespace Desktop::Rule {
         //
         std::unordered_map<eRuleProperty, UP<IMatchEngine>> m_matchEngines;
 
+        friend class CRuleIndex;
+
       private:
         std::underlying_type_t<eRuleProperty> m_mask = 0;
         std::string                           m_name = "";
@@ -0,0 +1,139 @@
+#include "RuleIndex.hpp"
+#include "matchEngine/RegexMatchEngine.hpp"
+#include "../../debug/log/Logger.hpp"
+
+#include <re2/re2.h>
+#include <re2/set.h>
+#include <unordered_map>
+
+using namespace Desktop;
+using namespace Desktop::Rule;
+
+struct CRuleIndex::SPropIndex {
+    // 1 for rules that don't match on this prop, they accept anything
+    std::vector<uint8_t>                                 unconstrained;
+
+    std::unordered_map<std::string, std::vector<size_t>> literals;
+
+    UP<re2::RE2::Set>                                    set;
+    std::vector<size_t>                                  setRules;
+
+    // negative and unindexable patterns, checked one by one
+    std::vector<std::pair<size_t, WP<IRule>>>            fallback;
+};
+
+static bool isLiteral(const std::string& pattern) {
+    return pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+CRuleIndex::CRuleIndex() {
+    for (auto& p : m_props) {
+        p = makeUnique<SPropIndex>();
+    }
+}
+
+CRuleIndex::~CRuleIndex() = default;
+
+void CRuleIndex::rebuild(const std::vector<SP<IRule>>& rules) {
+    static uint64_t nextGeneration = 1;
+
+    m_size       = rules.size();
+    m_generation = nextGeneration++;
+
+    for (size_t propIdx = 0; propIdx < INDEXED_PROPS.size(); ++propIdx) {
+        const auto PROP = INDEXED_PROPS[propIdx];
+        auto&      idx  = *m_props[propIdx];
+
+        idx = {};
+        idx.unconstrained.resize(rules.size(), 1);
+
+        std::vector<std::pair<size_t, std::string>> regexes;
+
+        for (size_t i = 0; i < rules.size(); ++i) {
+            const auto& r = rules[i];
+            if (r->type() != RULE_TYPE_WINDOW)
+                continue;
+
+            const auto IT = r->m_matchEngines.find(PROP);
+            if (IT == r->m_matchEngines.end())
+                continue;
+
+            idx.unconstrained[i] = 0;
+
+            const auto ENGINE = dynamic_cast<CRegexMatchEngine*>(IT->second.get());
+            if (!ENGINE || ENGINE->negative()) {
+                idx.fallback.emplace_back(i, r);
+                continue;
+            }
+
+            if (isLiteral(ENGINE->pattern())) {
+                idx.literals[ENGINE->pattern()].emplace_back(i);
+                continue;
+            }
+
+            regexes.emplace_back(i, ENGINE->pattern());
+        }
+
+        if (regexes.empty())
+            continue;
+
+        // same options as RE2's defaults, anchored on both ends like FullMatch
+        idx.set = makeUnique<re2::RE2::Set>(re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+
+        for (const auto& [i, pattern] : regexes) {
+            std::string err;
+            if (idx.set->Add(pattern, &err) < 0) {
+                // broken regex, leave it to its own engine which will never match it
+                idx.fallback.emplace_back(i, rules[i]);
+                continue;
+            }
+
+            idx.setRules.emplace_back(i);
+        }
+
+        if (!idx.set->Compile()) {
+            Log::logger->log(Log::ERR, "CRuleIndex: failed to compile a set of {} patterns, falling back to matching them one by one", idx.setRules.size());
+
+            for (const auto& i : idx.setRules) {
+                idx.fallback.emplace_back(i, rules[i]);
+            }
+
+            idx.set.reset();
+            idx.setRules.clear();
+        }
+    }
+}
+
+uint64_t CRuleIndex::generation() {
+    return m_generation;
+}
+
+size_t CRuleIndex::size() {
+    return m_size;
+}
+
+void CRuleIndex::match(size_t propIdx, const std::string& value, std::vector<uint8_t>& out) {
+    const auto& IDX = *m_props.at(propIdx);
+
+    out.assign(IDX.unconstrained.begin(), IDX.unconstrained.end());
+
+    if (const auto IT = IDX.literals.find(value); IT != IDX.literals.end()) {
+        for (const auto& i : IT->second) {
+            out[i] = 1;
+        }
+    }
+
+    if (IDX.set && IDX.set->Match(value, &m_setHits)) {
+        for (const auto& hit : m_setHits) {
+            out[IDX.setRules[hit]] = 1;
+        }
+    }
+
+    for (const auto& [i, rule] : IDX.fallback) {
+        const auto RULE = rule.lock();
+        if (!RULE)
+            continue;
+
+        out[i] = RULE->m_matchEngines.at(INDEXED_PROPS[propIdx])->match(value);
+    }
+}
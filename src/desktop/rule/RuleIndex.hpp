@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Rule.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Desktop::Rule {
+
+    /*
+        Prefilter for the regex props of window rules. Per prop, patterns that are plain literals
+        go into a hash map, and the rest are compiled into one RE2::Set, so checking a value against
+        every rule is a lookup plus one scan instead of one regex per rule.
+    */
+    class CRuleIndex {
+      public:
+        CRuleIndex();
+        ~CRuleIndex();
+
+        CRuleIndex(const CRuleIndex&) = delete;
+        CRuleIndex(CRuleIndex&&)      = delete;
+
+        static constexpr std::array<eRuleProperty, 4>          INDEXED_PROPS = {RULE_PROP_CLASS, RULE_PROP_TITLE, RULE_PROP_INITIAL_CLASS, RULE_PROP_INITIAL_TITLE};
+        static constexpr std::underlying_type_t<eRuleProperty> INDEXED_MASK  = RULE_PROP_CLASS | RULE_PROP_TITLE | RULE_PROP_INITIAL_CLASS | RULE_PROP_INITIAL_TITLE;
+
+        void rebuild(const std::vector<SP<IRule>>& rules);
+
+        // bumped on every rebuild, results from an older generation are invalid
+        uint64_t generation();
+        size_t   size();
+
+        // sets out[i] to whether rules[i] accepts value for INDEXED_PROPS[propIdx].
+        // Rules that don't match on that prop always accept.
+        void match(size_t propIdx, const std::string& value, std::vector<uint8_t>& out);
+
+      private:
+        struct SPropIndex;
+
+        std::array<UP<SPropIndex>, INDEXED_PROPS.size()> m_props;
+        std::vector<int>                                 m_setHits;
+        size_t                                           m_size       = 0;
+        uint64_t                                         m_generation = 0;
+    };
+}
@@ -4,6 +4,7 @@
 #include "../../view/LayerSurface.hpp"
 #include "../../types/OverridableVar.hpp"
 #include "../../../helpers/MiscFunctions.hpp"
+#include "../../../debug/FrameProfiler.hpp"
 
 using namespace Desktop;
 using namespace Desktop::Rule;
@@ -105,6 +106,8 @@ void CLayerRuleApplicator::propertiesChanged(std::underlying_type_t<eRulePropert
     if (!m_ls)
         return;
 
+    PROFILER_ZONE(PROFILER_STAGE_RULES, "LayerRules");
+
     resetProps(props);
 
     // FIXME: this will not update properties correctly if we implement dynamic rules for
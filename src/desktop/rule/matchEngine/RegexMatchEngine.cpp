@@ -6,12 +6,21 @@ using namespace Desktop::Rule;
 CRegexMatchEngine::CRegexMatchEngine(const std::string& regex) {
     if (regex.starts_with("negative:")) {
         m_negative = true;
-        m_regex    = makeUnique<re2::RE2>(regex.substr(9));
-        return;
-    }
-    m_regex = makeUnique<re2::RE2>(regex);
+        m_pattern  = regex.substr(9);
+    } else
+        m_pattern = regex;
+
+    m_regex = makeUnique<re2::RE2>(m_pattern);
 }
 
 bool CRegexMatchEngine::match(const std::string& other) {
     return re2::RE2::FullMatch(other, *m_regex) != m_negative;
+}
+
+const std::string& CRegexMatchEngine::pattern() {
+    return m_pattern;
+}
+
+bool CRegexMatchEngine::negative() {
+    return m_negative;
 }
\ No newline at end of file
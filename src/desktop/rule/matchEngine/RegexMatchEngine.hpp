@@ -14,10 +14,14 @@ namespace Desktop::Rule {
         CRegexMatchEngine(const std::string& regex);
         virtual ~CRegexMatchEngine() = default;
 
-        virtual bool match(const std::string& other);
+        virtual bool       match(const std::string& other);
+
+        const std::string& pattern();
+        bool               negative();
 
       private:
         UP<re2::RE2> m_regex;
+        std::string  m_pattern;
         bool         m_negative = false;
     };
 }
\ No newline at end of file
@@ -25,11 +25,14 @@ const std::vector<std::pair<CWindowRule::storageType, std::string>>& CWindowRule
     return m_effects;
 }
 
-bool CWindowRule::matches(PHLWINDOW w, bool allowEnvLookup) {
+bool CWindowRule::matches(PHLWINDOW w, bool allowEnvLookup, std::underlying_type_t<eRuleProperty> skipProps) {
     if (m_matchEngines.empty())
         return false;
 
     for (const auto& [prop, engine] : m_matchEngines) {
+        if (prop & skipProps)
+            continue;
+
         switch (prop) {
             default: {
                 Log::logger->log(Log::TRACE, "CWindowRule::matches: skipping prop entry {}", sc<std::underlying_type_t<eRuleProperty>>(prop));
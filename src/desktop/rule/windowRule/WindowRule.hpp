@@ -26,7 +26,8 @@ namespace Desktop::Rule {
         const std::vector<std::pair<storageType, std::string>>& effects();
         const std::unordered_set<storageType>&                  effectsSet();
 
-        bool                                                    matches(PHLWINDOW w, bool allowEnvLookup = false);
+        // props in skipProps are assumed to match, e.g. because CRuleIndex already checked them
+        bool matches(PHLWINDOW w, bool allowEnvLookup = false, std::underlying_type_t<eRuleProperty> skipProps = RULE_PROP_NONE);
 
       private:
         std::vector<std::pair<storageType, std::string>> m_effects;
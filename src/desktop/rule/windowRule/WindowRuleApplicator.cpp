@@ -6,6 +6,7 @@
 #include "../../types/OverridableVar.hpp"
 #include "../../../managers/LayoutManager.hpp"
 #include "../../../managers/HookSystemManager.hpp"
+#include "../../../debug/FrameProfiler.hpp"
 
 #include <hyprutils/string/String.hpp>
 
@@ -18,6 +19,20 @@ CWindowRuleApplicator::CWindowRuleApplicator(PHLWINDOW w) : m_window(w) {
     ;
 }
 
+static const std::string& indexedValue(PHLWINDOW w, eRuleProperty prop) {
+    switch (prop) {
+        case RULE_PROP_CLASS: return w->m_class;
+        case RULE_PROP_TITLE: return w->m_title;
+        case RULE_PROP_INITIAL_CLASS: return w->m_initialClass;
+        case RULE_PROP_INITIAL_TITLE: return w->m_initialTitle;
+        default: break;
+    }
+
+    static const std::string EMPTY;
+    RASSERT(false, "indexedValue: prop {} is not indexed", sc<std::underlying_type_t<eRuleProperty>>(prop));
+    return EMPTY;
+}
+
 std::unordered_set<CWindowRuleEffectContainer::storageType> CWindowRuleApplicator::resetProps(std::underlying_type_t<eRuleProperty> props, Types::eOverridePriority prio) {
     // TODO: fucking kill me, is there a better way to do this?
 
@@ -600,10 +615,30 @@ void CWindowRuleApplicator::propertiesChanged(std::underlying_type_t<eRuleProper
     if (!m_window || !m_window->m_isMapped || m_window->isHidden())
         return;
 
+    PROFILER_ZONE(PROFILER_STAGE_RULES, "WindowRules");
+
     bool                                                        needsRelayout         = false;
     std::unordered_set<CWindowRuleEffectContainer::storageType> effectsNeedingRecheck = resetProps(props);
 
-    for (const auto& r : ruleEngine()->rules()) {
+    const auto  PWINDOW = m_window.lock();
+    const auto& RULES   = ruleEngine()->rules();
+    auto&       index   = ruleEngine()->index();
+
+    // rescan only the indexed props whose value moved since we last looked
+    for (size_t i = 0; i < CRuleIndex::INDEXED_PROPS.size(); ++i) {
+        const auto& VALUE = indexedValue(PWINDOW, CRuleIndex::INDEXED_PROPS[i]);
+        auto&       cache = m_indexCache[i];
+
+        if (cache.generation == index.generation() && cache.value == VALUE)
+            continue;
+
+        index.match(i, VALUE, cache.accepted);
+        cache.value      = VALUE;
+        cache.generation = index.generation();
+    }
+
+    for (size_t ruleIdx = 0; ruleIdx < RULES.size(); ++ruleIdx) {
+        const auto& r = RULES[ruleIdx];
         if (r->type() != RULE_TYPE_WINDOW)
             continue;
 
@@ -612,7 +647,10 @@ void CWindowRuleApplicator::propertiesChanged(std::underlying_type_t<eRuleProper
         if (!(WR->getPropertiesMask() & props) && !setsIntersect(WR->effectsSet(), effectsNeedingRecheck))
             continue;
 
-        if (!WR->matches(m_window.lock()))
+        if (std::ranges::any_of(m_indexCache, [ruleIdx](const auto& c) { return !c.accepted[ruleIdx]; }))
+            continue;
+
+        if (!WR->matches(PWINDOW, false, CRuleIndex::INDEXED_MASK))
             continue;
 
         const auto RES = applyDynamicRule(WR);
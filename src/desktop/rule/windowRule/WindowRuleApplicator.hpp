@@ -6,6 +6,7 @@
 #include "WindowRuleEffectContainer.hpp"
 #include "../../DesktopTypes.hpp"
 #include "../Rule.hpp"
+#include "../RuleIndex.hpp"
 #include "../../types/OverridableVar.hpp"
 #include "../../../helpers/math/Math.hpp"
 #include "../../../helpers/TagKeeper.hpp"
@@ -141,6 +142,16 @@ namespace Desktop::Rule {
       private:
         PHLWINDOWREF m_window;
 
+        // CRuleIndex results for our last seen value of each indexed prop, so e.g. a title change
+        // doesn't rescan the class patterns
+        struct SIndexCache {
+            uint64_t             generation = 0;
+            std::string          value;
+            std::vector<uint8_t> accepted;
+        };
+
+        std::array<SIndexCache, CRuleIndex::INDEXED_PROPS.size()> m_indexCache;
+
         struct SRuleResult {
             bool needsRelayout = false;
             bool tagsChanged   = false;
@@ -479,7 +479,7 @@ void CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace) {
         m_monitorMovedFrom = OLDWORKSPACE ? OLDWORKSPACE->monitorID() : -1;
     }
 
-    m_workspace = pWorkspace;
+    setWorkspace(pWorkspace);
 
     setAnimationsToMove();
 
@@ -582,7 +582,7 @@ void CWindow::onUnmap() {
     g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
-    m_workspace.reset();
+    setWorkspace(nullptr);
 
     if (m_isX11)
         return;
@@ -1221,6 +1221,14 @@ bool CWindow::isEffectiveInternalFSMode(const eFullscreenMode MODE) const {
     return sc<eFullscreenMode>(std::bit_floor(sc<uint8_t>(m_fullscreenState.internal))) == MODE;
 }
 
+void CWindow::setWorkspace(PHLWORKSPACE pWorkspace) {
+    if (m_workspace == pWorkspace)
+        return;
+
+    m_workspace = pWorkspace;
+    g_pCompositor->invalidateWindowIndex();
+}
+
 WORKSPACEID CWindow::workspaceID() {
     return m_workspace ? m_workspace->m_id : m_lastWorkspace;
 }
@@ -1491,7 +1499,7 @@ void CWindow::onX11ConfigureRequest(CBox box) {
     if (!m_workspace || !m_workspace->isVisible())
         return; // further things are only for visible windows
 
-    m_workspace = g_pCompositor->getMonitorFromVector(m_realPosition->goal() + m_realSize->goal() / 2.f)->m_activeWorkspace;
+    setWorkspace(g_pCompositor->getMonitorFromVector(m_realPosition->goal() + m_realSize->goal() / 2.f)->m_activeWorkspace);
 
     g_pCompositor->changeWindowZOrder(m_self.lock(), true);
 
@@ -1516,9 +1524,22 @@ PHLWINDOW CWindow::getSwallower() {
     static auto PSWALLOWEXREGEX = CConfigValue<std::string>("misc:swallow_exception_regex");
     static auto PSWALLOW        = CConfigValue<Hyprlang::INT>("misc:enable_swallow");
 
-    if (!*PSWALLOW || std::string{*PSWALLOWREGEX} == STRVAL_EMPTY || (*PSWALLOWREGEX).empty())
+    if (!*PSWALLOW || PSWALLOWREGEX.view() == STRVAL_EMPTY || PSWALLOWREGEX.view().empty())
         return nullptr;
 
+    // compiled once per change of the patterns, not once per candidate
+    static UP<RE2>    swallowRegex, swallowExRegex;
+    static const auto REGEXSUBSCRIPTION = g_pConfigManager->subscribe({"misc:swallow_regex", "misc:swallow_exception_regex"}, [] {
+        swallowRegex.reset();
+        swallowExRegex.reset();
+    });
+
+    if (!swallowRegex) {
+        swallowRegex = makeUnique<RE2>(PSWALLOWREGEX.view());
+        if (!PSWALLOWEXREGEX.view().empty())
+            swallowExRegex = makeUnique<RE2>(PSWALLOWEXREGEX.view());
+    }
+
     // check parent
     std::vector<PHLWINDOW> candidates;
     pid_t                  currentPid = getPID();
@@ -1538,14 +1559,13 @@ PHLWINDOW CWindow::getSwallower() {
         }
     }
 
-    if (!(*PSWALLOWREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return !RE2::FullMatch(other->m_class, *PSWALLOWREGEX); });
+    std::erase_if(candidates, [&](const auto& other) { return !RE2::FullMatch(other->m_class, *swallowRegex); });
 
     if (candidates.empty())
         return nullptr;
 
-    if (!(*PSWALLOWEXREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return RE2::FullMatch(other->m_title, *PSWALLOWEXREGEX); });
+    if (swallowExRegex)
+        std::erase_if(candidates, [&](const auto& other) { return RE2::FullMatch(other->m_title, *swallowExRegex); });
 
     if (candidates.empty())
         return nullptr;
@@ -1851,32 +1871,78 @@ void CWindow::updateDecorationValues() {
     updateWindowDecos();
 }
 
-std::optional<double> CWindow::calculateSingleExpr(const std::string& s) {
-    const auto        PMONITOR     = m_monitor ? m_monitor : Desktop::focusState()->monitor();
-    const auto        CURSOR_LOCAL = g_pInputManager->getMouseCoordsInternal() - (PMONITOR ? PMONITOR->m_position : Vector2D{});
+// size / move rule expressions, compiled once per expression string. They all read their
+// variables from ruleExprVars, which calculateExpression fills in before evaluating.
+static struct {
+    double windowW  = 0;
+    double windowH  = 0;
+    double windowX  = 0;
+    double windowY  = 0;
+    double monitorW = 0;
+    double monitorH = 0;
+    double cursorX  = 0;
+    double cursorY  = 0;
+} ruleExprVars;
+
+struct SCompiledRuleExpr {
+    UP<Math::CExpression> x, y; // null if it didn't compile
+};
 
-    Math::CExpression expr;
-    expr.addVariable("window_w", m_realSize->goal().x);
-    expr.addVariable("window_h", m_realSize->goal().y);
-    expr.addVariable("window_x", m_realPosition->goal().x - (PMONITOR ? PMONITOR->m_position.x : 0));
-    expr.addVariable("window_y", m_realPosition->goal().y - (PMONITOR ? PMONITOR->m_position.y : 0));
+static std::unordered_map<std::string, SCompiledRuleExpr> ruleExprCache;
 
-    expr.addVariable("monitor_w", PMONITOR ? PMONITOR->m_size.x : 1920);
-    expr.addVariable("monitor_h", PMONITOR ? PMONITOR->m_size.y : 1080);
+static UP<Math::CExpression> compileRuleExpr(const std::string& s) {
+    auto expr = makeUnique<Math::CExpression>();
+    expr->bindVariable("window_w", &ruleExprVars.windowW);
+    expr->bindVariable("window_h", &ruleExprVars.windowH);
+    expr->bindVariable("window_x", &ruleExprVars.windowX);
+    expr->bindVariable("window_y", &ruleExprVars.windowY);
 
-    expr.addVariable("cursor_x", CURSOR_LOCAL.x);
-    expr.addVariable("cursor_y", CURSOR_LOCAL.y);
+    expr->bindVariable("monitor_w", &ruleExprVars.monitorW);
+    expr->bindVariable("monitor_h", &ruleExprVars.monitorH);
 
-    return expr.compute(s);
+    expr->bindVariable("cursor_x", &ruleExprVars.cursorX);
+    expr->bindVariable("cursor_y", &ruleExprVars.cursorY);
+
+    if (!expr->compile(s))
+        return nullptr;
+
+    return expr;
 }
 
 std::optional<Vector2D> CWindow::calculateExpression(const std::string& s) {
-    auto spacePos = s.find(' ');
-    if (spacePos == std::string::npos)
+    // rules come from the config and setprop, this only guards against something generating them
+    constexpr size_t MAX_CACHED_EXPRS = 256;
+
+    auto             it = ruleExprCache.find(s);
+    if (it == ruleExprCache.end()) {
+        auto spacePos = s.find(' ');
+        if (spacePos == std::string::npos)
+            return std::nullopt;
+
+        if (ruleExprCache.size() >= MAX_CACHED_EXPRS)
+            ruleExprCache.clear();
+
+        it = ruleExprCache.emplace(s, SCompiledRuleExpr{.x = compileRuleExpr(s.substr(0, spacePos)), .y = compileRuleExpr(s.substr(spacePos + 1))}).first;
+    }
+
+    const auto& [X, Y] = it->second;
+    if (!X || !Y)
         return std::nullopt;
 
-    const auto LHS = calculateSingleExpr(s.substr(0, spacePos));
-    const auto RHS = calculateSingleExpr(s.substr(spacePos + 1));
+    const auto PMONITOR     = m_monitor ? m_monitor : Desktop::focusState()->monitor();
+    const auto CURSOR_LOCAL = g_pInputManager->getMouseCoordsInternal() - (PMONITOR ? PMONITOR->m_position : Vector2D{});
+
+    ruleExprVars.windowW  = m_realSize->goal().x;
+    ruleExprVars.windowH  = m_realSize->goal().y;
+    ruleExprVars.windowX  = m_realPosition->goal().x - (PMONITOR ? PMONITOR->m_position.x : 0);
+    ruleExprVars.windowY  = m_realPosition->goal().y - (PMONITOR ? PMONITOR->m_position.y : 0);
+    ruleExprVars.monitorW = PMONITOR ? PMONITOR->m_size.x : 1920;
+    ruleExprVars.monitorH = PMONITOR ? PMONITOR->m_size.y : 1080;
+    ruleExprVars.cursorX  = CURSOR_LOCAL.x;
+    ruleExprVars.cursorY  = CURSOR_LOCAL.y;
+
+    const auto LHS = X->evaluate();
+    const auto RHS = Y->evaluate();
 
     if (!LHS || !RHS)
         return std::nullopt;
@@ -1913,7 +1979,6 @@ void CWindow::mapWindow() {
     }
     auto PWORKSPACE = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
     m_monitor       = PMONITOR;
-    m_workspace     = PWORKSPACE;
     m_isMapped      = true;
     m_readyToDelete = false;
     m_fadingOut     = false;
@@ -1921,6 +1986,7 @@ void CWindow::mapWindow() {
     m_firstMap      = true;
     m_initialTitle  = m_title;
     m_initialClass  = fetchClass();
+    setWorkspace(PWORKSPACE);
 
     // check for token
     std::string requestedWorkspace = "";
@@ -1998,8 +2064,8 @@ void CWindow::mapWindow() {
                         g_pKeybindManager->m_dispatchers["focusmonitor"](std::to_string(monitorID()));
                         PMONITOR = PMONITORFROMID;
                     }
-                    m_workspace = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
-                    PWORKSPACE  = m_workspace;
+                    setWorkspace(PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace);
+                    PWORKSPACE = m_workspace;
 
                     Log::logger->log(Log::DEBUG, "Rule monitor, applying to {:mw}", m_self.lock());
                     requestedFSMonitor = MONITOR_INVALID;
@@ -2143,8 +2209,8 @@ void CWindow::mapWindow() {
 
             PWORKSPACE = pWorkspace;
 
-            m_workspace = pWorkspace;
-            m_monitor   = pWorkspace->m_monitor;
+            setWorkspace(pWorkspace);
+            m_monitor = pWorkspace->m_monitor;
 
             if (m_monitor.lock()->m_activeSpecialWorkspace && !pWorkspace->m_isSpecialWorkspace)
                 workspaceSilent = true;
@@ -2175,8 +2241,8 @@ void CWindow::mapWindow() {
             g_pKeybindManager->m_dispatchers["focusmonitor"](std::to_string(monitorID()));
             PMONITOR = PMONITORFROMID;
         }
-        m_workspace = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
-        PWORKSPACE  = m_workspace;
+        setWorkspace(PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace);
+        PWORKSPACE = m_workspace;
 
         Log::logger->log(Log::DEBUG, "Requested monitor, applying to {:mw}", m_self.lock());
     }
@@ -2680,7 +2746,7 @@ void CWindow::unmanagedSetGeometry() {
         m_position = m_realPosition->goal();
         m_size     = m_realSize->goal();
 
-        m_workspace = g_pCompositor->getMonitorFromVector(m_realPosition->value() + m_realSize->value() / 2.f)->m_activeWorkspace;
+        setWorkspace(g_pCompositor->getMonitorFromVector(m_realPosition->value() + m_realSize->value() / 2.f)->m_activeWorkspace);
 
         g_pCompositor->changeWindowZOrder(m_self.lock(), true);
         updateWindowDecos();
@@ -134,7 +134,7 @@ namespace Desktop::View {
         std::string      m_class           = "";
         std::string      m_initialTitle    = "";
         std::string      m_initialClass    = "";
-        PHLWORKSPACE     m_workspace;
+        PHLWORKSPACE     m_workspace; // change it with setWorkspace(), the compositor indexes windows by it
         PHLMONITORREF    m_monitor;
 
         bool             m_isMapped = false;
@@ -267,6 +267,7 @@ namespace Desktop::View {
         void                       updateToplevel();
         void                       updateSurfaceScaleTransformDetails(bool force = false);
         void                       moveToWorkspace(PHLWORKSPACE);
+        void                       setWorkspace(PHLWORKSPACE);
         PHLWINDOW                  x11TransientFor();
         void                       onUnmap();
         void                       onMap();
@@ -379,13 +380,12 @@ namespace Desktop::View {
         } m_listeners;
 
       private:
-        std::optional<double> calculateSingleExpr(const std::string& s);
-        void                  mapWindow();
-        void                  unmapWindow();
-        void                  commitWindow();
-        void                  destroyWindow();
-        void                  activateX11();
-        void                  unmanagedSetGeometry();
+        void mapWindow();
+        void unmapWindow();
+        void commitWindow();
+        void destroyWindow();
+        void activateX11();
+        void unmanagedSetGeometry();
 
         // For hidden windows and stuff
         bool        m_hidden        = false;
@@ -1,5 +1,7 @@
 #include "DamageRing.hpp"
 
+#include <algorithm>
+
 void CDamageRing::setSize(const Vector2D& size_) {
     if (size_ == m_size)
         return;
@@ -15,6 +17,11 @@ bool CDamageRing::damage(const CRegion& rg) {
         return false;
 
     m_current.add(clipped);
+
+    // busy clients commit a lot of small rects, don't let them pile up over a frame
+    if (pixman_region32_n_rects(m_current.pixman()) > DAMAGE_RING_MAX_RECTS)
+        m_current = m_current.getExtents();
+
     return true;
 }
 
@@ -27,6 +34,8 @@ void CDamageRing::rotate() {
 
     m_previous[m_previousIdx] = m_current;
     m_current.clear();
+
+    ++m_frames;
 }
 
 CRegion CDamageRing::getBufferDamage(int age) {
@@ -41,7 +50,7 @@ CRegion CDamageRing::getBufferDamage(int age) {
     }
 
     // don't return a ludicrous amount of rects
-    if (damage.getRects().size() > 8)
+    if (damage.getRects().size() > DAMAGE_RING_MAX_RECTS)
         return damage.getExtents();
 
     return damage;
@@ -50,3 +59,16 @@ CRegion CDamageRing::getBufferDamage(int age) {
 bool CDamageRing::hasChanged() {
     return !m_current.empty();
 }
+
+uint64_t CDamageRing::frames() {
+    return m_frames;
+}
+
+CRegion CDamageRing::getDamageSince(uint64_t since) {
+    if (since > m_frames)
+        return CBox{{}, m_size};
+
+    // an age past the ring gets the whole thing
+    const int AGE = std::min<uint64_t>(m_frames - since, DAMAGE_RING_PREVIOUS_LEN + 1) + 1;
+    return getBufferDamage(AGE);
+}
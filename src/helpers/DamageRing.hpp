@@ -2,8 +2,11 @@
 
 #include "./math/Math.hpp"
 #include <array>
+#include <cstdint>
 
 constexpr static int DAMAGE_RING_PREVIOUS_LEN = 3;
+// past this many rects, damage is merged into its bounding box. Every rect makes pixman slower, and we'd draw the extents anyway
+constexpr static int DAMAGE_RING_MAX_RECTS = 8;
 
 class CDamageRing {
   public:
@@ -14,9 +17,15 @@ class CDamageRing {
     CRegion getBufferDamage(int age);
     bool    hasChanged();
 
+    // how many times the ring was rotated, i.e. frames rendered
+    uint64_t frames();
+    // everything damaged since frames() returned `since`, including what's pending for the next frame
+    CRegion getDamageSince(uint64_t since);
+
   private:
     Vector2D                                      m_size;
     CRegion                                       m_current;
     std::array<CRegion, DAMAGE_RING_PREVIOUS_LEN> m_previous;
     size_t                                        m_previousIdx = 0;
+    uint64_t                                      m_frames      = 0;
 };
@@ -0,0 +1,271 @@
+#include "Launcher.hpp"
+#include "memory/Memory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <hyprutils/os/FileDescriptor.hpp>
+using namespace Hyprutils::OS;
+
+extern "C" char**        environ;
+
+static NLauncher::SStats spawnStats;
+
+#ifdef __linux__
+// enough for execvpe's PATH walk, and not committed unless touched
+constexpr size_t CHILD_STACK_SIZE = 256 * 1024;
+#endif
+
+struct SChildArgs {
+    char* const*  argv     = nullptr; // exec'd directly if set
+    char* const*  shArgv   = nullptr; // /bin/sh -c fallback if set
+    char* const*  envp     = nullptr;
+    const int*    inherit  = nullptr;
+    size_t        inheritN = 0;
+    const rlimit* nofile   = nullptr;
+    int           devnull  = -1;
+    int           reportFD = -1; // without a shared address space, the child tells us what happened here
+
+    // written by the child, which shares our memory until it execs
+    bool viaShell = false;
+    int  err      = 0;
+};
+
+// On Linux, runs on its own stack in our address space, with our thread blocked until it execs or exits.
+// Elsewhere, runs in a forked child. No allocating, no locks, nothing that isn't async-signal-safe.
+static int childMain(void* data) {
+    auto* args = sc<SChildArgs*>(data);
+
+    // our handlers would run here on shared memory, put everything we catch back to default.
+    // The handler table itself is the child's own copy, we don't clone with CLONE_SIGHAND.
+    struct sigaction act = {};
+    for (int sig = 1; sig < NSIG; ++sig) {
+        if (sigaction(sig, nullptr, &act) < 0 || act.sa_handler == SIG_IGN || act.sa_handler == SIG_DFL)
+            continue;
+
+        act.sa_handler = SIG_DFL;
+        act.sa_flags   = 0;
+        sigemptyset(&act.sa_mask);
+        sigaction(sig, &act, nullptr);
+    }
+
+    if (args->nofile)
+        setrlimit(RLIMIT_NOFILE, args->nofile);
+
+    if (args->devnull >= 0) {
+        dup2(args->devnull, STDOUT_FILENO);
+        dup2(args->devnull, STDERR_FILENO);
+    }
+
+    for (size_t i = 0; i < args->inheritN; ++i) {
+        const int FLAGS = fcntl(args->inherit[i], F_GETFD);
+        if (FLAGS >= 0)
+            fcntl(args->inherit[i], F_SETFD, FLAGS & ~FD_CLOEXEC);
+    }
+
+    sigset_t set;
+    sigemptyset(&set);
+    sigprocmask(SIG_SETMASK, &set, nullptr);
+
+    if (args->argv) {
+#ifdef __linux__
+        execvpe(args->argv[0], args->argv, args->envp);
+#else
+        // our environ is our own copy here
+        environ = const_cast<char**>(args->envp);
+        execvp(args->argv[0], args->argv);
+#endif
+    }
+
+    // not a binary we can find, might be a builtin, let the shell figure it out
+    if (args->shArgv) {
+        args->viaShell = true;
+        if (args->reportFD >= 0)
+            write(args->reportFD, "s", 1);
+        execve("/bin/sh", args->shArgv, args->envp);
+    }
+
+    args->err = errno;
+    if (args->reportFD >= 0) {
+        write(args->reportFD, "e", 1);
+        write(args->reportFD, &args->err, sizeof(args->err));
+    }
+    _exit(127);
+}
+
+static std::vector<char*> pointersTo(std::vector<std::string>& strings) {
+    std::vector<char*> result;
+    result.reserve(strings.size() + 1);
+    for (auto& s : strings) {
+        result.emplace_back(s.data());
+    }
+    result.emplace_back(nullptr);
+    return result;
+}
+
+static std::vector<std::string> buildEnvironment(const std::vector<std::pair<std::string, std::string>>& overrides) {
+    std::vector<std::string> result;
+
+    for (char** e = environ; e && *e; ++e) {
+        const std::string_view ENTRY = *e;
+        const auto             KEY   = ENTRY.substr(0, ENTRY.find('='));
+
+        if (std::ranges::any_of(overrides, [&KEY](const auto& o) { return o.first == KEY; }))
+            continue;
+
+        result.emplace_back(ENTRY);
+    }
+
+    for (const auto& [key, value] : overrides) {
+        result.emplace_back(key + "=" + value);
+    }
+
+    return result;
+}
+
+pid_t NLauncher::spawn(const SSpawnRequest& request) {
+    const auto                              BEGIN = Time::steadyNow();
+
+    std::optional<std::vector<std::string>> direct = request.argv.empty() ? splitSimpleCommand(request.command) : request.argv;
+    std::vector<std::string>                sh     = {"/bin/sh", "-c", request.command};
+    std::vector<std::string>                env    = buildEnvironment(request.env);
+
+    std::vector<char*>                      argvPtrs;
+    std::vector<char*>                      shPtrs  = pointersTo(sh);
+    std::vector<char*>                      envPtrs = pointersTo(env);
+
+    if (direct)
+        argvPtrs = pointersTo(*direct);
+
+    CFileDescriptor devnull;
+    if (request.silence)
+        devnull = CFileDescriptor{open("/dev/null", O_WRONLY | O_CLOEXEC)};
+
+    SChildArgs args = {
+        .argv     = direct ? argvPtrs.data() : nullptr,
+        .shArgv   = request.argv.empty() ? shPtrs.data() : nullptr,
+        .envp     = envPtrs.data(),
+        .inherit  = request.inheritFDs.data(),
+        .inheritN = request.inheritFDs.size(),
+        .nofile   = request.nofile ? &*request.nofile : nullptr,
+        .devnull  = devnull.isValid() ? devnull.get() : -1,
+    };
+
+#ifdef __linux__
+    void* stack = mmap(nullptr, CHILD_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | MAP_NORESERVE, -1, 0);
+    if (stack == MAP_FAILED) {
+        spawnStats.failures++;
+        return -1;
+    }
+
+    // nothing may be delivered to the child before it resets the handlers
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);
+
+    // returns once the child has exec'd or exited
+    pid_t pid = clone(childMain, sc<uint8_t*>(stack) + CHILD_STACK_SIZE, CLONE_VM | CLONE_VFORK | SIGCHLD, &args);
+
+    pthread_sigmask(SIG_SETMASK, &old, nullptr);
+    munmap(stack, CHILD_STACK_SIZE);
+#else
+    // no CLONE_VM here, fork and have the child report back over a pipe that closes when it execs
+    int reportFDs[2];
+    if (pipe2(reportFDs, O_CLOEXEC) < 0) {
+        spawnStats.failures++;
+        return -1;
+    }
+
+    CFileDescriptor reportRead{reportFDs[0]}, reportWrite{reportFDs[1]};
+    args.reportFD = reportWrite.get();
+
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);
+
+    pid_t pid = fork();
+    if (pid == 0)
+        childMain(&args);
+
+    pthread_sigmask(SIG_SETMASK, &old, nullptr);
+    reportWrite.reset();
+
+    std::array<char, 1 + 1 + sizeof(int)> report = {};
+    size_t                                 got    = 0;
+    while (pid > 0 && got < report.size()) {
+        const auto LEN = read(reportRead.get(), report.data() + got, report.size() - got);
+        if (LEN > 0)
+            got += LEN;
+        else if (LEN == 0 || errno != EINTR)
+            break;
+    }
+
+    size_t at = 0;
+    if (at < got && report[at] == 's') {
+        args.viaShell = true;
+        at++;
+    }
+
+    if (at < got && report[at] == 'e' && got - at - 1 >= sizeof(int))
+        memcpy(&args.err, report.data() + at + 1, sizeof(int));
+#endif
+
+    if (pid > 0 && args.err != 0) {
+        // it's exiting already, don't leave a zombie behind if children aren't reaped automatically
+        waitpid(pid, nullptr, 0);
+        errno = args.err;
+        pid   = -1;
+    }
+
+    if (pid < 0) {
+        spawnStats.failures++;
+        return -1;
+    }
+
+    const auto ELAPSED = Time::steadyNow() - BEGIN;
+
+    spawnStats.spawns++;
+    if (!args.viaShell && direct)
+        spawnStats.direct++;
+    spawnStats.last = ELAPSED;
+    spawnStats.max  = std::max(spawnStats.max, ELAPSED);
+    spawnStats.total += ELAPSED;
+
+    return pid;
+}
+
+const NLauncher::SStats& NLauncher::stats() {
+    return spawnStats;
+}
+
+std::optional<std::vector<std::string>> NLauncher::splitSimpleCommand(const std::string& command) {
+    // anything a shell would expand, redirect, quote or treat as a keyword
+    if (command.find_first_of("|&;<>()$`\\\"'*?[]{}#~!\n") != std::string::npos)
+        return std::nullopt;
+
+    std::vector<std::string> result;
+
+    size_t                   pos = 0;
+    while (pos < command.size()) {
+        const auto BEGIN = command.find_first_not_of(" \t", pos);
+        if (BEGIN == std::string::npos)
+            break;
+
+        const auto END = std::min(command.find_first_of(" \t", BEGIN), command.size());
+        result.emplace_back(command.substr(BEGIN, END - BEGIN));
+        pos = END;
+    }
+
+    // FOO=bar cmd sets FOO for cmd
+    if (result.empty() || result.front().contains('='))
+        return std::nullopt;
+
+    return result;
+}
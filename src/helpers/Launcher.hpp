@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include "time/Time.hpp"
+
+/*
+    Starts child processes without fork()ing the compositor. fork() has to copy our page tables,
+    which with a few GB of textures and buffers mapped is slow, and every page we touch afterwards
+    takes a COW fault on the main thread. Instead, on Linux the child borrows our address space
+    (CLONE_VM | CLONE_VFORK, like posix_spawn) until it execs, and everything it needs is
+    prepared up front so it doesn't have to allocate. Elsewhere it's a plain fork, posix_spawn
+    can't restore RLIMIT_NOFILE for the child.
+*/
+namespace NLauncher {
+    struct SSpawnRequest {
+        // either a command for /bin/sh -c, exec'd directly when it has no shell syntax,
+        std::string command;
+        // or an explicit argv, looked up in PATH and never run through a shell
+        std::vector<std::string>                         argv;
+
+        std::vector<std::pair<std::string, std::string>> env;            // set on top of our environment
+        std::vector<int>                                 inheritFDs;     // have CLOEXEC cleared in the child
+        std::optional<rlimit>                            nofile;         // RLIMIT_NOFILE for the child
+        bool                                             silence = true; // stdout and stderr to /dev/null
+    };
+
+    struct SStats {
+        uint64_t         spawns   = 0;
+        uint64_t         direct   = 0; // commands that skipped /bin/sh
+        uint64_t         failures = 0;
+        Time::steady_dur last     = {};
+        Time::steady_dur max      = {};
+        Time::steady_dur total    = {};
+    };
+
+    // returns the pid of the child, or -1 if it couldn't be started
+    pid_t         spawn(const SSpawnRequest& request);
+
+    const SStats& stats();
+
+    // argv for a command that a shell would run as-is, nullopt if it needs a shell
+    std::optional<std::vector<std::string>> splitSimpleCommand(const std::string& command);
+};
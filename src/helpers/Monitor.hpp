@@ -152,6 +152,7 @@ class CMonitor {
 
     bool                        m_ratsScheduled = false;
     CTimer                      m_lastPresentationTimer;
+    Time::steady_tp             m_lastPresentedAt; // from the last present event, epoch if we haven't had one
 
     bool                        m_isBeingLeased = false;
 
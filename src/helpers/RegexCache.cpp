@@ -0,0 +1,29 @@
+#include "RegexCache.hpp"
+
+#include <algorithm>
+
+CRegexCache::CRegexCache(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)) {
+    ;
+}
+
+const re2::RE2& CRegexCache::get(std::string_view pattern) {
+    if (const auto IT = m_byPattern.find(pattern); IT != m_byPattern.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, IT->second);
+        return *IT->second->regex;
+    }
+
+    if (m_lru.size() >= m_capacity) {
+        m_byPattern.erase(m_lru.back().pattern);
+        m_lru.pop_back();
+    }
+
+    auto& entry = m_lru.emplace_front(SEntry{.pattern = std::string{pattern}});
+    entry.regex = makeUnique<re2::RE2>(entry.pattern);
+    m_byPattern.emplace(entry.pattern, m_lru.begin());
+
+    return *entry.regex;
+}
+
+size_t CRegexCache::size() const {
+    return m_lru.size();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <re2/re2.h>
+
+#include "memory/Memory.hpp"
+
+// Compiled patterns for selectors that arrive as strings (dispatchers, hyprctl),
+// so that the same selector isn't compiled again for every window and every call.
+class CRegexCache {
+  public:
+    explicit CRegexCache(size_t capacity);
+
+    // compiles on a miss. The reference is valid until the next get().
+    const re2::RE2& get(std::string_view pattern);
+    size_t          size() const;
+
+  private:
+    struct SEntry {
+        std::string  pattern;
+        UP<re2::RE2> regex;
+    };
+
+    size_t                                                          m_capacity = 0;
+    std::list<SEntry>                                               m_lru;       // most recently used first
+    std::unordered_map<std::string_view, decltype(m_lru)::iterator> m_byPattern; // views the patterns in m_lru
+};
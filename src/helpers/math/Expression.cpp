@@ -20,3 +20,26 @@ std::optional<double> CExpression::compute(const std::string& expr) {
 
     return std::nullopt;
 }
+
+void CExpression::bindVariable(const std::string& name, double* val) {
+    m_parser->DefineVar(name, val);
+}
+
+bool CExpression::compile(const std::string& expr) {
+    try {
+        m_parser->SetExpr(expr);
+        // the first Eval parses, and throws for anything SetExpr doesn't catch, like unknown names
+        m_parser->Eval();
+        return true;
+    } catch (mu::Parser::exception_type& e) { Log::logger->log(Log::ERR, "CExpression::compile: mu threw: {}", e.GetMsg()); }
+
+    return false;
+}
+
+std::optional<double> CExpression::evaluate() {
+    try {
+        return m_parser->Eval();
+    } catch (mu::Parser::exception_type& e) { Log::logger->log(Log::ERR, "CExpression::evaluate: mu threw: {}", e.GetMsg()); }
+
+    return std::nullopt;
+}
@@ -22,6 +22,12 @@ namespace Math {
 
         std::optional<double> compute(const std::string& expr);
 
+        // For expressions evaluated over and over: bound variables are read through the pointer on
+        // every evaluate(), so the expression is parsed once in compile() and evaluating it doesn't allocate.
+        void                  bindVariable(const std::string& name, double* val);
+        bool                  compile(const std::string& expr);
+        std::optional<double> evaluate();
+
       private:
         UP<mu::Parser> m_parser;
     };
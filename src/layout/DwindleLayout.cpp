@@ -8,6 +8,7 @@
 #include "../managers/LayoutManager.hpp"
 #include "../managers/EventManager.hpp"
 #include "../desktop/state/FocusState.hpp"
+#include "../debug/FrameProfiler.hpp"
 #include "xwayland/XWayland.hpp"
 
 void SDwindleNodeData::recalcSizePosRecursive(bool force, bool horizontalOverride, bool verticalOverride) {
@@ -534,6 +535,8 @@ void CHyprDwindleLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
 }
 
 void CHyprDwindleLayout::recalculateMonitor(const MONITORID& monid) {
+    PROFILER_ZONE(PROFILER_STAGE_LAYOUT, "RecalculateMonitor", monid);
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(monid);
 
     if (!PMONITOR || !PMONITOR->m_activeWorkspace)
@@ -956,7 +959,10 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_monitor, pWindow->m_monitor);
-        std::swap(pWindow2->m_workspace, pWindow->m_workspace);
+
+        const auto WORKSPACE1 = pWindow->m_workspace;
+        pWindow->setWorkspace(pWindow2->m_workspace);
+        pWindow2->setWorkspace(WORKSPACE1);
     }
 
     pWindow->setAnimationsToMove();
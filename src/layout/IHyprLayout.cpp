@@ -173,9 +173,9 @@ void IHyprLayout::onWindowCreatedFloating(PHLWINDOW pWindow) {
             if (!pWindow->m_isX11) {
                 if (const auto PARENT = pWindow->parent(); PARENT) {
                     *pWindow->m_realPosition = PARENT->m_realPosition->goal() + PARENT->m_realSize->goal() / 2.F - desiredGeometry.size() / 2.F;
-                    pWindow->m_workspace     = PARENT->m_workspace;
                     pWindow->m_monitor       = PARENT->m_monitor;
                     centeredOnParent         = true;
+                    pWindow->setWorkspace(PARENT->m_workspace);
                 }
             }
             if (!centeredOnParent)
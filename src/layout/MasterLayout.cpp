@@ -10,6 +10,7 @@
 #include "../managers/LayoutManager.hpp"
 #include "../managers/EventManager.hpp"
 #include "../desktop/state/FocusState.hpp"
+#include "../debug/FrameProfiler.hpp"
 #include "xwayland/XWayland.hpp"
 
 SMasterNodeData* CHyprMasterLayout::getNodeFromWindow(PHLWINDOW pWindow) {
@@ -52,13 +53,13 @@ SMasterWorkspaceData* CHyprMasterLayout::getMasterWorkspaceData(const WORKSPACEI
     PWORKSPACEDATA->workspaceID = ws;
     static auto PORIENTATION    = CConfigValue<std::string>("master:orientation");
 
-    if (*PORIENTATION == "top")
+    if (PORIENTATION.view() == "top")
         PWORKSPACEDATA->orientation = ORIENTATION_TOP;
-    else if (*PORIENTATION == "right")
+    else if (PORIENTATION.view() == "right")
         PWORKSPACEDATA->orientation = ORIENTATION_RIGHT;
-    else if (*PORIENTATION == "bottom")
+    else if (PORIENTATION.view() == "bottom")
         PWORKSPACEDATA->orientation = ORIENTATION_BOTTOM;
-    else if (*PORIENTATION == "center")
+    else if (PORIENTATION.view() == "center")
         PWORKSPACEDATA->orientation = ORIENTATION_CENTER;
     else
         PWORKSPACEDATA->orientation = ORIENTATION_LEFT;
@@ -89,13 +90,13 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
 
     const auto  PMONITOR = pWindow->m_monitor.lock();
 
-    const bool  BNEWBEFOREACTIVE = *PNEWONACTIVE == "before";
-    const bool  BNEWISMASTER     = *PNEWSTATUS == "master";
+    const bool  BNEWBEFOREACTIVE = PNEWONACTIVE.view() == "before";
+    const bool  BNEWISMASTER     = PNEWSTATUS.view() == "master";
 
     const auto  PNODE = [&]() {
-        if (*PNEWONACTIVE != "none" && !BNEWISMASTER) {
+        if (PNEWONACTIVE.view() != "none" && !BNEWISMASTER) {
             const auto pLastNode = getNodeFromWindow(Desktop::focusState()->window());
-            if (pLastNode && !(pLastNode->isMaster && (getMastersOnWorkspace(pWindow->workspaceID()) == 1 || *PNEWSTATUS == "slave"))) {
+            if (pLastNode && !(pLastNode->isMaster && (getMastersOnWorkspace(pWindow->workspaceID()) == 1 || PNEWSTATUS.view() == "slave"))) {
                 auto it = std::ranges::find(m_masterNodesData, *pLastNode);
                 if (!BNEWBEFOREACTIVE)
                     ++it;
@@ -183,7 +184,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
         || WINDOWSONWORKSPACE == 1                                                              //
         || (WINDOWSONWORKSPACE > 2 && !pWindow->m_firstMap && OPENINGON && OPENINGON->isMaster) //
         || forceDropAsMaster                                                                    //
-        || (*PNEWSTATUS == "inherit" && OPENINGON && OPENINGON->isMaster && g_pInputManager->m_dragMode != MBIND_MOVE)) {
+        || (PNEWSTATUS.view() == "inherit" && OPENINGON && OPENINGON->isMaster && g_pInputManager->m_dragMode != MBIND_MOVE)) {
 
         if (BNEWBEFOREACTIVE) {
             for (auto& nd : m_masterNodesData | std::views::reverse) {
@@ -286,6 +287,8 @@ void CHyprMasterLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
 }
 
 void CHyprMasterLayout::recalculateMonitor(const MONITORID& monid) {
+    PROFILER_ZONE(PROFILER_STAGE_LAYOUT, "RecalculateMonitor", monid);
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(monid);
 
     if (!PMONITOR || !PMONITOR->m_activeWorkspace)
@@ -359,13 +362,13 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         if (STACKWINDOWS >= *SLAVECOUNTFORCENTER)
             centerMasterWindow = true;
         else {
-            if (*CMFALLBACK == "left")
+            if (CMFALLBACK.view() == "left")
                 orientation = ORIENTATION_LEFT;
-            else if (*CMFALLBACK == "right")
+            else if (CMFALLBACK.view() == "right")
                 orientation = ORIENTATION_RIGHT;
-            else if (*CMFALLBACK == "top")
+            else if (CMFALLBACK.view() == "top")
                 orientation = ORIENTATION_TOP;
-            else if (*CMFALLBACK == "bottom")
+            else if (CMFALLBACK.view() == "bottom")
                 orientation = ORIENTATION_BOTTOM;
             else
                 orientation = ORIENTATION_LEFT;
@@ -556,7 +559,7 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         float       nextY       = 0;
         float       nextYL      = 0;
         float       nextYR      = 0;
-        bool        onRight     = *CMFALLBACK == "right";
+        bool        onRight     = CMFALLBACK.view() == "right";
         int         slavesLeftL = 1 + (slavesLeft - 1) / 2;
         int         slavesLeftR = slavesLeft - slavesLeftL;
 
@@ -583,7 +586,7 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
                 onRight = !onRight;
             }
 
-            onRight = *CMFALLBACK == "right";
+            onRight = CMFALLBACK.view() == "right";
         }
 
         for (auto& nd : m_masterNodesData) {
@@ -1016,7 +1019,10 @@ void CHyprMasterLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_monitor, pWindow->m_monitor);
-        std::swap(pWindow2->m_workspace, pWindow->m_workspace);
+
+        const auto WORKSPACE1 = pWindow->m_workspace;
+        pWindow->setWorkspace(pWindow2->m_workspace);
+        pWindow2->setWorkspace(WORKSPACE1);
     }
 
     // massive hack: just swap window pointers, lol
@@ -1500,7 +1506,7 @@ Vector2D CHyprMasterLayout::predictSizeForNewWindowTiled() {
     if (!MASTER) // wtf
         return {};
 
-    if (*PNEWSTATUS == "master") {
+    if (PNEWSTATUS.view() == "master") {
         return MASTER->size;
     } else {
         const auto SLAVES = NODES - getMastersOnWorkspace(Desktop::focusState()->monitor()->m_activeWorkspace->m_id);
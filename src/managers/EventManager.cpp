@@ -6,10 +6,14 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <cstring>
+#include <hyprutils/string/VarList.hpp>
+#include "eventLoop/EventLoopManager.hpp"
 using namespace Hyprutils::OS;
+using namespace Hyprutils::String;
 
 CEventManager::CEventManager() : m_socketFD(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) {
     if (!m_socketFD.isValid()) {
@@ -84,12 +88,12 @@ int CEventManager::onServerEvent(int fd, uint32_t mask) {
 
     Log::logger->log(Log::DEBUG, "Socket2 accepted a new client at FD {}", ACCEPTEDCONNECTION.get());
 
-    // add to event loop so we can close it when we need to
-    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), 0, onServerEvent, nullptr);
+    // add to event loop so we can close it when we need to, and read subscriptions
+    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
     m_clients.emplace_back(SClient{
-        std::move(ACCEPTEDCONNECTION),
-        {},
-        eventSource,
+        .fd          = std::move(ACCEPTEDCONNECTION),
+        .eventSource = eventSource,
+        .eventMask   = WL_EVENT_READABLE,
     });
 
     return 0;
@@ -102,24 +106,196 @@ int CEventManager::onClientEvent(int fd, uint32_t mask) {
         return 0;
     }
 
+    const auto CLIENTIT = findClientByFD(fd);
+    if (CLIENTIT == m_clients.end())
+        return 0;
+
+    if (mask & WL_EVENT_READABLE && !readFromClient(*CLIENTIT)) {
+        Log::logger->log(Log::DEBUG, "Socket2 fd {} broke while reading", fd);
+        removeClientByFD(fd);
+        return 0;
+    }
+
     if (mask & WL_EVENT_WRITABLE) {
-        const auto CLIENTIT = findClientByFD(fd);
+        if (!flushClient(*CLIENTIT)) {
+            Log::logger->log(Log::DEBUG, "Socket2 fd {} broke while flushing", fd);
+            removeClientByFD(fd);
+        }
+    }
 
-        // send all queued events
-        while (!CLIENTIT->events.empty()) {
-            const auto& event = CLIENTIT->events.front();
-            if (write(CLIENTIT->fd.get(), event->c_str(), event->length()) < 0)
-                break;
+    return 0;
+}
+
+bool CEventManager::readFromClient(SClient& client) {
+    std::array<char, 1024> buffer;
+
+    while (true) {
+        const auto LEN = read(client.fd.get(), buffer.data(), buffer.size());
 
-            CLIENTIT->events.erase(CLIENTIT->events.begin());
+        // half-closed, e.g. socat or nc after their stdin ended. It can still read events.
+        if (LEN == 0) {
+            client.readClosed = true;
+            break;
         }
 
-        // stop polling when we sent all events
-        if (CLIENTIT->events.empty())
-            wl_event_source_fd_update(CLIENTIT->eventSource, 0);
+        if (LEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+
+            break;
+        }
+
+        client.inBuffer.append(buffer.data(), LEN);
     }
 
-    return 0;
+    // clients may send "subscribe <event> <event>..." or "unsubscribe <event>...", one command per line.
+    // A client that never subscribed receives every event it didn't unsubscribe from. Once it subscribes,
+    // it only receives what it subscribed to, and one that unsubscribed from all of that receives none.
+    size_t pos = 0;
+    while (true) {
+        const auto END = client.inBuffer.find('\n', pos);
+        if (END == std::string::npos)
+            break;
+
+        const auto LINE = client.inBuffer.substr(pos, END - pos);
+        pos             = END + 1;
+
+        CVarList   args(LINE, 0, 's', true);
+        if (args.size() < 2)
+            continue;
+
+        const bool SUBSCRIBE = args[0] == "subscribe";
+        if (!SUBSCRIBE && args[0] != "unsubscribe")
+            continue;
+
+        for (size_t i = 1; i < args.size(); ++i) {
+            CVarList names(args[i], 0, ',', true);
+            for (const auto& name : names) {
+                if (SUBSCRIBE) {
+                    client.filtered = true;
+                    client.subscriptions.emplace(name);
+                } else if (client.filtered)
+                    client.subscriptions.erase(name);
+                else
+                    client.unsubscriptions.emplace(name);
+            }
+        }
+
+        if (client.filtered)
+            Log::logger->log(Log::DEBUG, "Socket2 fd {} is now subscribed to {} events", client.fd.get(), client.subscriptions.size());
+        else
+            Log::logger->log(Log::DEBUG, "Socket2 fd {} is now subscribed to all but {} events", client.fd.get(), client.unsubscriptions.size());
+    }
+
+    client.inBuffer.erase(0, pos);
+
+    // nobody sends subscriptions this large, drop the garbage
+    if (client.inBuffer.size() > 4096)
+        client.inBuffer.clear();
+
+    // stop polling a closed end for reads, it'd be readable forever
+    if (client.readClosed)
+        updateClientEvents(client);
+
+    return true;
+}
+
+bool CEventManager::SEventQueue::push(const SP<std::string>& event) {
+    if (size >= MAX_QUEUED_EVENTS)
+        return false;
+
+    events[(head + size) % MAX_QUEUED_EVENTS] = event;
+    size++;
+    return true;
+}
+
+void CEventManager::SEventQueue::consume(size_t bytes) {
+    while (size > 0 && bytes > 0) {
+        const auto LEFT = events[head]->length() - offset;
+
+        if (bytes < LEFT) {
+            offset += bytes;
+            return;
+        }
+
+        bytes -= LEFT;
+        events[head].reset();
+        head   = (head + 1) % MAX_QUEUED_EVENTS;
+        offset = 0;
+        size--;
+    }
+}
+
+bool CEventManager::flushClient(SClient& client) {
+    while (client.queue.size > 0) {
+        std::array<iovec, MAX_QUEUED_EVENTS> iov;
+
+        for (size_t i = 0; i < client.queue.size; ++i) {
+            const auto& EVENT = client.queue.events[(client.queue.head + i) % MAX_QUEUED_EVENTS];
+            const auto  SKIP  = i == 0 ? client.queue.offset : 0;
+            iov[i].iov_base   = const_cast<char*>(EVENT->data()) + SKIP;
+            iov[i].iov_len    = EVENT->length() - SKIP;
+        }
+
+        const auto LEN = writev(client.fd.get(), iov.data(), client.queue.size);
+
+        if (LEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+
+            break;
+        }
+
+        client.queue.consume(LEN);
+    }
+
+    updateClientEvents(client);
+
+    return true;
+}
+
+void CEventManager::updateClientEvents(SClient& client) {
+    // poll for write until everything is out. Hangups and errors are reported regardless.
+    const uint32_t MASK = (client.readClosed ? 0 : WL_EVENT_READABLE) | (client.queue.size > 0 ? WL_EVENT_WRITABLE : 0);
+
+    if (MASK == client.eventMask)
+        return;
+
+    client.eventMask = MASK;
+    wl_event_source_fd_update(client.eventSource, MASK);
+}
+
+void CEventManager::scheduleFlush() {
+    if (m_flushScheduled)
+        return;
+
+    m_flushScheduled = true;
+
+    // batch everything posted during this loop iteration into one writev per client
+    g_pEventLoopManager->doLater([] {
+        if (g_pEventManager)
+            g_pEventManager->flushClients();
+    });
+}
+
+void CEventManager::flushClients() {
+    m_flushScheduled = false;
+
+    for (auto it = m_clients.begin(); it != m_clients.end();) {
+        if (!flushClient(*it)) {
+            Log::logger->log(Log::DEBUG, "Socket2 fd {} broke while flushing", it->fd.get());
+            it = removeClientByFD(it->fd.get());
+            continue;
+        }
+
+        ++it;
+    }
 }
 
 std::vector<CEventManager::SClient>::iterator CEventManager::findClientByFD(int fd) {
@@ -146,27 +322,29 @@ void CEventManager::postEvent(const SHyprIPCEvent& event) {
         return;
     }
 
-    const size_t MAX_QUEUED_EVENTS = 64;
-    auto         sharedEvent       = makeShared<std::string>(formatEvent(event));
+    SP<std::string> sharedEvent;
+
     for (auto it = m_clients.begin(); it != m_clients.end();) {
-        // try to send the event immediately if the queue is empty
-        const auto QUEUESIZE = it->events.size();
-        if (QUEUESIZE > 0 || write(it->fd.get(), sharedEvent->c_str(), sharedEvent->length()) < 0) {
-            if (QUEUESIZE >= MAX_QUEUED_EVENTS) {
-                // too many events queued, remove the client
-                Log::logger->log(Log::ERR, "Socket2 fd {} overflowed event queue, removing", it->fd.get());
-                it = removeClientByFD(it->fd.get());
-                continue;
-            }
+        if (it->filtered ? !it->subscriptions.contains(event.event) : it->unsubscriptions.contains(event.event)) {
+            ++it;
+            continue;
+        }
 
-            // queue it to send later if failed
-            it->events.push_back(sharedEvent);
+        // format lazily, nobody might be interested
+        if (!sharedEvent)
+            sharedEvent = makeShared<std::string>(formatEvent(event));
 
-            // poll for write if queue was empty
-            if (QUEUESIZE == 0)
-                wl_event_source_fd_update(it->eventSource, WL_EVENT_WRITABLE);
+        // a burst (workspace switch, hotplug, reload) can fill the queue before the batched flush,
+        // write it out now. Only a client whose socket stays full is stuck.
+        if (!it->queue.push(sharedEvent) && (!flushClient(*it) || !it->queue.push(sharedEvent))) {
+            Log::logger->log(Log::ERR, "Socket2 fd {} isn't reading its events, removing", it->fd.get());
+            it = removeClientByFD(it->fd.get());
+            continue;
         }
 
         ++it;
     }
+
+    if (sharedEvent)
+        scheduleFlush();
 }
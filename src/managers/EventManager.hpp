@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <unordered_set>
 #include <vector>
 #include <hyprutils/os/FileDescriptor.hpp>
 #include "../defines.hpp"
@@ -25,20 +27,48 @@ class CEventManager {
     int         onServerEvent(int fd, uint32_t mask);
     int         onClientEvent(int fd, uint32_t mask);
 
+    static constexpr size_t MAX_QUEUED_EVENTS = 64;
+
+    // fixed-size ring of formatted events. The payloads are shared between all clients.
+    struct SEventQueue {
+        std::array<SP<std::string>, MAX_QUEUED_EVENTS> events;
+        size_t                                               head   = 0;
+        size_t                                               size   = 0;
+        size_t                                               offset = 0; // bytes of the front event already written
+
+        bool                                                 push(const SP<std::string>& event);
+        void                                                 consume(size_t bytes);
+    };
+
     struct SClient {
-        Hyprutils::OS::CFileDescriptor fd;
-        std::vector<SP<std::string>>   events;
-        wl_event_source*               eventSource = nullptr;
+        Hyprutils::OS::CFileDescriptor  fd;
+        SEventQueue                     queue;
+        wl_event_source*                eventSource = nullptr;
+        uint32_t                        eventMask   = 0;
+
+        // until the client subscribes to something, it gets everything it didn't unsubscribe from
+        bool                            filtered = false;
+        std::unordered_set<std::string> subscriptions;
+        std::unordered_set<std::string> unsubscriptions;
+        std::string                     inBuffer;
+        bool                            readClosed = false; // it shut down its end, but may still listen
     };
 
     std::vector<SClient>::iterator findClientByFD(int fd);
     std::vector<SClient>::iterator removeClientByFD(int fd);
 
+    bool                           readFromClient(SClient& client); // false if the client broke
+    void                           updateClientEvents(SClient& client);
+    void                           scheduleFlush();
+    void                           flushClients();
+    bool                           flushClient(SClient& client); // false if the client broke
+
   private:
     Hyprutils::OS::CFileDescriptor m_socketFD;
     wl_event_source*               m_eventSource = nullptr;
 
     std::vector<SClient>           m_clients;
+    bool                           m_flushScheduled = false;
 };
 
 inline UP<CEventManager> g_pEventManager;
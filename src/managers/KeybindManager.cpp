@@ -26,6 +26,7 @@
 #include "../config/ConfigManager.hpp"
 #include "../desktop/rule/windowRule/WindowRule.hpp"
 #include "../desktop/rule/Engine.hpp"
+#include "../helpers/Launcher.hpp"
 
 #include <optional>
 #include <iterator>
@@ -219,10 +220,14 @@ CKeybindManager::~CKeybindManager() {
 }
 
 void CKeybindManager::addKeybind(SKeybind kb) {
+    kb.keysym         = xkb_keysym_from_name(kb.key.c_str(), XKB_KEYSYM_NO_FLAGS);
+    kb.keysymCaseless = xkb_keysym_from_name(kb.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+
     m_keybinds.emplace_back(makeShared<SKeybind>(kb));
 
     m_activeKeybinds.clear();
     m_lastLongPressKeybind.reset();
+    m_bindIndex.dirty = true;
 }
 
 void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
@@ -230,6 +235,75 @@ void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
 
     m_activeKeybinds.clear();
     m_lastLongPressKeybind.reset();
+    m_bindIndex.dirty = true;
+}
+
+void CKeybindManager::rebuildBindIndex() {
+    m_bindIndex.byName.clear();
+    m_bindIndex.byKeysym.clear();
+    m_bindIndex.byKeycode.clear();
+    m_bindIndex.catchAll.clear();
+    m_bindIndex.multiKey.clear();
+
+    // mirrors the order of the key checks in handleKeybinds
+    for (size_t i = 0; i < m_keybinds.size(); ++i) {
+        const auto& k = m_keybinds[i];
+
+        if (k->multiKey) {
+            m_bindIndex.multiKey.emplace_back(i);
+            continue;
+        }
+
+        m_bindIndex.byName[k->key].emplace_back(i);
+
+        if (k->keycode != 0)
+            m_bindIndex.byKeycode[k->keycode].emplace_back(i);
+        else if (k->catchAll)
+            m_bindIndex.catchAll.emplace_back(i);
+        else {
+            // binds whose key doesn't resolve to a keysym can never match on one
+            if (k->keysym != XKB_KEY_NoSymbol)
+                m_bindIndex.byKeysym[k->keysym].emplace_back(i);
+            if (k->keysymCaseless != XKB_KEY_NoSymbol && k->keysymCaseless != k->keysym)
+                m_bindIndex.byKeysym[k->keysymCaseless].emplace_back(i);
+        }
+    }
+
+    m_bindIndex.size  = m_keybinds.size();
+    m_bindIndex.dirty = false;
+}
+
+std::vector<SP<SKeybind>> CKeybindManager::bindCandidates(const SPressedKeyWithMods& key) {
+    // m_keybinds is public, catch anyone changing it behind our back
+    if (m_bindIndex.dirty || m_bindIndex.size != m_keybinds.size())
+        rebuildBindIndex();
+
+    std::vector<size_t> positions = m_bindIndex.multiKey;
+
+    const auto          append = [&positions](const auto& map, const auto& k) {
+        if (const auto IT = map.find(k); IT != map.end())
+            positions.insert(positions.end(), IT->second.begin(), IT->second.end());
+    };
+
+    if (!key.keyName.empty())
+        append(m_bindIndex.byName, key.keyName);
+    else {
+        positions.insert(positions.end(), m_bindIndex.catchAll.begin(), m_bindIndex.catchAll.end());
+        append(m_bindIndex.byKeycode, key.keycode);
+        if (key.keysym != XKB_KEY_NoSymbol)
+            append(m_bindIndex.byKeysym, key.keysym);
+    }
+
+    // binds fire in config order, and "found" / submap changes depend on it
+    std::ranges::sort(positions);
+
+    std::vector<SP<SKeybind>> candidates;
+    candidates.reserve(positions.size());
+    for (const auto& i : positions) {
+        candidates.emplace_back(m_keybinds[i]);
+    }
+
+    return candidates;
 }
 
 uint32_t CKeybindManager::stringToModMask(std::string mods) {
@@ -665,7 +739,8 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
         }
     }
 
-    for (auto& k : m_keybinds) {
+    // hold refs, a dispatcher may add or remove binds
+    for (auto& k : bindCandidates(key)) {
         const bool SPECIALDISPATCHER = k->handler == "global" || k->handler == "pass" || k->handler == "sendshortcut" || k->handler == "mouse";
         const bool SPECIALTRIGGERED  = std::ranges::find_if(m_pressedSpecialBinds, [&](const auto& other) { return other == k; }) != m_pressedSpecialBinds.end();
         const bool IGNORECONDITIONS =
@@ -701,10 +776,8 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             if (key.keysym == XKB_KEY_NoSymbol)
                 continue;
 
-            // oMg such performance hit!!11!
-            // this little maneouver is gonna cost us 4µs
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_NO_FLAGS);
-            const auto KBKEYLOWER = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = k->keysym;
+            const auto KBKEYLOWER = k->keysymCaseless;
 
             if (KBKEY == XKB_KEY_NoSymbol && KBKEYLOWER == XKB_KEY_NoSymbol) {
                 // Keysym failed to resolve from the key name of the currently iterated bind.
@@ -839,7 +912,7 @@ void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const uint3
         if (k->multiKey && (mkBindMatches(k) == MK_FULL_MATCH))
             shadow = true;
         else {
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = k->keysymCaseless;
             const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
 
             for (auto const& pk : m_pressedKeys) {
@@ -951,45 +1024,20 @@ SDispatchResult CKeybindManager::spawnRaw(std::string args) {
 uint64_t CKeybindManager::spawnRawProc(std::string args, PHLWORKSPACE pInitialWorkspace, const std::string& execRuleToken) {
     Log::logger->log(Log::DEBUG, "Executing {}", args);
 
-    const auto HLENV = getHyprlandLaunchEnv(pInitialWorkspace);
+    auto env = getHyprlandLaunchEnv(pInitialWorkspace);
+    env.emplace_back("WAYLAND_DISPLAY", g_pCompositor->m_wlDisplaySocket);
+    if (!execRuleToken.empty())
+        env.emplace_back(Desktop::Rule::EXEC_RULE_ENV_NAME, execRuleToken);
 
-    pid_t      child = fork();
-    if (child < 0) {
-        Log::logger->log(Log::DEBUG, "Fail to fork");
+    const auto PID = NLauncher::spawn({.command = args, .env = std::move(env), .nofile = g_pCompositor->originalNofile()});
+    if (PID < 0) {
+        Log::logger->log(Log::DEBUG, "Fail to spawn: {}", strerror(errno));
         return 0;
     }
-    if (child == 0) {
-        // run in child
-        g_pCompositor->restoreNofile();
-
-        sigset_t set;
-        sigemptyset(&set);
-        sigprocmask(SIG_SETMASK, &set, nullptr);
-
-        for (auto const& e : HLENV) {
-            setenv(e.first.c_str(), e.second.c_str(), 1);
-        }
-        setenv("WAYLAND_DISPLAY", g_pCompositor->m_wlDisplaySocket.c_str(), 1);
-        if (!execRuleToken.empty())
-            setenv(Desktop::Rule::EXEC_RULE_ENV_NAME, execRuleToken.c_str(), true);
-
-        int devnull = open("/dev/null", O_WRONLY | O_CLOEXEC);
-        if (devnull != -1) {
-            dup2(devnull, STDOUT_FILENO);
-            dup2(devnull, STDERR_FILENO);
-            close(devnull);
-        }
-
-        execl("/bin/sh", "/bin/sh", "-c", args.c_str(), nullptr);
-
-        // exit child
-        _exit(0);
-    }
-    // run in parent
 
-    Log::logger->log(Log::DEBUG, "Process Created with pid {}", child);
+    Log::logger->log(Log::DEBUG, "Process Created with pid {}", PID);
 
-    return child;
+    return PID;
 }
 
 SDispatchResult CKeybindManager::killActive(std::string args) {
@@ -1095,6 +1143,7 @@ SDispatchResult CKeybindManager::signalWindow(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_keybinds.clear();
+    m_bindIndex.dirty = true;
 }
 
 static SDispatchResult toggleActiveFloatingCore(std::string args, std::optional<bool> floatState) {
@@ -2722,7 +2771,7 @@ SDispatchResult CKeybindManager::pinActive(std::string args) {
         return {.success = false, .error = "pin: window not found"};
     }
 
-    PWINDOW->m_workspace = PMONITOR->m_activeWorkspace;
+    PWINDOW->setWorkspace(PMONITOR->m_activeWorkspace);
 
     PWINDOW->m_ruleApplicator->propertiesChanged(Desktop::Rule::RULE_PROP_PINNED);
 
@@ -53,6 +53,10 @@ struct SKeybind {
 
     // DO NOT INITIALIZE
     bool shadowed = false;
+
+    // resolved from key once in addKeybind, xkb_keysym_from_name is too slow to call per key event
+    xkb_keysym_t keysym         = XKB_KEY_NoSymbol;
+    xkb_keysym_t keysymCaseless = XKB_KEY_NoSymbol;
 };
 
 enum eFocusWindowMode : uint8_t {
@@ -147,6 +151,21 @@ class CKeybindManager {
 
     SDispatchResult                  handleKeybinds(const uint32_t, const SPressedKeyWithMods&, bool, SP<IKeyboard>);
 
+    // positions in m_keybinds, bucketed by what a key event has to match for the bind to fire.
+    // Mods and submap aren't indexed, ignoremods, universal submaps and special releases bypass them.
+    struct {
+        std::unordered_map<std::string, std::vector<size_t>>  byName; // events with a key name (mouse, switches), all but multikey binds
+        std::unordered_map<xkb_keysym_t, std::vector<size_t>> byKeysym;
+        std::unordered_map<uint32_t, std::vector<size_t>>     byKeycode;
+        std::vector<size_t>                                   catchAll;
+        std::vector<size_t>                                   multiKey; // matched against every event
+        size_t                                                size  = 0;
+        bool                                                  dirty = true;
+    } m_bindIndex;
+
+    void                             rebuildBindIndex();
+    std::vector<SP<SKeybind>>        bindCandidates(const SPressedKeyWithMods&); // in m_keybinds order
+
     std::set<xkb_keysym_t>           m_mkKeys = {};
     std::set<xkb_keysym_t>           m_mkMods = {};
     eMultiKeyCase                    mkBindMatches(const SP<SKeybind>);
@@ -5,6 +5,7 @@
 #include "../protocols/PointerGestures.hpp"
 #include "../protocols/RelativePointer.hpp"
 #include "../protocols/FractionalScale.hpp"
+#include "../protocols/ImageCopyCapture.hpp"
 #include "../protocols/IdleNotify.hpp"
 #include "../protocols/core/Compositor.hpp"
 #include "../protocols/core/Seat.hpp"
@@ -288,6 +289,9 @@ void CPointerManager::updateCursorBackend() {
 
         state->hardwareFailed = false;
     }
+
+    if (PROTO::imageCopyCapture)
+        PROTO::imageCopyCapture->onCursorChanged(true);
 }
 
 void CPointerManager::onCursorMoved() {
@@ -329,6 +333,9 @@ void CPointerManager::onCursorMoved() {
 
     if (recalc)
         updateCursorBackend();
+
+    if (PROTO::imageCopyCapture)
+        PROTO::imageCopyCapture->onCursorChanged(false);
 }
 
 bool CPointerManager::attemptHardwareCursor(SP<CPointerManager::SMonitorPointerState> state) {
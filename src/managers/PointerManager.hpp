@@ -58,13 +58,18 @@ class CPointerManager {
     void damageCursor(PHLMONITOR pMonitor);
 
     //
-    Vector2D position();
-    Vector2D cursorSizeLogical();
-    void     storeMovement(uint64_t time, const Vector2D& delta, const Vector2D& deltaUnaccel);
-    void     setStoredMovement(uint64_t time, const Vector2D& delta, const Vector2D& deltaUnaccel);
-    void     sendStoredMovement();
+    Vector2D     position();
+    Vector2D     cursorSizeLogical();
+    // returns the thing in global coords
+    CBox         getCursorBoxGlobal();
+    // returns the thing in logical coordinates of the monitor
+    CBox         getCursorBoxLogicalForMonitor(PHLMONITOR pMonitor);
+    SP<CTexture> getCurrentCursorTexture();
+    void         storeMovement(uint64_t time, const Vector2D& delta, const Vector2D& deltaUnaccel);
+    void         setStoredMovement(uint64_t time, const Vector2D& delta, const Vector2D& deltaUnaccel);
+    void         sendStoredMovement();
 
-    void     recheckEnteredOutputs();
+    void         recheckEnteredOutputs();
 
   private:
     void recheckPointerPosition();
@@ -80,14 +85,7 @@ class CPointerManager {
 
     // returns the thing in device coordinates. Is NOT offset by the hotspot, relies on set_cursor with hotspot.
     Vector2D getCursorPosForMonitor(PHLMONITOR pMonitor);
-    // returns the thing in logical coordinates of the monitor
-    CBox getCursorBoxLogicalForMonitor(PHLMONITOR pMonitor);
-    // returns the thing in global coords
-    CBox         getCursorBoxGlobal();
-
-    Vector2D     transformedHotspot(PHLMONITOR pMonitor);
-
-    SP<CTexture> getCurrentCursorTexture();
+    Vector2D transformedHotspot(PHLMONITOR pMonitor);
 
     struct SPointerListener {
         CHyprSignalListener destroy;
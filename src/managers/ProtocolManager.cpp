@@ -42,6 +42,8 @@
 #include "../protocols/DRMSyncobj.hpp"
 #include "../protocols/Screencopy.hpp"
 #include "../protocols/ToplevelExport.hpp"
+#include "../protocols/ImageCaptureSource.hpp"
+#include "../protocols/ImageCopyCapture.hpp"
 #include "../protocols/ToplevelMapping.hpp"
 #include "../protocols/TextInputV1.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
@@ -196,6 +198,13 @@ CProtocolManager::CProtocolManager() {
     PROTO::fifo                = makeUnique<CFifoProtocol>(&wp_fifo_manager_v1_interface, 1, "Fifo");
     PROTO::commitTiming        = makeUnique<CCommitTimingProtocol>(&wp_commit_timing_manager_v1_interface, 1, "CommitTiming");
 
+    // image capture sources are each their own global
+    PROTO::outputImageCaptureSource   = makeUnique<CImageCaptureSourceProtocol>(&ext_output_image_capture_source_manager_v1_interface, 1, "OutputImageCaptureSource",
+                                                                                IMAGE_CAPTURE_SOURCE_OUTPUT);
+    PROTO::toplevelImageCaptureSource = makeUnique<CImageCaptureSourceProtocol>(&ext_foreign_toplevel_image_capture_source_manager_v1_interface, 1, "ToplevelImageCaptureSource",
+                                                                                IMAGE_CAPTURE_SOURCE_TOPLEVEL);
+    PROTO::imageCopyCapture           = makeUnique<CImageCopyCaptureProtocol>(&ext_image_copy_capture_manager_v1_interface, 1, "ImageCopyCapture");
+
     if (*PENABLECM)
         PROTO::colorManagement = makeUnique<CColorManagementProtocol>(&wp_color_manager_v1_interface, 1, "ColorManagement", *PDEBUGCM);
 
@@ -294,6 +303,9 @@ CProtocolManager::~CProtocolManager() {
     PROTO::pointerWarp.reset();
     PROTO::fifo.reset();
     PROTO::commitTiming.reset();
+    PROTO::outputImageCaptureSource.reset();
+    PROTO::toplevelImageCaptureSource.reset();
+    PROTO::imageCopyCapture.reset();
 
     for (auto& [_, lease] : PROTO::lease) {
         lease.reset();
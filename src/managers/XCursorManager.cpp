@@ -11,7 +11,6 @@ extern "C" {
 #include <gio/gio.h>
 #include <gio/gsettingsschema.h>
 #include "config/ConfigValue.hpp"
-#include "helpers/CursorShapes.hpp"
 #include "../managers/CursorManager.hpp"
 #include "debug/log/Logger.hpp"
 #include "XCursorManager.hpp"
@@ -107,97 +106,156 @@ CXCursorManager::CXCursorManager() {
 
     m_hyprCursor->images.push_back(image);
     m_hyprCursor->shape = "left_ptr";
-    m_defaultCursor     = m_hyprCursor;
 }
 
 void CXCursorManager::loadTheme(std::string const& name, int size, float scale) {
-    if (m_lastLoadSize == (size * std::ceil(scale)) && m_themeName == name && m_lastLoadScale == scale)
+    const auto THEME = name.empty() ? "default" : name;
+
+    if (m_themeSize == size && m_themeName == THEME && m_themeScale == scale)
         return;
 
-    m_lastLoadSize  = size * std::ceil(scale);
-    m_lastLoadScale = scale;
-    m_themeName     = name.empty() ? "default" : name;
-    m_defaultCursor.reset();
-    m_cursors.clear();
+    m_themeSize  = size;
+    m_themeScale = scale;
+    m_themeName  = THEME;
 
-    auto paths = themePaths(m_themeName);
-    if (paths.empty()) {
-        Log::logger->log(Log::ERR, "XCursor librarypath is empty loading standard XCursors");
-        m_cursors = loadStandardCursors(m_themeName, m_lastLoadSize);
-    } else {
-        for (auto const& p : paths) {
-            try {
-                auto dirCursors = loadAllFromDir(p, m_lastLoadSize);
-                std::ranges::copy_if(dirCursors, std::back_inserter(m_cursors),
-                                     [this](auto const& p) { return std::ranges::none_of(m_cursors, [&p](auto const& dp) { return dp->shape == p->shape; }); });
-            } catch (std::exception& e) { Log::logger->log(Log::ERR, "XCursor path {} can't be loaded: threw error {}", p, e.what()); }
-        }
-    }
+    // only the current theme is ever used, and one that wasn't found might've been installed since
+    std::erase_if(m_themes, [this](const auto& e) { return e.first != m_themeName || e.second.paths.empty(); });
 
-    if (m_cursors.empty()) {
+    // warm up the default shape so a broken theme is reported now and not on first use
+    if (sizeCacheFor(m_themeName, size * std::ceil(scale)).defaultCursor == m_hyprCursor)
         Log::logger->log(Log::ERR, "XCursor failed finding any shapes in theme \"{}\".", m_themeName);
-        m_defaultCursor = m_hyprCursor;
-        return;
+
+    syncGsettings();
+}
+
+SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
+    // different monitors want different sizes, each has its own cache so switching between them is just a lookup
+    const int PIXELS = size * std::ceil(scale);
+    auto&     cache  = sizeCacheFor(m_themeName, PIXELS);
+
+    if (const auto IT = cache.byShape.find(shape); IT != cache.byShape.end())
+        return IT->second;
+
+    auto& theme  = themeFor(m_themeName);
+    auto  cursor = loadShape(m_themeName, theme, cache, shape, PIXELS);
+
+    if (!cursor) {
+        // the theme might only have the old X11 name for it
+        const auto LEGACY = getLegacyShapeName(shape);
+        if (!LEGACY.empty())
+            cursor = loadShape(m_themeName, theme, cache, LEGACY, PIXELS);
     }
 
-    for (auto const& shape : CURSOR_SHAPE_NAMES) {
-        auto legacyName = getLegacyShapeName(shape);
-        if (legacyName.empty())
-            continue;
+    if (!cursor) {
+        Log::logger->log(Log::WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
+        return cache.defaultCursor;
+    }
 
-        auto it = std::ranges::find_if(m_cursors, [&legacyName](auto const& c) { return c->shape == legacyName; });
+    cache.byShape[shape] = cursor;
+    return cursor;
+}
 
-        if (it == m_cursors.end()) {
-            Log::logger->log(Log::DEBUG, "XCursor failed to find a legacy shape with name {}, skipping", legacyName);
-            continue;
-        }
+CXCursorManager::STheme& CXCursorManager::themeFor(std::string const& name) {
+    if (const auto IT = m_themes.find(name); IT != m_themes.end())
+        return IT->second;
 
-        if (std::ranges::any_of(m_cursors, [&shape](auto const& dp) { return dp->shape == shape; })) {
-            Log::logger->log(Log::DEBUG, "XCursor already has a shape {} loaded, skipping", shape);
-            continue;
-        }
+    auto& theme = m_themes[name];
+
+    // std::set keeps these sorted, the first dir that has a shape wins
+    const auto PATHS = themePaths(name);
+    theme.paths.assign(PATHS.begin(), PATHS.end());
+
+    if (theme.paths.empty())
+        Log::logger->log(Log::ERR, "XCursor librarypath is empty loading standard XCursors");
+
+    return theme;
+}
+
+CXCursorManager::SSizeCache& CXCursorManager::sizeCacheFor(std::string const& name, int size) {
+    auto& theme = themeFor(name);
+
+    if (const auto IT = theme.sizes.find(size); IT != theme.sizes.end())
+        return IT->second;
 
-        auto cursor    = makeShared<SXCursors>();
-        cursor->images = it->get()->images;
-        cursor->shape  = shape;
+    auto& cache = theme.sizes[size];
 
-        m_cursors.emplace_back(cursor);
+    for (const auto& shape : {"left_ptr", "arrow"}) {
+        cache.defaultCursor = loadShape(name, theme, cache, shape, size);
+        if (cache.defaultCursor)
+            break;
     }
 
-    syncGsettings();
+    if (!cache.defaultCursor)
+        cache.defaultCursor = m_hyprCursor;
+
+    return cache;
 }
 
-SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
-    // monitor scaling changed etc, so reload theme with new size.
-    if ((size * std::ceil(scale)) != m_lastLoadSize || scale != m_lastLoadScale)
-        loadTheme(m_themeName, size, scale);
+SP<SXCursors> CXCursorManager::loadShape(std::string const& themeName, STheme& theme, SSizeCache& cache, std::string const& shape, int size) {
+    if (theme.paths.empty())
+        return loadStandardCursor(themeName, cache, shape, size);
 
-    // try to get an icon we know if we have one
-    for (auto const& c : m_cursors) {
-        if (c->shape != shape)
+    for (auto const& dir : theme.paths) {
+        std::error_code ec;
+        const auto      PATH = std::filesystem::canonical(dir + "/" + shape, ec).string();
+        if (ec || !std::filesystem::is_regular_file(PATH, ec))
             continue;
 
-        return c;
+        if (const auto IT = cache.byFile.find(PATH); IT != cache.byFile.end())
+            return IT->second;
+
+        auto cursor = loadFromFile(PATH, shape, size);
+        if (!cursor)
+            continue;
+
+        cache.byFile[PATH] = cursor;
+        return cursor;
+    }
+
+    return nullptr;
+}
+
+SP<SXCursors> CXCursorManager::loadFromFile(std::string const& path, std::string const& shape, int size) {
+    using PcloseType = int (*)(FILE*);
+    const std::unique_ptr<FILE, PcloseType> f(fopen(path.c_str(), "r"), fclose);
+
+    if (!f)
+        return nullptr;
+
+    auto xImages = XcursorFileLoadImages(f.get(), size);
+
+    if (!xImages) {
+        Log::logger->log(Log::WARN, "XCursor failed to load image {}, trying size 24.", path);
+        rewind(f.get());
+        xImages = XcursorFileLoadImages(f.get(), 24);
+
+        if (!xImages) {
+            Log::logger->log(Log::WARN, "XCursor failed to load image {}, skipping", path);
+            return nullptr;
+        }
     }
 
-    Log::logger->log(Log::WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
-    return m_defaultCursor;
+    auto cursor = createCursor(shape, xImages);
+    XcursorImagesDestroy(xImages);
+
+    return cursor;
 }
 
 SP<SXCursors> CXCursorManager::createCursor(std::string const& shape, void* ximages) {
     auto           xcursor = makeShared<SXCursors>();
     XcursorImages* xImages = sc<XcursorImages*>(ximages);
 
+    xcursor->images.reserve(xImages->nimage);
+
     for (int i = 0; i < xImages->nimage; i++) {
         auto          xImage = xImages->images[i];
         SXCursorImage image;
         image.size    = {sc<int>(xImage->width), sc<int>(xImage->height)};
         image.hotspot = {sc<int>(xImage->xhot), sc<int>(xImage->yhot)};
-        image.pixels.resize(sc<size_t>(xImage->width) * xImage->height);
-        std::memcpy(image.pixels.data(), xImage->pixels, sc<size_t>(xImage->width) * xImage->height * sizeof(uint32_t));
+        image.pixels.assign(xImage->pixels, xImage->pixels + sc<size_t>(xImage->width) * xImage->height);
         image.delay = xImage->delay;
 
-        xcursor->images.emplace_back(image);
+        xcursor->images.emplace_back(std::move(image));
     }
 
     xcursor->shape = shape;
@@ -488,86 +546,32 @@ static std::array<const char*, 77> XCURSOR_STANDARD_NAMES = {
 };
 // clang-format on
 
-std::vector<SP<SXCursors>> CXCursorManager::loadStandardCursors(std::string const& name, int size) {
-    std::vector<SP<SXCursors>> newCursors;
-
-    // load the default xcursor shapes that exist in the theme
-    for (size_t i = 0; i < XCURSOR_STANDARD_NAMES.size(); ++i) {
-        std::string shape{XCURSOR_STANDARD_NAMES[i]};
-        auto        xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), size);
-
-        if (!xImages) {
-            Log::logger->log(Log::WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
-            xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), 24);
-
-            if (!xImages) {
-                Log::logger->log(Log::WARN, "XCursor failed to find a shape with name {}, skipping", shape);
-                continue;
-            }
-        }
-
-        auto cursor = createCursor(shape, xImages);
-        newCursors.emplace_back(cursor);
-
-        if (!m_defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-            m_defaultCursor = cursor;
+SP<SXCursors> CXCursorManager::loadStandardCursor(std::string const& themeName, SSizeCache& cache, std::string const& shape, int size) {
+    const auto IT = std::ranges::find_if(XCURSOR_STANDARD_NAMES, [&shape](const char* name) { return shape == name; });
+    if (IT == XCURSOR_STANDARD_NAMES.end())
+        return nullptr;
 
-        XcursorImagesDestroy(xImages);
-    }
-
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !m_defaultCursor)
-        m_defaultCursor = newCursors.front();
-
-    return newCursors;
-}
-
-std::vector<SP<SXCursors>> CXCursorManager::loadAllFromDir(std::string const& path, int size) {
-    std::vector<SP<SXCursors>> newCursors;
-
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path)) {
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            std::error_code e1, e2;
-            if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
-                Log::logger->log(Log::WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
-                continue;
-            }
-
-            auto const& full = entry.path().string();
-            using PcloseType = int (*)(FILE*);
-            const std::unique_ptr<FILE, PcloseType> f(fopen(full.c_str(), "r"), fclose);
+    if (const auto CACHED = cache.byFile.find(shape); CACHED != cache.byFile.end())
+        return CACHED->second;
 
-            if (!f)
-                continue;
-
-            auto xImages = XcursorFileLoadImages(f.get(), size);
+    const auto INDEX   = std::distance(XCURSOR_STANDARD_NAMES.begin(), IT);
+    auto       xImages = XcursorShapeLoadImages(INDEX << 1 /* wtf xcursor? */, themeName.c_str(), size);
 
-            if (!xImages) {
-                Log::logger->log(Log::WARN, "XCursor failed to load image {}, trying size 24.", full);
-                xImages = XcursorFileLoadImages(f.get(), 24);
+    if (!xImages) {
+        Log::logger->log(Log::WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
+        xImages = XcursorShapeLoadImages(INDEX << 1 /* wtf xcursor? */, themeName.c_str(), 24);
 
-                if (!xImages) {
-                    Log::logger->log(Log::WARN, "XCursor failed to load image {}, skipping", full);
-                    continue;
-                }
-            }
-
-            auto const& shape  = entry.path().filename().string();
-            auto        cursor = createCursor(shape, xImages);
-            newCursors.emplace_back(cursor);
-
-            if (!m_defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-                m_defaultCursor = cursor;
-
-            XcursorImagesDestroy(xImages);
+        if (!xImages) {
+            Log::logger->log(Log::WARN, "XCursor failed to find a shape with name {}, skipping", shape);
+            return nullptr;
         }
     }
 
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !m_defaultCursor)
-        m_defaultCursor = newCursors.front();
+    auto cursor = createCursor(shape, xImages);
+    XcursorImagesDestroy(xImages);
 
-    return newCursors;
+    cache.byFile[shape] = cursor;
+    return cursor;
 }
 
 void CXCursorManager::syncGsettings() {
@@ -622,7 +626,6 @@ void CXCursorManager::syncGsettings() {
         g_object_unref(gsettings);
     };
 
-    int unscaledSize = m_lastLoadSize / std::ceil(m_lastLoadScale);
     setValue("cursor-theme", m_themeName, "org.gnome.desktop.interface");
-    setValue("cursor-size", unscaledSize, "org.gnome.desktop.interface");
+    setValue("cursor-size", m_themeSize, "org.gnome.desktop.interface");
 }
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
 #include <array>
 #include <cstdint>
 #include <hyprutils/math/Vector2D.hpp>
@@ -30,16 +31,30 @@ class CXCursorManager {
     void          syncGsettings();
 
   private:
-    SP<SXCursors>              createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
-    std::set<std::string>      themePaths(std::string const& theme);
-    std::string                getLegacyShapeName(std::string const& shape);
-    std::vector<SP<SXCursors>> loadStandardCursors(std::string const& name, int size);
-    std::vector<SP<SXCursors>> loadAllFromDir(std::string const& path, int size);
-
-    int                        m_lastLoadSize  = 0;
-    float                      m_lastLoadScale = 0;
-    std::string                m_themeName     = "";
-    SP<SXCursors>              m_defaultCursor;
-    SP<SXCursors>              m_hyprCursor;
-    std::vector<SP<SXCursors>> m_cursors;
+    // one per pixel size, shapes are only read from disk the first time they're asked for
+    struct SSizeCache {
+        std::unordered_map<std::string, SP<SXCursors>> byShape; // only shapes the theme has, a missing one is looked for again
+        std::unordered_map<std::string, SP<SXCursors>> byFile;  // canonical path, so aliases share pixels
+        SP<SXCursors>                                  defaultCursor;
+    };
+
+    struct STheme {
+        std::vector<std::string>            paths; // empty: ask libXcursor for the standard shapes
+        std::unordered_map<int, SSizeCache> sizes;
+    };
+
+    STheme&                                 themeFor(std::string const& name);
+    SSizeCache&                             sizeCacheFor(std::string const& name, int size);
+    SP<SXCursors>                           loadShape(std::string const& themeName, STheme& theme, SSizeCache& cache, std::string const& shape, int size);
+    SP<SXCursors>                           loadStandardCursor(std::string const& themeName, SSizeCache& cache, std::string const& shape, int size);
+    SP<SXCursors>                           loadFromFile(std::string const& path, std::string const& shape, int size);
+    SP<SXCursors>                           createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
+    std::set<std::string>                   themePaths(std::string const& theme);
+    std::string                             getLegacyShapeName(std::string const& shape);
+
+    int                                     m_themeSize  = 0;
+    float                                   m_themeScale = 0;
+    std::string                             m_themeName  = "default";
+    SP<SXCursors>                           m_hyprCursor;
+    std::unordered_map<std::string, STheme> m_themes;
 };
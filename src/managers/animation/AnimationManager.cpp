@@ -66,6 +66,24 @@ static void updateColorVariable(CAnimatedVariable<CHyprColor>& av, const float P
     av.value() = {lerped, lerp(av.begun().a, av.goal().a, POINTY)};
 }
 
+// av.getPercent(), but at the time the frame being rendered gets presented rather than now
+template <Animable VarType>
+static float sampledPercent(CAnimatedVariable<VarType>& av) {
+    const auto PERCENT = av.getPercent();
+    const auto LEAD    = g_pAnimationManager->m_sampleLead;
+
+    if (PERCENT >= 1.F || LEAD.count() <= 0)
+        return PERCENT;
+
+    const auto PCONFIG = av.getConfig().lock();
+    const auto PVALUES = PCONFIG ? PCONFIG->pValues.lock() : nullptr;
+    if (!PVALUES || PVALUES->internalSpeed <= 0.F)
+        return PERCENT;
+
+    // speed is in units of 100ms
+    return std::clamp(PERCENT + (LEAD.count() / 1000.F) / (PVALUES->internalSpeed * 100.F), 0.F, 1.F);
+}
+
 template <Animable VarType>
 static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
     PHLWINDOW    PWINDOW            = av.m_Context.pWindow.lock();
@@ -100,8 +118,9 @@ static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
             g_pHyprRenderer->damageMonitor(PMONITOR);
 
         // TODO: just make this into a damn callback already vax...
-        for (auto const& w : g_pCompositor->m_windows) {
-            if (!w->m_isMapped || w->isHidden() || w->m_workspace != PWORKSPACE)
+        for (auto const& e : g_pCompositor->windowsOnWorkspace(PWORKSPACE->m_id)) {
+            const auto w = e.window.lock();
+            if (!w || !w->m_isMapped || w->isHidden() || w->m_workspace != PWORKSPACE)
                 continue;
 
             if (w->m_isFloating && !w->m_pinned) {
@@ -118,7 +137,8 @@ static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
         }
 
         // damage any workspace window that is on any monitor
-        for (auto const& w : g_pCompositor->m_windows) {
+        for (auto const& e : g_pCompositor->windowsOnWorkspace(PWORKSPACE->m_id)) {
+            const auto w = e.window.lock();
             if (!validMapped(w) || w->m_workspace != PWORKSPACE || w->m_pinned)
                 continue;
 
@@ -136,7 +156,7 @@ static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
         animationsDisabled = animationsDisabled || PLAYER->m_ruleApplicator->noanim().valueOrDefault();
     }
 
-    const auto SPENT   = av.getPercent();
+    const auto SPENT   = sampledPercent(av);
     const auto PBEZIER = g_pAnimationManager->getBezier(av.getBezierName());
     const auto POINTY  = PBEZIER->getYForPoint(SPENT);
     const bool WARP    = animationsDisabled || SPENT >= 1.f;
@@ -154,7 +174,8 @@ static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
                 PWINDOW->updateWindowDecos();
                 g_pHyprRenderer->damageWindow(PWINDOW);
             } else if (PWORKSPACE) {
-                for (auto const& w : g_pCompositor->m_windows) {
+                for (auto const& e : g_pCompositor->windowsOnWorkspace(PWORKSPACE->m_id)) {
+                    const auto w = e.window.lock();
                     if (!validMapped(w) || w->m_workspace != PWORKSPACE)
                         continue;
 
@@ -210,9 +231,10 @@ void CHyprAnimationManager::tick() {
     static auto PANIMENABLED = CConfigValue<Hyprlang::INT>("animations:enabled");
 
     if (!m_vActiveAnimatedVariables.empty()) {
-        const auto CPY = m_vActiveAnimatedVariables;
+        // updates can add or remove active vars, so walk a copy. Keep its storage around, we tick a lot.
+        m_tickVariables.assign(m_vActiveAnimatedVariables.begin(), m_vActiveAnimatedVariables.end());
 
-        for (const auto& PAV : CPY) {
+        for (const auto& PAV : m_tickVariables) {
             if (!PAV)
                 continue;
 
@@ -238,12 +260,31 @@ void CHyprAnimationManager::tick() {
                 default: UNREACHABLE();
             }
         }
+
+        m_tickVariables.clear();
     }
 
     tickDone();
 }
 
-void CHyprAnimationManager::frameTick() {
+// time from now until the next vblank of pMonitor, which is when the frame we're about to render gets presented
+static std::chrono::microseconds presentationLead(PHLMONITOR pMonitor) {
+    // with vrr the next presentation is whenever we commit, so there is nothing to predict
+    if (pMonitor->m_refreshRate <= 0.F || pMonitor->m_vrrActive || pMonitor->m_lastPresentedAt == Time::steady_tp{})
+        return {};
+
+    const auto INTERVAL = std::chrono::microseconds(sc<int64_t>(1000000.F / pMonitor->m_refreshRate));
+    const auto NOW      = Time::steadyNow();
+    auto       next     = pMonitor->m_lastPresentedAt + INTERVAL;
+
+    // the output might've been idle for a while, vblanks keep coming in whole intervals
+    if (next < NOW)
+        next += ((NOW - next) / INTERVAL + 1) * INTERVAL;
+
+    return std::clamp(std::chrono::duration_cast<std::chrono::microseconds>(next - NOW), std::chrono::microseconds{0}, INTERVAL);
+}
+
+void CHyprAnimationManager::frameTick(PHLMONITOR pMonitor) {
     onTicked();
 
     if (!shouldTickForNext())
@@ -257,6 +298,12 @@ void CHyprAnimationManager::frameTick() {
         m_lastTickTimer.reset();
         m_lastTickValid = true;
 
+        // monitors present at different times, so don't let a later tick sample before an earlier one did
+        const auto NOW    = Time::steadyNow();
+        const auto SAMPLE = std::max(m_lastSample, NOW + (pMonitor ? presentationLead(pMonitor) : std::chrono::microseconds{0}));
+        m_lastSample      = SAMPLE;
+        m_sampleLead      = std::chrono::duration_cast<std::chrono::microseconds>(SAMPLE - NOW);
+
         tick();
         EMIT_HOOK_EVENT("tick", nullptr);
     }
@@ -276,7 +323,39 @@ void CHyprAnimationManager::scheduleTick() {
         return;
     }
 
-    m_animationTimer->updateTimeout(std::chrono::milliseconds(1));
+    const auto PMONITOR = tickingMonitor();
+    if (!PMONITOR) {
+        // nothing is presenting, tick off the timer alone
+        m_animationTimer->updateTimeout(std::chrono::milliseconds(1));
+        return;
+    }
+
+    const auto INTERVAL = std::chrono::microseconds(sc<int64_t>(1000000.F / PMONITOR->m_refreshRate));
+
+    // we haven't ticked in over a frame, so an animation is just starting. Don't make it wait for a vblank.
+    if (!m_lastTickValid || std::chrono::microseconds(sc<int64_t>(m_lastTickTimer.getMillis() * 1000.F)) >= INTERVAL) {
+        m_animationTimer->updateTimeout(std::chrono::milliseconds(1));
+        return;
+    }
+
+    // otherwise the renderer ticks us at the start of every frame, and ticks damage what they animate,
+    // which schedules those frames. The timer only fires if no frame comes in time, e.g. when nothing
+    // that's animating is visible.
+    m_animationTimer->updateTimeout(presentationLead(PMONITOR) + INTERVAL / 2);
+}
+
+PHLMONITOR CHyprAnimationManager::tickingMonitor() {
+    PHLMONITOR best = nullptr;
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        if (!m->m_enabled || !m->m_output || !m->m_dpmsStatus || m->m_isBeingLeased || m->m_refreshRate <= 0.F)
+            continue;
+
+        if (!best || m->m_refreshRate > best->m_refreshRate)
+            best = m;
+    }
+
+    return best;
 }
 
 void CHyprAnimationManager::onTicked() {
@@ -14,7 +14,7 @@ class CHyprAnimationManager : public Hyprutils::Animation::CAnimationManager {
     CHyprAnimationManager();
 
     void         tick();
-    void         frameTick();
+    void         frameTick(PHLMONITOR pMonitor = nullptr);
     virtual void scheduleTick();
     virtual void onTicked();
 
@@ -51,10 +51,18 @@ class CHyprAnimationManager : public Hyprutils::Animation::CAnimationManager {
 
     float               m_lastTickTimeMs;
 
+    // how long until the frame being rendered is presented. Animations are sampled that far ahead.
+    std::chrono::microseconds m_sampleLead = {};
+
   private:
-    bool   m_tickScheduled = false;
-    bool   m_lastTickValid = false;
-    CTimer m_lastTickTimer;
+    PHLMONITOR                           tickingMonitor();
+
+    bool                                 m_tickScheduled = false;
+    bool                                 m_lastTickValid = false;
+    CTimer                               m_lastTickTimer;
+    Time::steady_tp                      m_lastSample; // the point in time the last tick sampled at
+
+    decltype(m_vActiveAnimatedVariables) m_tickVariables; // reused across ticks
 };
 
 inline UP<CHyprAnimationManager> g_pAnimationManager;
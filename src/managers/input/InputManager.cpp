@@ -45,6 +45,7 @@
 
 #include "trackpad/TrackpadGestures.hpp"
 #include "../cursor/CursorShapeOverrideController.hpp"
+#include "../../debug/FrameProfiler.hpp"
 
 #include <aquamarine/input/Input.hpp>
 
@@ -110,6 +111,8 @@ CInputManager::~CInputManager() {
 }
 
 void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
+    PROFILER_ZONE(PROFILER_STAGE_INPUT, "MouseMoved");
+
     static auto PNOACCEL = CConfigValue<Hyprlang::INT>("input:force_no_accel");
 
     Vector2D    delta   = e.delta;
@@ -646,6 +649,8 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
 }
 
 void CInputManager::onMouseButton(IPointer::SButtonEvent e) {
+    PROFILER_ZONE(PROFILER_STAGE_INPUT, "MouseButton");
+
     EMIT_HOOK_EVENT_CANCELLABLE("mouseButton", e);
 
     if (e.mouse)
@@ -852,6 +857,8 @@ void CInputManager::processMouseDownKill(const IPointer::SButtonEvent& e) {
 }
 
 void CInputManager::onMouseWheel(IPointer::SAxisEvent e, SP<IPointer> pointer) {
+    PROFILER_ZONE(PROFILER_STAGE_INPUT, "MouseWheel");
+
     static auto POFFWINDOWAXIS        = CConfigValue<Hyprlang::INT>("input:off_window_axis_events");
     static auto PINPUTSCROLLFACTOR    = CConfigValue<Hyprlang::FLOAT>("input:scroll_factor");
     static auto PTOUCHPADSCROLLFACTOR = CConfigValue<Hyprlang::FLOAT>("input:touchpad:scroll_factor");
@@ -1453,6 +1460,8 @@ void CInputManager::updateKeyboardsLeds(SP<IKeyboard> pKeyboard) {
 }
 
 void CInputManager::onKeyboardKey(const IKeyboard::SKeyEvent& event, SP<IKeyboard> pKeyboard) {
+    PROFILER_ZONE(PROFILER_STAGE_INPUT, "KeyboardKey");
+
     if (!pKeyboard->m_enabled || !pKeyboard->m_allowed)
         return;
 
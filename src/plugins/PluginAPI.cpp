@@ -84,7 +84,7 @@ APICALL bool HyprlandAPI::removeLayout(HANDLE handle, IHyprLayout* layout) {
 }
 
 APICALL bool HyprlandAPI::reloadConfig() {
-    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(); });
+    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(true); });
     return true;
 }
 
@@ -133,7 +133,7 @@ std::expected<CPlugin*, std::string> CPluginSystem::loadPluginInternal(const std
     PLUGIN->m_version     = PLUGINDATA.version;
     PLUGIN->m_name        = PLUGINDATA.name;
 
-    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(); });
+    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(true); });
 
     Log::logger->log(Log::DEBUG, R"( [PluginSystem] Plugin {} loaded. Handle: {:x}, path: "{}", author: "{}", description: "{}", version: "{}")", PLUGINDATA.name,
                      rc<uintptr_t>(MODULE), path, PLUGINDATA.author, PLUGINDATA.description, PLUGINDATA.version);
@@ -188,7 +188,7 @@ void CPluginSystem::unloadPlugin(const CPlugin* plugin, bool eject) {
     Log::logger->log(Log::DEBUG, " [PluginSystem] Plugin {} unloaded.", PLNAME);
 
     // reload config to fix some stuf like e.g. unloadedPluginVars
-    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(); });
+    g_pEventLoopManager->doLater([] { g_pConfigManager->reload(true); });
 }
 
 void CPluginSystem::unloadAllPlugins() {
@@ -0,0 +1,99 @@
+#include "ImageCaptureSource.hpp"
+#include "ForeignToplevel.hpp"
+#include "core/Output.hpp"
+#include "../helpers/Monitor.hpp"
+
+CImageCaptureSource::CImageCaptureSource(SP<CExtImageCaptureSourceV1> resource_, PHLMONITOR pMonitor) :
+    m_kind(IMAGE_CAPTURE_SOURCE_OUTPUT), m_monitor(pMonitor), m_resource(resource_) {
+    init();
+}
+
+CImageCaptureSource::CImageCaptureSource(SP<CExtImageCaptureSourceV1> resource_, PHLWINDOW pWindow) :
+    m_kind(IMAGE_CAPTURE_SOURCE_TOPLEVEL), m_window(pWindow), m_resource(resource_) {
+    init();
+}
+
+void CImageCaptureSource::init() {
+    if UNLIKELY (!good())
+        return;
+
+    m_resource->setData(this);
+
+    auto& proto = m_kind == IMAGE_CAPTURE_SOURCE_OUTPUT ? PROTO::outputImageCaptureSource : PROTO::toplevelImageCaptureSource;
+
+    m_resource->setDestroy([this, &proto](CExtImageCaptureSourceV1* r) { proto->destroyResource(this); });
+    m_resource->setOnDestroy([this, &proto](CExtImageCaptureSourceV1* r) { proto->destroyResource(this); });
+}
+
+SP<CImageCaptureSource> CImageCaptureSource::fromResource(wl_resource* res) {
+    auto data = sc<CImageCaptureSource*>(sc<CExtImageCaptureSourceV1*>(wl_resource_get_user_data(res))->data());
+    return data ? data->m_self.lock() : nullptr;
+}
+
+bool CImageCaptureSource::good() {
+    return m_resource->resource();
+}
+
+CImageCaptureSourceProtocol::CImageCaptureSourceProtocol(const wl_interface* iface, const int& ver, const std::string& name, eImageCaptureSourceKind kind) :
+    IWaylandProtocol(iface, ver, name), m_kind(kind) {
+    ;
+}
+
+void CImageCaptureSourceProtocol::bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id) {
+    if (m_kind == IMAGE_CAPTURE_SOURCE_OUTPUT) {
+        const auto RESOURCE = m_outputManagers.emplace_back(makeShared<CExtOutputImageCaptureSourceManagerV1>(client, ver, id));
+
+        if UNLIKELY (!RESOURCE->resource()) {
+            wl_client_post_no_memory(client);
+            m_outputManagers.pop_back();
+            return;
+        }
+
+        RESOURCE->setDestroy([this](CExtOutputImageCaptureSourceManagerV1* r) { destroyResource(r); });
+        RESOURCE->setOnDestroy([this](CExtOutputImageCaptureSourceManagerV1* r) { destroyResource(r); });
+        RESOURCE->setCreateSource([this](CExtOutputImageCaptureSourceManagerV1* r, uint32_t id, wl_resource* output) {
+            const auto OUTPUT = CWLOutputResource::fromResource(output);
+            createSource(r->client(), r->version(), id, OUTPUT ? OUTPUT->m_monitor.lock() : nullptr);
+        });
+        return;
+    }
+
+    const auto RESOURCE = m_toplevelManagers.emplace_back(makeShared<CExtForeignToplevelImageCaptureSourceManagerV1>(client, ver, id));
+
+    if UNLIKELY (!RESOURCE->resource()) {
+        wl_client_post_no_memory(client);
+        m_toplevelManagers.pop_back();
+        return;
+    }
+
+    RESOURCE->setDestroy([this](CExtForeignToplevelImageCaptureSourceManagerV1* r) { destroyResource(r); });
+    RESOURCE->setOnDestroy([this](CExtForeignToplevelImageCaptureSourceManagerV1* r) { destroyResource(r); });
+    RESOURCE->setCreateSource([this](CExtForeignToplevelImageCaptureSourceManagerV1* r, uint32_t id, wl_resource* handle) {
+        createSource(r->client(), r->version(), id, PROTO::foreignToplevel->windowFromHandleResource(handle));
+    });
+}
+
+template <typename T>
+void CImageCaptureSourceProtocol::createSource(wl_client* client, uint32_t version, uint32_t id, T target) {
+    const auto SOURCE = m_sources.emplace_back(makeShared<CImageCaptureSource>(makeShared<CExtImageCaptureSourceV1>(client, version, id), target));
+
+    if UNLIKELY (!SOURCE->good()) {
+        wl_client_post_no_memory(client);
+        m_sources.pop_back();
+        return;
+    }
+
+    SOURCE->m_self = SOURCE;
+}
+
+void CImageCaptureSourceProtocol::destroyResource(CExtOutputImageCaptureSourceManagerV1* manager) {
+    std::erase_if(m_outputManagers, [&](const auto& other) { return other.get() == manager; });
+}
+
+void CImageCaptureSourceProtocol::destroyResource(CExtForeignToplevelImageCaptureSourceManagerV1* manager) {
+    std::erase_if(m_toplevelManagers, [&](const auto& other) { return other.get() == manager; });
+}
+
+void CImageCaptureSourceProtocol::destroyResource(CImageCaptureSource* source) {
+    std::erase_if(m_sources, [&](const auto& other) { return other.get() == source; });
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "WaylandProtocol.hpp"
+#include "../desktop/DesktopTypes.hpp"
+#include "ext-image-capture-source-v1.hpp"
+
+enum eImageCaptureSourceKind : uint8_t {
+    IMAGE_CAPTURE_SOURCE_OUTPUT = 0,
+    IMAGE_CAPTURE_SOURCE_TOPLEVEL,
+};
+
+class CImageCaptureSource {
+  public:
+    CImageCaptureSource(SP<CExtImageCaptureSourceV1> resource_, PHLMONITOR pMonitor);
+    CImageCaptureSource(SP<CExtImageCaptureSourceV1> resource_, PHLWINDOW pWindow);
+
+    static SP<CImageCaptureSource> fromResource(wl_resource* res);
+
+    bool                           good();
+
+    WP<CImageCaptureSource>        m_self;
+
+    eImageCaptureSourceKind        m_kind = IMAGE_CAPTURE_SOURCE_OUTPUT;
+    // depending on the kind. Either can be gone already, sessions made from this are stopped then.
+    PHLMONITORREF m_monitor;
+    PHLWINDOWREF  m_window;
+
+  private:
+    SP<CExtImageCaptureSourceV1> m_resource;
+
+    void                         init();
+};
+
+// one instance per kind, each is its own global
+class CImageCaptureSourceProtocol : public IWaylandProtocol {
+  public:
+    CImageCaptureSourceProtocol(const wl_interface* iface, const int& ver, const std::string& name, eImageCaptureSourceKind kind);
+
+    virtual void bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id);
+
+  private:
+    void                                                            destroyResource(CExtOutputImageCaptureSourceManagerV1* manager);
+    void                                                            destroyResource(CExtForeignToplevelImageCaptureSourceManagerV1* manager);
+    void                                                            destroyResource(CImageCaptureSource* source);
+
+    template <typename T>
+    void                                                            createSource(wl_client* client, uint32_t version, uint32_t id, T target);
+
+    eImageCaptureSourceKind                                         m_kind;
+
+    std::vector<SP<CExtOutputImageCaptureSourceManagerV1>>          m_outputManagers;
+    std::vector<SP<CExtForeignToplevelImageCaptureSourceManagerV1>> m_toplevelManagers;
+    std::vector<SP<CImageCaptureSource>>                            m_sources;
+
+    friend class CImageCaptureSource;
+};
+
+namespace PROTO {
+    inline UP<CImageCaptureSourceProtocol> outputImageCaptureSource;
+    inline UP<CImageCaptureSourceProtocol> toplevelImageCaptureSource;
+};
@@ -0,0 +1,861 @@
+#include "ImageCopyCapture.hpp"
+#include "../Compositor.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../managers/PointerManager.hpp"
+#include "../managers/SeatManager.hpp"
+#include "../managers/input/InputManager.hpp"
+#include "../managers/permissions/DynamicPermissionManager.hpp"
+#include "../render/Renderer.hpp"
+#include "../render/OpenGL.hpp"
+#include "../render/AsyncReadback.hpp"
+#include "../helpers/Monitor.hpp"
+#include "../helpers/Format.hpp"
+#include "types/WLBuffer.hpp"
+#include "ColorManagement.hpp"
+#include "LinuxDMABUF.hpp"
+#include "Screencopy.hpp"
+
+#include <algorithm>
+
+CImageCopyCaptureSession::CImageCopyCaptureSession(SP<CExtImageCopyCaptureSessionV1> resource_, SP<CImageCaptureSource> source, bool paintCursors, bool cursor) :
+    m_resource(resource_), m_paintCursors(paintCursors), m_cursor(cursor) {
+    if UNLIKELY (!good())
+        return;
+
+    m_resource->setDestroy([this](CExtImageCopyCaptureSessionV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setOnDestroy([this](CExtImageCopyCaptureSessionV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setCreateFrame([this](CExtImageCopyCaptureSessionV1* r, uint32_t id) {
+        if UNLIKELY (m_frame) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_SESSION_V1_ERROR_DUPLICATE_FRAME, "session already has a frame");
+            return;
+        }
+
+        const auto FRAME = PROTO::imageCopyCapture->m_frames.emplace_back(
+            makeShared<CImageCopyCaptureFrame>(makeShared<CExtImageCopyCaptureFrameV1>(r->client(), r->version(), id), m_self.lock()));
+
+        if UNLIKELY (!FRAME->good()) {
+            r->noMemory();
+            PROTO::imageCopyCapture->m_frames.pop_back();
+            return;
+        }
+
+        FRAME->m_self = FRAME;
+        m_frame       = FRAME;
+    });
+
+    if (!source) {
+        stop();
+        return;
+    }
+
+    m_kind    = source->m_kind;
+    m_monitor = source->m_monitor;
+    m_window  = source->m_window;
+
+    if (!updateConstraints())
+        stop();
+}
+
+bool CImageCopyCaptureSession::good() {
+    return m_resource->resource();
+}
+
+wl_client* CImageCopyCaptureSession::client() {
+    return m_resource ? m_resource->client() : nullptr;
+}
+
+PHLMONITOR CImageCopyCaptureSession::monitor() {
+    if (m_stopped)
+        return nullptr;
+
+    if (m_kind == IMAGE_CAPTURE_SOURCE_TOPLEVEL)
+        return validMapped(m_window) ? m_window->m_monitor.lock() : nullptr;
+
+    const auto PMONITOR = m_monitor.lock();
+    return g_pCompositor->monitorExists(PMONITOR) ? PMONITOR : nullptr;
+}
+
+bool CImageCopyCaptureSession::updateConstraints() {
+    const auto PMONITOR = monitor();
+    if (!PMONITOR)
+        return false;
+
+    CBox box = {{}, PMONITOR->m_pixelSize};
+    if (m_cursor) {
+        // drawn at 0,0 of the monitor like a toplevel. Never empty, a hidden cursor is a transparent pixel.
+        const auto SIZE = g_pPointerManager->cursorSizeLogical() * PMONITOR->m_scale;
+        box             = {0, 0, std::max(sc<int>(SIZE.x), 1), std::max(sc<int>(SIZE.y), 1)};
+        box.transform(Math::wlTransformToHyprutils(PMONITOR->m_transform), PMONITOR->m_transformedSize.x, PMONITOR->m_transformedSize.y);
+    } else if (m_kind == IMAGE_CAPTURE_SOURCE_TOPLEVEL) {
+        const auto PWINDOW = m_window.lock();
+        box                = {0, 0, sc<int>(PWINDOW->m_realSize->value().x * PMONITOR->m_scale), sc<int>(PWINDOW->m_realSize->value().y * PMONITOR->m_scale)};
+        box.transform(Math::wlTransformToHyprutils(PMONITOR->m_transform), PMONITOR->m_transformedSize.x, PMONITOR->m_transformedSize.y);
+    }
+    box.round();
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // a cursor without its alpha is of no use
+    auto shmFormat = m_cursor ? DRM_FORMAT_ARGB8888 : g_pHyprOpenGL->getPreferredReadFormat(PMONITOR);
+    if (shmFormat == DRM_FORMAT_INVALID) {
+        LOGM(Log::ERR, "No format supported by renderer in capture session");
+        return false;
+    }
+
+    // TODO: hack, we can't bit flip so we'll format flip heh, GL_BGRA_EXT won't work here
+    if (shmFormat == DRM_FORMAT_XRGB2101010 || shmFormat == DRM_FORMAT_ARGB2101010)
+        shmFormat = DRM_FORMAT_XBGR2101010;
+
+    const auto DMABUFFORMAT = m_cursor ? DRM_FORMAT_ARGB8888 : g_pHyprOpenGL->getPreferredReadFormat(PMONITOR);
+
+    if (box.size() == m_box.size() && shmFormat == m_shmFormat && DMABUFFORMAT == m_dmabufFormat)
+        return true;
+
+    m_box          = box;
+    m_shmFormat    = shmFormat;
+    m_dmabufFormat = DMABUFFORMAT;
+
+    // whatever the client has is of no use anymore
+    m_damage = CBox{{}, m_box.size()};
+
+    sendConstraints();
+
+    return true;
+}
+
+void CImageCopyCaptureSession::sendConstraints() {
+    m_resource->sendBufferSize(m_box.w, m_box.h);
+    m_resource->sendShmFormat(NFormatUtils::drmToShm(m_shmFormat));
+
+    if (m_dmabufFormat != DRM_FORMAT_INVALID && PROTO::linuxDma) {
+        auto            mainDevice = PROTO::linuxDma->m_mainDevice;
+
+        struct wl_array deviceArr = {
+            .size = sizeof(mainDevice),
+            .data = sc<void*>(&mainDevice),
+        };
+        m_resource->sendDmabufDevice(&deviceArr);
+
+        wl_array modifiers;
+        wl_array_init(&modifiers);
+
+        for (auto const& fmt : g_pHyprOpenGL->getDRMFormats()) {
+            if (fmt.drmFormat != m_dmabufFormat)
+                continue;
+
+            for (auto const& mod : fmt.modifiers) {
+                *sc<uint64_t*>(wl_array_add(&modifiers, sizeof(uint64_t))) = mod;
+            }
+        }
+
+        m_resource->sendDmabufFormat(m_dmabufFormat, &modifiers);
+
+        wl_array_release(&modifiers);
+    }
+
+    m_resource->sendDone();
+}
+
+void CImageCopyCaptureSession::accumulateDamage(bool committed) {
+    const auto PMONITOR = monitor();
+    if (!PMONITOR)
+        return;
+
+    // the cursor image only changes with the cursor, see onCursorChanged()
+    if (m_cursor)
+        return;
+
+    const CBox FULL = {{}, m_box.size()};
+
+    // the monitor's damage only maps onto the buffer of an untransformed output, anything else changes whole on every commit
+    if (!capturesOutput() || PMONITOR->m_transform != WL_OUTPUT_TRANSFORM_NORMAL) {
+        if (committed)
+            m_damage = FULL;
+        return;
+    }
+
+    m_damage.add(PMONITOR->m_damage.getDamageSince(m_monitorFrames));
+    m_monitorFrames = PMONITOR->m_damage.frames();
+
+    if (m_paintCursors) {
+        const auto CURSORBOX = g_pPointerManager->getCursorBoxLogicalForMonitor(PMONITOR).scale(PMONITOR->m_scale).expand(1).round();
+
+        if (CURSORBOX != m_lastCursorBox) {
+            m_damage.add(m_lastCursorBox).add(CURSORBOX);
+            m_lastCursorBox = CURSORBOX;
+        }
+    }
+
+    m_damage.intersect(FULL);
+}
+
+bool CImageCopyCaptureSession::capturesOutput() {
+    return m_kind == IMAGE_CAPTURE_SOURCE_OUTPUT && !m_cursor;
+}
+
+void CImageCopyCaptureSession::stop() {
+    if (m_stopped)
+        return;
+
+    m_stopped = true;
+
+    if (m_frame && m_frame->m_captured && !m_frame->m_done)
+        m_frame->fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED);
+
+    m_resource->sendStopped();
+}
+
+CImageCopyCaptureFrame::CImageCopyCaptureFrame(SP<CExtImageCopyCaptureFrameV1> resource_, SP<CImageCopyCaptureSession> session) : m_resource(resource_), m_session(session) {
+    if UNLIKELY (!good())
+        return;
+
+    m_resource->setDestroy([this](CExtImageCopyCaptureFrameV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setOnDestroy([this](CExtImageCopyCaptureFrameV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setAttachBuffer([this](CExtImageCopyCaptureFrameV1* r, wl_resource* buffer) {
+        if UNLIKELY (m_captured) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_ERROR_ALREADY_CAPTURED, "frame already captured");
+            return;
+        }
+
+        const auto PBUFFER = CWLBufferResource::fromResource(buffer);
+        m_buffer           = PBUFFER ? CHLBufferReference(PBUFFER->m_buffer.lock()) : CHLBufferReference();
+    });
+    m_resource->setDamageBuffer([this](CExtImageCopyCaptureFrameV1* r, int32_t x, int32_t y, int32_t w, int32_t h) {
+        if UNLIKELY (m_captured) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_ERROR_ALREADY_CAPTURED, "frame already captured");
+            return;
+        }
+
+        if UNLIKELY (x < 0 || y < 0 || w <= 0 || h <= 0) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_ERROR_INVALID_BUFFER_DAMAGE, "invalid buffer damage");
+            return;
+        }
+
+        m_bufferDamage.add(CBox{x, y, w, h});
+    });
+    m_resource->setCapture([this](CExtImageCopyCaptureFrameV1* r) { capture(); });
+}
+
+bool CImageCopyCaptureFrame::good() {
+    return m_resource->resource();
+}
+
+void CImageCopyCaptureFrame::capture() {
+    if UNLIKELY (m_captured) {
+        m_resource->error(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_ERROR_ALREADY_CAPTURED, "frame already captured");
+        return;
+    }
+
+    if UNLIKELY (!m_buffer) {
+        m_resource->error(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_ERROR_NO_BUFFER, "no buffer attached");
+        return;
+    }
+
+    m_captured = true;
+
+    const auto SESSION = m_session.lock();
+
+    if (SESSION && !SESSION->m_stopped && !SESSION->updateConstraints())
+        SESSION->stop(); // fails us
+
+    if (!SESSION || SESSION->m_stopped) {
+        if (!m_done)
+            fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED);
+        return;
+    }
+
+    if (!bufferFits()) {
+        fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_BUFFER_CONSTRAINTS);
+        return;
+    }
+
+    // something changed since the last frame already, no need to wait for the next commit
+    SESSION->accumulateDamage(false);
+    if (shouldShare(SESSION->monitor())) {
+        share();
+        return;
+    }
+
+    PROTO::imageCopyCapture->m_framesAwaitingCapture.emplace_back(m_self);
+}
+
+bool CImageCopyCaptureFrame::bufferFits() {
+    const auto SESSION = m_session.lock();
+
+    if (!SESSION || !m_buffer || m_buffer->size != SESSION->m_box.size())
+        return false;
+
+    if (auto attrs = m_buffer->dmabuf(); attrs.success) {
+        m_bufferDMA = true;
+        return attrs.format == SESSION->m_dmabufFormat;
+    }
+
+    if (auto attrs = m_buffer->shm(); attrs.success) {
+        m_bufferDMA        = false;
+        const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(attrs.format);
+        return attrs.format == SESSION->m_shmFormat && PFORMAT && attrs.stride >= NFormatUtils::minStride(PFORMAT, SESSION->m_box.w);
+    }
+
+    return false;
+}
+
+bool CImageCopyCaptureFrame::shouldShare(PHLMONITOR pMonitor) {
+    const auto SESSION = m_session.lock();
+
+    if (!SESSION || !pMonitor || SESSION->monitor() != pMonitor)
+        return false;
+
+    // pending an answer, don't do anything yet. If it's denied, it will be black.
+    if (g_pDynamicPermissionManager->clientPermissionMode(m_resource->client(), PERMISSION_TYPE_SCREENCOPY) == PERMISSION_RULE_ALLOW_MODE_PENDING)
+        return false;
+
+    return !SESSION->m_damage.empty();
+}
+
+void CImageCopyCaptureFrame::share() {
+    const auto SESSION  = m_session.lock();
+    const auto PMONITOR = SESSION ? SESSION->monitor() : nullptr;
+
+    if (!PMONITOR) {
+        fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED);
+        return;
+    }
+
+    if (!bufferFits()) {
+        fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_BUFFER_CONSTRAINTS);
+        return;
+    }
+
+    const auto NOW       = Time::steadyNow();
+    const auto TRANSFORM = PMONITOR->m_transform;
+    const CBox FULL      = {{}, SESSION->m_box.size()};
+
+    m_damage = SESSION->m_damage;
+    SESSION->m_damage.clear();
+
+    // only redraw what changed since this buffer was last filled, if the damage maps onto it
+    CRegion damage = {0, 0, INT16_MAX, INT16_MAX};
+    if (SESSION->capturesOutput() && TRANSFORM == WL_OUTPUT_TRANSFORM_NORMAL) {
+        damage = m_damage.copy().add(m_bufferDamage).intersect(FULL);
+
+        // shm is read back in whole rows
+        if (!m_bufferDMA) {
+            const auto EXTENTS = damage.getExtents();
+            damage             = CBox{0, EXTENTS.y, FULL.w, EXTENTS.h};
+        }
+    }
+
+    auto callback = [this, weak = m_self, NOW, TRANSFORM](bool success) {
+        if (weak.expired())
+            return;
+
+        if (!success) {
+            LOGM(Log::ERR, "{} copy failed in {:x}", m_bufferDMA ? "Dmabuf" : "Shm", (uintptr_t)this);
+
+            // what we took from the session was never delivered
+            if (const auto SESSION = m_session.lock())
+                SESSION->m_damage.add(m_damage);
+
+            fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_UNKNOWN);
+            return;
+        }
+
+        sendReady(NOW, TRANSFORM);
+    };
+
+    const bool OVERLAYCURSOR = shouldOverlayCursor();
+
+    if (OVERLAYCURSOR) {
+        g_pPointerManager->lockSoftwareForMonitor(PMONITOR);
+        g_pPointerManager->damageCursor(PMONITOR);
+    }
+
+    if (m_bufferDMA)
+        copyDmabuf(damage, callback);
+    else
+        copyShm(damage, callback);
+
+    if (OVERLAYCURSOR) {
+        g_pPointerManager->unlockSoftwareForMonitor(PMONITOR);
+        g_pPointerManager->damageCursor(PMONITOR);
+    }
+}
+
+void CImageCopyCaptureFrame::renderContents(PHLMONITOR pMonitor, const Time::steady_tp& now) {
+    const auto SESSION = m_session.lock();
+    const auto PERM    = g_pDynamicPermissionManager->clientPermissionMode(m_resource->client(), PERMISSION_TYPE_SCREENCOPY);
+
+    if (PERM != PERMISSION_RULE_ALLOW_MODE_ALLOW) {
+        g_pHyprOpenGL->clear(Colors::BLACK);
+        CBox texbox = CBox{pMonitor->m_transformedSize / 2.F, g_pHyprOpenGL->m_screencopyDeniedTexture->m_size}.translate(-g_pHyprOpenGL->m_screencopyDeniedTexture->m_size / 2.F);
+        g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_screencopyDeniedTexture, texbox, {});
+        return;
+    }
+
+    if (SESSION->m_cursor) {
+        g_pHyprOpenGL->clear(CHyprColor(0, 0, 0, 0));
+
+        if (const auto TEX = g_pPointerManager->getCurrentCursorTexture(); TEX)
+            g_pHyprOpenGL->renderTexture(TEX, CBox{{}, g_pPointerManager->cursorSizeLogical() * pMonitor->m_scale}.round(), {});
+        return;
+    }
+
+    if (SESSION->capturesOutput()) {
+        const bool IS_CM_AWARE = PROTO::colorManagement && PROTO::colorManagement->isClientCMAware(m_resource->client());
+
+        NScreencopy::renderMonitor(pMonitor, SESSION->m_box, SESSION->m_paintCursors, IS_CM_AWARE);
+        return;
+    }
+
+    // render the client at 0,0
+    const auto PWINDOW = SESSION->m_window.lock();
+
+    g_pHyprOpenGL->clear(Colors::BLACK);
+
+    if (!PWINDOW->m_ruleApplicator->noScreenShare().valueOrDefault()) {
+        g_pHyprRenderer->m_bBlockSurfaceFeedback = g_pHyprRenderer->shouldRenderWindow(PWINDOW); // block the feedback to avoid spamming the surface if it's visible
+        g_pHyprRenderer->renderWindow(PWINDOW, pMonitor, now, false, RENDER_PASS_ALL, true, true);
+        g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
+    }
+
+    if (shouldOverlayCursor()) {
+        CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+        g_pPointerManager->renderSoftwareCursorsFor(pMonitor, now, fakeDamage, g_pInputManager->getMouseCoordsInternal() - PWINDOW->m_realPosition->value());
+    }
+}
+
+void CImageCopyCaptureFrame::copyDmabuf(const CRegion& damage, std::function<void(bool)> callback) {
+    const auto SESSION  = m_session.lock();
+    const auto PMONITOR = SESSION->monitor();
+
+    CRegion    renderDamage = damage;
+
+    if (!g_pHyprRenderer->beginRender(PMONITOR, renderDamage, RENDER_MODE_TO_BUFFER, m_buffer.m_buffer, nullptr, SESSION->capturesOutput())) {
+        LOGM(Log::ERR, "Can't copy: failed to begin rendering to dma frame");
+        callback(false);
+        return;
+    }
+
+    renderContents(PMONITOR, Time::steadyNow());
+
+    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+
+    g_pHyprRenderer->endRender([callback]() {
+        LOGM(Log::TRACE, "Copied frame via dma");
+        callback(true);
+    });
+}
+
+void CImageCopyCaptureFrame::copyShm(const CRegion& damage, std::function<void(bool)> callback) {
+    const auto SESSION   = m_session.lock();
+    const auto PMONITOR  = SESSION->monitor();
+    const bool IS_OUTPUT = SESSION->capturesOutput();
+    const auto BOX       = SESSION->m_box;
+    const auto ROWS      = damage.copy().intersect(CBox{{}, BOX.size()}).getExtents();
+
+    auto       shm = m_buffer->shm();
+
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
+    if (!PFORMAT) {
+        LOGM(Log::ERR, "Can't copy: failed to find a pixel format");
+        callback(false);
+        return;
+    }
+
+    if (ROWS.empty()) {
+        callback(true);
+        return;
+    }
+
+    CRegion renderDamage = damage;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // toplevels and the cursor are drawn where they'd be on the monitor and read back from there
+    auto& monData = g_pHyprOpenGL->m_monitorRenderResources[PMONITOR];
+    auto  fb      = monData.framebuffers.acquire(IS_OUTPUT ? BOX.size() : PMONITOR->m_pixelSize,
+                                                 SESSION->m_cursor ? DRM_FORMAT_ARGB8888 : PMONITOR->m_output->state->state().drmFormat);
+
+    if (!g_pHyprRenderer->beginRender(PMONITOR, renderDamage, RENDER_MODE_FULL_FAKE, nullptr, fb.get(), IS_OUTPUT)) {
+        LOGM(Log::ERR, "Can't copy: failed to begin rendering");
+        callback(false);
+        return;
+    }
+
+    renderContents(PMONITOR, Time::steadyNow());
+
+    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+    g_pHyprRenderer->endRender();
+
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pHyprOpenGL->m_renderData.pMonitor = PMONITOR;
+    fb->bind();
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->getFBID());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
+
+    auto origin = Vector2D(0, 0);
+    if (!IS_OUTPUT) {
+        switch (PMONITOR->m_transform) {
+            case WL_OUTPUT_TRANSFORM_FLIPPED_180:
+            case WL_OUTPUT_TRANSFORM_90: {
+                origin.y = PMONITOR->m_pixelSize.y - BOX.height;
+                break;
+            }
+            case WL_OUTPUT_TRANSFORM_FLIPPED_270:
+            case WL_OUTPUT_TRANSFORM_180: {
+                origin.x = PMONITOR->m_pixelSize.x - BOX.width;
+                origin.y = PMONITOR->m_pixelSize.y - BOX.height;
+                break;
+            }
+            case WL_OUTPUT_TRANSFORM_FLIPPED:
+            case WL_OUTPUT_TRANSFORM_270: {
+                origin.x = PMONITOR->m_pixelSize.x - BOX.width;
+                break;
+            }
+            default: break;
+        }
+    }
+
+    const auto FIRSTROW   = sc<uint32_t>(ROWS.y);
+    const auto ROWCOUNT   = sc<uint32_t>(ROWS.h);
+    const auto PACKSTRIDE = NFormatUtils::minStride(PFORMAT, BOX.w);
+
+    auto       onReadback = [this, weak = m_self, callback, PACKSTRIDE, FIRSTROW, ROWCOUNT](const uint8_t* data, uint32_t stride) {
+        if (weak.expired())
+            return;
+
+        if (!data) {
+            callback(false);
+            return;
+        }
+
+        auto shm                      = m_buffer->shm();
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+        CAsyncReadback::copyRows(pixelData + sc<size_t>(FIRSTROW) * shm.stride, shm.stride, data, stride, PACKSTRIDE, ROWCOUNT);
+
+        LOGM(Log::TRACE, "Copied frame via shm");
+
+        callback(true);
+    };
+
+    // only the damaged rows are read, the rest of the client's buffer is still good
+    const bool ASYNC = monData.captureReadback->read({origin.x, origin.y + FIRSTROW, BOX.w, ROWS.h}, glFormat, PFORMAT->glType, PACKSTRIDE, std::move(onReadback));
+
+    if (!ASYNC) {
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+        if (PACKSTRIDE == shm.stride)
+            glReadPixels(origin.x, origin.y + FIRSTROW, BOX.w, ROWCOUNT, glFormat, PFORMAT->glType, pixelData + sc<size_t>(FIRSTROW) * shm.stride);
+        else {
+            for (size_t i = 0; i < ROWCOUNT; ++i) {
+                glReadPixels(origin.x, origin.y + FIRSTROW + i, BOX.w, 1, glFormat, PFORMAT->glType, pixelData + (FIRSTROW + i) * shm.stride);
+            }
+        }
+    }
+
+    g_pHyprOpenGL->m_renderData.pMonitor.reset();
+
+    fb->unbind();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    if (ASYNC)
+        return;
+
+    LOGM(Log::TRACE, "Copied frame via shm");
+
+    callback(true);
+}
+
+bool CImageCopyCaptureFrame::shouldOverlayCursor() {
+    const auto SESSION = m_session.lock();
+
+    // outputs get theirs drawn along with the rest of the monitor
+    if (!SESSION || !SESSION->m_paintCursors || SESSION->m_kind != IMAGE_CAPTURE_SOURCE_TOPLEVEL)
+        return false;
+
+    auto pointerSurfaceResource = g_pSeatManager->m_state.pointerFocus.lock();
+
+    if (!pointerSurfaceResource)
+        return false;
+
+    auto pointerSurface = Desktop::View::CWLSurface::fromResource(pointerSurfaceResource);
+
+    return pointerSurface && Desktop::View::CWindow::fromView(pointerSurface->view()) == SESSION->m_window.lock();
+}
+
+void CImageCopyCaptureFrame::fail(extImageCopyCaptureFrameV1FailureReason reason) {
+    m_done = true;
+
+    std::erase(PROTO::imageCopyCapture->m_framesAwaitingCapture, m_self);
+
+    m_resource->sendFailed(reason);
+}
+
+void CImageCopyCaptureFrame::sendReady(const Time::steady_tp& when, wl_output_transform transform) {
+    m_done = true;
+
+    m_resource->sendTransform(transform);
+
+    for (auto const& rect : m_damage.getRects()) {
+        m_resource->sendDamage(rect.x1, rect.y1, rect.x2 - rect.x1, rect.y2 - rect.y1);
+    }
+
+    const auto [sec, nsec] = Time::secNsec(when);
+
+    uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
+    uint32_t tvSecLo = sec & 0xFFFFFFFF;
+    m_resource->sendPresentationTime(tvSecHi, tvSecLo, nsec);
+
+    m_resource->sendReady();
+}
+
+CImageCopyCaptureCursorSession::CImageCopyCaptureCursorSession(SP<CExtImageCopyCaptureCursorSessionV1> resource_, SP<CImageCaptureSource> source) :
+    m_resource(resource_), m_source(source) {
+    if UNLIKELY (!good())
+        return;
+
+    m_resource->setDestroy([this](CExtImageCopyCaptureCursorSessionV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setOnDestroy([this](CExtImageCopyCaptureCursorSessionV1* r) { PROTO::imageCopyCapture->destroyResource(this); });
+    m_resource->setGetCaptureSession([this](CExtImageCopyCaptureCursorSessionV1* r, uint32_t id) {
+        if UNLIKELY (m_sessionCreated) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_CURSOR_SESSION_V1_ERROR_DUPLICATE_SESSION, "capture session already created");
+            return;
+        }
+
+        m_sessionCreated = true;
+
+        PROTO::imageCopyCapture->createSession(r->client(), r->version(), id, m_source, false, true);
+    });
+
+    update();
+}
+
+bool CImageCopyCaptureCursorSession::good() {
+    return m_resource->resource();
+}
+
+void CImageCopyCaptureCursorSession::update() {
+    PHLMONITOR monitor;
+    CBox       sourceBox; // logical
+
+    if (m_source && m_source->m_kind == IMAGE_CAPTURE_SOURCE_TOPLEVEL) {
+        if (validMapped(m_source->m_window)) {
+            const auto PWINDOW = m_source->m_window.lock();
+            monitor            = PWINDOW->m_monitor.lock();
+            sourceBox          = {PWINDOW->m_realPosition->value(), PWINDOW->m_realSize->value()};
+        }
+    } else if (m_source && g_pCompositor->monitorExists(m_source->m_monitor.lock())) {
+        monitor   = m_source->m_monitor.lock();
+        sourceBox = monitor->logicalBox();
+    }
+
+    const auto POS       = g_pPointerManager->position();
+    const auto CURSORBOX = g_pPointerManager->getCursorBoxGlobal();
+
+    if (!monitor || (!sourceBox.containsPoint(POS) && !CURSORBOX.overlaps(sourceBox))) {
+        if (m_entered)
+            m_resource->sendLeave();
+
+        m_entered = false;
+        return;
+    }
+
+    const bool ENTERED = !m_entered;
+    if (ENTERED)
+        m_resource->sendEnter();
+
+    m_entered = true;
+
+    // both buffers are in the monitor's orientation, the client gets its transform with each frame
+    const auto TRANSFORM = Math::wlTransformToHyprutils(Math::invertTransform(monitor->m_transform));
+    const auto POSITION  = (CBox{POS - sourceBox.pos(), {}}.transform(TRANSFORM, sourceBox.w, sourceBox.h).pos() * monitor->m_scale).floor();
+    const auto HOTSPOT   = (CBox{POS - CURSORBOX.pos(), {}}.transform(TRANSFORM, CURSORBOX.w, CURSORBOX.h).pos() * monitor->m_scale).floor();
+
+    if (ENTERED || POSITION != m_position)
+        m_resource->sendPosition(sc<int32_t>(POSITION.x), sc<int32_t>(POSITION.y));
+
+    if (ENTERED || HOTSPOT != m_hotspot)
+        m_resource->sendHotspot(sc<int32_t>(HOTSPOT.x), sc<int32_t>(HOTSPOT.y));
+
+    m_position = POSITION;
+    m_hotspot  = HOTSPOT;
+}
+
+CImageCopyCaptureProtocol::CImageCopyCaptureProtocol(const wl_interface* iface, const int& ver, const std::string& name) : IWaylandProtocol(iface, ver, name) {
+    m_monitorRemovedHook = g_pHookSystem->hookDynamic("monitorRemoved", [this](void* self, SCallbackInfo& info, std::any data) { stopGoneSessionsLater(); });
+    m_closeWindowHook    = g_pHookSystem->hookDynamic("closeWindow", [this](void* self, SCallbackInfo& info, std::any data) { stopGoneSessionsLater(); });
+}
+
+void CImageCopyCaptureProtocol::bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id) {
+    const auto RESOURCE = m_managers.emplace_back(makeShared<CExtImageCopyCaptureManagerV1>(client, ver, id));
+
+    if UNLIKELY (!RESOURCE->resource()) {
+        wl_client_post_no_memory(client);
+        m_managers.pop_back();
+        return;
+    }
+
+    RESOURCE->setDestroy([this](CExtImageCopyCaptureManagerV1* r) { destroyResource(r); });
+    RESOURCE->setOnDestroy([this](CExtImageCopyCaptureManagerV1* r) { destroyResource(r); });
+    RESOURCE->setCreateSession([this](CExtImageCopyCaptureManagerV1* r, uint32_t id, wl_resource* source, extImageCopyCaptureManagerV1Options options) {
+        if UNLIKELY (options & ~EXT_IMAGE_COPY_CAPTURE_MANAGER_V1_OPTIONS_PAINT_CURSORS) {
+            r->error(EXT_IMAGE_COPY_CAPTURE_MANAGER_V1_ERROR_INVALID_OPTION, "invalid options");
+            return;
+        }
+
+        createSession(r->client(), r->version(), id, CImageCaptureSource::fromResource(source), options & EXT_IMAGE_COPY_CAPTURE_MANAGER_V1_OPTIONS_PAINT_CURSORS);
+    });
+    RESOURCE->setCreatePointerCursorSession([this](CExtImageCopyCaptureManagerV1* r, uint32_t id, wl_resource* source, wl_resource* pointer) {
+        const auto& SESSION = m_cursorSessions.emplace_back(
+            makeUnique<CImageCopyCaptureCursorSession>(makeShared<CExtImageCopyCaptureCursorSessionV1>(r->client(), r->version(), id), CImageCaptureSource::fromResource(source)));
+
+        if UNLIKELY (!SESSION->good()) {
+            r->noMemory();
+            m_cursorSessions.pop_back();
+        }
+    });
+}
+
+void CImageCopyCaptureProtocol::createSession(wl_client* client, uint32_t version, uint32_t id, SP<CImageCaptureSource> source, bool paintCursors, bool cursor) {
+    const auto SESSION =
+        m_sessions.emplace_back(makeShared<CImageCopyCaptureSession>(makeShared<CExtImageCopyCaptureSessionV1>(client, version, id), source, paintCursors, cursor));
+
+    if UNLIKELY (!SESSION->good()) {
+        wl_client_post_no_memory(client);
+        m_sessions.pop_back();
+        return;
+    }
+
+    SESSION->m_self = SESSION;
+}
+
+void CImageCopyCaptureProtocol::destroyResource(CExtImageCopyCaptureManagerV1* manager) {
+    std::erase_if(m_managers, [&](const auto& other) { return other.get() == manager; });
+}
+
+void CImageCopyCaptureProtocol::destroyResource(CImageCopyCaptureSession* session) {
+    if (session->m_frame && session->m_frame->m_captured && !session->m_frame->m_done)
+        session->m_frame->fail(EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED);
+
+    std::erase_if(m_sessions, [&](const auto& other) { return other.get() == session; });
+}
+
+void CImageCopyCaptureProtocol::destroyResource(CImageCopyCaptureFrame* frame) {
+    std::erase_if(m_frames, [&](const auto& other) { return other.get() == frame; });
+    std::erase_if(m_framesAwaitingCapture, [&](const auto& other) { return !other || other.get() == frame; });
+}
+
+void CImageCopyCaptureProtocol::destroyResource(CImageCopyCaptureCursorSession* session) {
+    std::erase_if(m_cursorSessions, [&](const auto& other) { return other.get() == session; });
+}
+
+void CImageCopyCaptureProtocol::stopGoneSessions() {
+    for (auto const& s : m_sessions) {
+        if (!s->m_stopped && !s->monitor())
+            s->stop();
+    }
+}
+
+void CImageCopyCaptureProtocol::stopGoneSessionsLater() {
+    std::vector<WP<CImageCopyCaptureSession>> sessions;
+    for (auto const& s : m_sessions) {
+        sessions.emplace_back(s);
+    }
+
+    // the monitor or window is only gone for good once the hook is through, and a session may be gone by then too
+    g_pEventLoopManager->doLater([sessions = std::move(sessions)] {
+        for (auto const& s : sessions) {
+            if (s && !s->m_stopped && !s->monitor())
+                s->stop();
+        }
+    });
+}
+
+void CImageCopyCaptureProtocol::onOutputCommit(PHLMONITOR pMonitor) {
+    // toplevels may have moved under the cursor
+    for (auto const& c : m_cursorSessions) {
+        c->update();
+    }
+
+    if (m_sessions.empty())
+        return;
+
+    stopGoneSessions();
+
+    // every commit is accounted for, even without a frame waiting, so the damage ring never gets lapped
+    for (auto const& s : m_sessions) {
+        if (s->monitor() != pMonitor)
+            continue;
+
+        if (!s->updateConstraints()) {
+            s->stop();
+            continue;
+        }
+
+        s->accumulateDamage(true);
+    }
+
+    shareFrames(pMonitor);
+}
+
+void CImageCopyCaptureProtocol::onCursorChanged(bool image) {
+    for (auto const& c : m_cursorSessions) {
+        c->update();
+    }
+
+    if (!image)
+        return;
+
+    std::vector<WP<CImageCopyCaptureSession>> cursorSessions;
+    for (auto const& s : m_sessions) {
+        if (!s->m_cursor || s->m_stopped)
+            continue;
+
+        s->m_damage = CBox{{}, s->m_box.size()};
+        cursorSessions.emplace_back(s);
+    }
+
+    if (cursorSessions.empty() || m_cursorSharePending)
+        return;
+
+    // we're in the middle of input or a commit here, copy once that's through
+    m_cursorSharePending = true;
+    g_pEventLoopManager->doLater([sessions = std::move(cursorSessions)] {
+        if (!PROTO::imageCopyCapture)
+            return;
+
+        PROTO::imageCopyCapture->m_cursorSharePending = false;
+
+        for (auto const& s : sessions) {
+            if (s && !s->m_stopped && !s->updateConstraints())
+                s->stop();
+        }
+
+        for (auto const& m : g_pCompositor->m_monitors) {
+            PROTO::imageCopyCapture->shareFrames(m);
+        }
+    });
+}
+
+void CImageCopyCaptureProtocol::shareFrames(PHLMONITOR pMonitor) {
+    if (m_framesAwaitingCapture.empty())
+        return;
+
+    // sharing or failing takes a frame off the list
+    const auto FRAMES = m_framesAwaitingCapture;
+
+    for (auto const& f : FRAMES) {
+        if (!f || !f->shouldShare(pMonitor))
+            continue;
+
+        std::erase(m_framesAwaitingCapture, f);
+
+        f->share();
+    }
+
+    std::erase_if(m_framesAwaitingCapture, [](const auto& other) { return !other; });
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "WaylandProtocol.hpp"
+#include "ext-image-copy-capture-v1.hpp"
+#include "types/Buffer.hpp"
+#include "ImageCaptureSource.hpp"
+#include "../desktop/DesktopTypes.hpp"
+#include "../helpers/time/Time.hpp"
+#include "../managers/HookSystemManager.hpp"
+
+class CImageCopyCaptureFrame;
+
+class CImageCopyCaptureSession {
+  public:
+    // a null source makes a session that's stopped right away. A cursor session captures the cursor image instead of the source.
+    CImageCopyCaptureSession(SP<CExtImageCopyCaptureSessionV1> resource_, SP<CImageCaptureSource> source, bool paintCursors, bool cursor = false);
+
+    bool                         good();
+    wl_client*                   client();
+
+    // the monitor the source is shown on, if any
+    PHLMONITOR                   monitor();
+
+    WP<CImageCopyCaptureSession> m_self;
+
+  private:
+    SP<CExtImageCopyCaptureSessionV1> m_resource;
+
+    eImageCaptureSourceKind           m_kind = IMAGE_CAPTURE_SOURCE_OUTPUT;
+    PHLMONITORREF                     m_monitor;
+    PHLWINDOWREF                      m_window;
+    bool                              m_paintCursors = false;
+    bool                              m_cursor       = false;
+    bool                              m_stopped      = false;
+
+    WP<CImageCopyCaptureFrame>        m_frame;
+
+    // buffer constraints, resent whenever they change
+    CBox     m_box; // what's captured, in the monitor's buffer pixels for outputs
+    uint32_t m_shmFormat    = 0;
+    uint32_t m_dmabufFormat = 0;
+
+    // what changed since the last frame was sent, in buffer coordinates
+    CRegion  m_damage;
+    uint64_t m_monitorFrames = 0; // of the monitor's damage ring when m_damage was last brought up to date
+    CBox     m_lastCursorBox;
+
+    bool     updateConstraints();
+    void     sendConstraints();
+    void     accumulateDamage(bool committed);
+    void     stop();
+    bool     capturesOutput(); // the whole monitor, the only thing its damage maps onto
+
+    friend class CImageCopyCaptureFrame;
+    friend class CImageCopyCaptureProtocol;
+};
+
+class CImageCopyCaptureFrame {
+  public:
+    CImageCopyCaptureFrame(SP<CExtImageCopyCaptureFrameV1> resource_, SP<CImageCopyCaptureSession> session);
+
+    bool                       good();
+
+    WP<CImageCopyCaptureFrame> m_self;
+
+  private:
+    SP<CExtImageCopyCaptureFrameV1> m_resource;
+    WP<CImageCopyCaptureSession>    m_session;
+
+    CHLBufferReference              m_buffer;
+    bool                            m_bufferDMA = false;
+    CRegion                         m_bufferDamage; // what the client says is stale in its buffer
+    bool                            m_captured = false;
+    bool                            m_done     = false;
+
+    // the session damage this frame reports
+    CRegion m_damage;
+
+    void    capture();
+    bool    bufferFits();
+    bool    shouldShare(PHLMONITOR pMonitor);
+    void    share();
+    void    copyDmabuf(const CRegion& damage, std::function<void(bool)> callback);
+    void    copyShm(const CRegion& damage, std::function<void(bool)> callback);
+    void    renderContents(PHLMONITOR pMonitor, const Time::steady_tp& now);
+    bool    shouldOverlayCursor();
+    void    fail(extImageCopyCaptureFrameV1FailureReason reason);
+    void    sendReady(const Time::steady_tp& when, wl_output_transform transform);
+
+    friend class CImageCopyCaptureSession;
+    friend class CImageCopyCaptureProtocol;
+};
+
+class CImageCopyCaptureCursorSession {
+  public:
+    CImageCopyCaptureCursorSession(SP<CExtImageCopyCaptureCursorSessionV1> resource_, SP<CImageCaptureSource> source);
+
+    bool good();
+
+  private:
+    SP<CExtImageCopyCaptureCursorSessionV1> m_resource;
+    SP<CImageCaptureSource>                 m_source;
+    bool                                    m_sessionCreated = false;
+
+    // what the client was last told, in the buffer coordinates of the source and of the cursor image
+    bool     m_entered = false;
+    Vector2D m_position;
+    Vector2D m_hotspot;
+
+    void     update();
+
+    friend class CImageCopyCaptureProtocol;
+};
+
+class CImageCopyCaptureProtocol : public IWaylandProtocol {
+  public:
+    CImageCopyCaptureProtocol(const wl_interface* iface, const int& ver, const std::string& name);
+
+    virtual void bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id);
+
+    void         onOutputCommit(PHLMONITOR pMonitor);
+    // the cursor moved, or with image, also looks different
+    void         onCursorChanged(bool image);
+
+  private:
+    void                                            destroyResource(CExtImageCopyCaptureManagerV1* manager);
+    void                                            destroyResource(CImageCopyCaptureSession* session);
+    void                                            destroyResource(CImageCopyCaptureFrame* frame);
+    void                                            destroyResource(CImageCopyCaptureCursorSession* session);
+
+    void                                            createSession(wl_client* client, uint32_t version, uint32_t id, SP<CImageCaptureSource> source, bool paintCursors,
+                                                                  bool cursor = false);
+    void                                            shareFrames(PHLMONITOR pMonitor);
+    void                                            stopGoneSessions();
+    void                                            stopGoneSessionsLater();
+
+    std::vector<SP<CExtImageCopyCaptureManagerV1>>  m_managers;
+    std::vector<SP<CImageCopyCaptureSession>>       m_sessions;
+    std::vector<SP<CImageCopyCaptureFrame>>         m_frames;
+    std::vector<UP<CImageCopyCaptureCursorSession>> m_cursorSessions;
+
+    std::vector<WP<CImageCopyCaptureFrame>>         m_framesAwaitingCapture;
+    bool                                            m_cursorSharePending = false;
+
+    SP<HOOK_CALLBACK_FN>                            m_monitorRemovedHook;
+    SP<HOOK_CALLBACK_FN>                            m_closeWindowHook;
+
+    friend class CImageCopyCaptureSession;
+    friend class CImageCopyCaptureFrame;
+    friend class CImageCopyCaptureCursorSession;
+};
+
+namespace PROTO {
+    inline UP<CImageCopyCaptureProtocol> imageCopyCapture;
+};
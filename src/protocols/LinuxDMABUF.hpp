@@ -136,6 +136,7 @@ class CLinuxDMABufV1Protocol : public IWaylandProtocol {
     friend class CLinuxDMABUFFeedbackResource;
     friend class CLinuxDMABUFParamsResource;
     friend class CLinuxDMABuffer;
+    friend class CImageCopyCaptureSession;
 };
 
 namespace PROTO {
@@ -7,6 +7,7 @@
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
+#include "../render/AsyncReadback.hpp"
 #include "../helpers/Monitor.hpp"
 #include "core/Output.hpp"
 #include "types/WLBuffer.hpp"
@@ -160,9 +161,16 @@ void CScreencopyFrame::share() {
     if (!m_buffer || !m_monitor)
         return;
 
+    if (m_bufferDMA)
+        copyDmabuf(onCopied());
+    else
+        copyShm(onCopied());
+}
+
+std::function<void(bool)> CScreencopyFrame::onCopied() {
     const auto NOW = Time::steadyNow();
 
-    auto       callback = [this, NOW, weak = m_self](bool success) {
+    return [this, NOW, weak = m_self](bool success) {
         if (weak.expired())
             return;
 
@@ -184,112 +192,14 @@ void CScreencopyFrame::share() {
         uint32_t tvSecLo = sec & 0xFFFFFFFF;
         m_resource->sendReady(tvSecHi, tvSecLo, nsec);
     };
+}
 
-    if (m_bufferDMA)
-        copyDmabuf(callback);
-    else
-        callback(copyShm());
+bool CScreencopyFrame::isCMAware() {
+    return PROTO::colorManagement && PROTO::colorManagement->isClientCMAware(m_client->client());
 }
 
 void CScreencopyFrame::renderMon() {
-    auto       TEXTURE = makeShared<CTexture>(m_monitor->m_output->state->state().buffer);
-
-    CRegion    fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
-
-    const bool IS_CM_AWARE = PROTO::colorManagement && PROTO::colorManagement->isClientCMAware(m_client->client());
-
-    CBox       monbox = CBox{0, 0, m_monitor->m_pixelSize.x, m_monitor->m_pixelSize.y}
-                      .translate({-m_box.x, -m_box.y}) // vvvv kinda ass-backwards but that's how I designed the renderer... sigh.
-                      .transform(Math::wlTransformToHyprutils(Math::invertTransform(m_monitor->m_transform)), m_monitor->m_pixelSize.x, m_monitor->m_pixelSize.y);
-    g_pHyprOpenGL->pushMonitorTransformEnabled(true);
-    g_pHyprOpenGL->setRenderModifEnabled(false);
-    g_pHyprOpenGL->renderTexture(TEXTURE, monbox,
-                                 {
-                                     .cmBackToSRGB       = !IS_CM_AWARE,
-                                     .cmBackToSRGBSource = !IS_CM_AWARE ? m_monitor.lock() : nullptr,
-                                 });
-    g_pHyprOpenGL->setRenderModifEnabled(true);
-    g_pHyprOpenGL->popMonitorTransformEnabled();
-
-    auto hidePopups = [&](Vector2D popupBaseOffset) {
-        return [&, popupBaseOffset](WP<Desktop::View::CPopup> popup, void*) {
-            if (!popup->wlSurface() || !popup->wlSurface()->resource() || !popup->visible())
-                return;
-
-            const auto popRel = popup->coordsRelativeToParent();
-            popup->wlSurface()->resource()->breadthfirst(
-                [&](SP<CWLSurfaceResource> surf, const Vector2D& localOff, void*) {
-                    const auto size    = surf->m_current.size;
-                    const auto surfBox = CBox{popupBaseOffset + popRel + localOff, size}.translate(m_monitor->m_position).scale(m_monitor->m_scale).translate(-m_box.pos());
-
-                    if LIKELY (surfBox.w > 0 && surfBox.h > 0)
-                        g_pHyprOpenGL->renderRect(surfBox, Colors::BLACK, {});
-                },
-                nullptr);
-        };
-    };
-
-    for (auto const& l : g_pCompositor->m_layers) {
-        if (!l->m_ruleApplicator->noScreenShare().valueOrDefault())
-            continue;
-
-        if UNLIKELY (!l->visible())
-            continue;
-
-        const auto REALPOS  = l->m_realPosition->value();
-        const auto REALSIZE = l->m_realSize->value();
-
-        const auto noScreenShareBox =
-            CBox{REALPOS.x, REALPOS.y, std::max(REALSIZE.x, 5.0), std::max(REALSIZE.y, 5.0)}.translate(-m_monitor->m_position).scale(m_monitor->m_scale).translate(-m_box.pos());
-
-        g_pHyprOpenGL->renderRect(noScreenShareBox, Colors::BLACK, {});
-
-        const auto     geom            = l->m_geometry;
-        const Vector2D popupBaseOffset = REALPOS - Vector2D{geom.pos().x, geom.pos().y};
-        if (l->m_popupHead)
-            l->m_popupHead->breadthfirst(hidePopups(popupBaseOffset), nullptr);
-    }
-
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (!w->m_ruleApplicator->noScreenShare().valueOrDefault())
-            continue;
-
-        if (!g_pHyprRenderer->shouldRenderWindow(w, m_monitor.lock()))
-            continue;
-
-        if (w->isHidden())
-            continue;
-
-        const auto PWORKSPACE = w->m_workspace;
-
-        if UNLIKELY (!PWORKSPACE && !w->m_fadingOut && w->m_alpha->value() != 0.f)
-            continue;
-
-        const auto renderOffset     = PWORKSPACE && !w->m_pinned ? PWORKSPACE->m_renderOffset->value() : Vector2D{};
-        const auto REALPOS          = w->m_realPosition->value() + renderOffset;
-        const auto noScreenShareBox = CBox{REALPOS.x, REALPOS.y, std::max(w->m_realSize->value().x, 5.0), std::max(w->m_realSize->value().y, 5.0)}
-                                          .translate(-m_monitor->m_position)
-                                          .scale(m_monitor->m_scale)
-                                          .translate(-m_box.pos());
-
-        const auto dontRound     = w->isEffectiveInternalFSMode(FSMODE_FULLSCREEN);
-        const auto rounding      = dontRound ? 0 : w->rounding() * m_monitor->m_scale;
-        const auto roundingPower = dontRound ? 2.0f : w->roundingPower();
-
-        g_pHyprOpenGL->renderRect(noScreenShareBox, Colors::BLACK, {.round = rounding, .roundingPower = roundingPower});
-
-        if (w->m_isX11 || !w->m_popupHead)
-            continue;
-
-        const auto     geom            = w->m_xdgSurface->m_current.geometry;
-        const Vector2D popupBaseOffset = REALPOS - Vector2D{geom.pos().x, geom.pos().y};
-
-        w->m_popupHead->breadthfirst(hidePopups(popupBaseOffset), nullptr);
-    }
-
-    if (m_overlayCursor)
-        g_pPointerManager->renderSoftwareCursorsFor(m_monitor.lock(), Time::steadyNow(), fakeDamage,
-                                                    g_pInputManager->getMouseCoordsInternal() - m_monitor->m_position - m_box.pos() / m_monitor->m_scale, true);
+    NScreencopy::renderMonitor(m_monitor.lock(), m_box, m_overlayCursor, isCMAware());
 }
 
 void CScreencopyFrame::storeTempFB() {
@@ -325,6 +235,9 @@ void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
             CBox texbox = {{}, m_box.size()};
             g_pHyprOpenGL->renderTexture(m_tempFb.getTexture(), texbox, {});
             m_tempFb.release();
+        } else if (m_sharedFB) {
+            CBox texbox = {-m_box.pos(), m_sharedFB->m_size};
+            g_pHyprOpenGL->renderTexture(m_sharedFB->getTexture(), texbox, {});
         } else
             renderMon();
     } else if (PERM == PERMISSION_RULE_ALLOW_MODE_PENDING)
@@ -343,22 +256,22 @@ void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
     });
 }
 
-bool CScreencopyFrame::copyShm() {
+void CScreencopyFrame::copyShm(std::function<void(bool)> callback) {
     const auto PERM = g_pDynamicPermissionManager->clientPermissionMode(m_resource->client(), PERMISSION_TYPE_SCREENCOPY);
 
-    auto       shm                = m_buffer->shm();
-    auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+    auto       shm = m_buffer->shm();
 
-    CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+    CRegion    fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer fb;
-    fb.alloc(m_box.w, m_box.h, m_monitor->m_output->state->state().drmFormat);
+    auto& monData = g_pHyprOpenGL->m_monitorRenderResources[m_monitor];
+    auto  fb      = monData.framebuffers.acquire(m_box.size(), m_monitor->m_output->state->state().drmFormat);
 
-    if (!g_pHyprRenderer->beginRender(m_monitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &fb, true)) {
+    if (!g_pHyprRenderer->beginRender(m_monitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, fb.get(), true)) {
         LOGM(Log::ERR, "Can't copy: failed to begin rendering");
-        return false;
+        callback(false);
+        return;
     }
 
     if (PERM == PERMISSION_RULE_ALLOW_MODE_ALLOW) {
@@ -376,13 +289,14 @@ bool CScreencopyFrame::copyShm() {
         g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_screencopyDeniedTexture, texbox, {});
     }
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.getFBID());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->getFBID());
 
     const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
     if (!PFORMAT) {
         LOGM(Log::ERR, "Can't copy: failed to find a pixel format");
         g_pHyprRenderer->endRender();
-        return false;
+        callback(false);
+        return;
     }
 
     auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
@@ -392,21 +306,46 @@ bool CScreencopyFrame::copyShm() {
 
     g_pHyprRenderer->makeEGLCurrent();
     g_pHyprOpenGL->m_renderData.pMonitor = m_monitor;
-    fb.bind();
+    fb->bind();
 
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
 
     const auto drmFmt     = NFormatUtils::getPixelFormatFromDRM(shm.format);
     uint32_t   packStride = NFormatUtils::minStride(drmFmt, m_box.w);
 
-    // This could be optimized by using a pixel buffer object to make this async,
-    // but really clients should just use a dma buffer anyways.
-    if (packStride == sc<uint32_t>(shm.stride)) {
-        glReadPixels(0, 0, m_box.w, m_box.h, glFormat, PFORMAT->glType, pixelData);
-    } else {
-        for (size_t i = 0; i < m_box.h; ++i) {
-            uint32_t y = i;
-            glReadPixels(0, y, m_box.w, 1, glFormat, PFORMAT->glType, pixelData + i * shm.stride);
+    auto       onReadback = [this, weak = m_self, callback, packStride](const uint8_t* data, uint32_t stride) {
+        if (weak.expired())
+            return;
+
+        if (!data) {
+            callback(false);
+            return;
+        }
+
+        auto shm                      = m_buffer->shm();
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+        CAsyncReadback::copyRows(pixelData, shm.stride, data, stride, packStride, m_box.h);
+
+        LOGM(Log::TRACE, "Copied frame via shm");
+
+        callback(true);
+    };
+
+    // the copy into the client's buffer happens once the gpu is done, the framebuffer can go back to the pool right away
+    const bool ASYNC = monData.captureReadback->read({0, 0, m_box.w, m_box.h}, glFormat, PFORMAT->glType, packStride, std::move(onReadback));
+
+    // no fences, or the client is capturing faster than the gpu keeps up. Stall.
+    if (!ASYNC) {
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+        if (packStride == sc<uint32_t>(shm.stride)) {
+            glReadPixels(0, 0, m_box.w, m_box.h, glFormat, PFORMAT->glType, pixelData);
+        } else {
+            for (size_t i = 0; i < m_box.h; ++i) {
+                uint32_t y = i;
+                glReadPixels(0, y, m_box.w, 1, glFormat, PFORMAT->glType, pixelData + i * shm.stride);
+            }
         }
     }
 
@@ -414,9 +353,12 @@ bool CScreencopyFrame::copyShm() {
 
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 
+    if (ASYNC)
+        return;
+
     LOGM(Log::TRACE, "Copied frame via shm");
 
-    return true;
+    callback(true);
 }
 
 bool CScreencopyFrame::good() {
@@ -529,6 +471,7 @@ void CScreencopyProtocol::onOutputCommit(PHLMONITOR pMonitor) {
     }
 
     std::vector<WP<CScreencopyFrame>> framesToRemove;
+    std::vector<SP<CScreencopyFrame>> framesToShare;
     // reserve number of elements to avoid reallocations
     framesToRemove.reserve(m_framesAwaitingWrite.size());
 
@@ -557,7 +500,7 @@ void CScreencopyProtocol::onOutputCommit(PHLMONITOR pMonitor) {
         if (f->m_monitor != pMonitor)
             continue;
 
-        f->share();
+        framesToShare.emplace_back(f.lock());
 
         f->m_client->m_lastFrame.reset();
         ++f->m_client->m_frameCounter;
@@ -568,4 +511,243 @@ void CScreencopyProtocol::onOutputCommit(PHLMONITOR pMonitor) {
     for (auto const& f : framesToRemove) {
         std::erase(m_framesAwaitingWrite, f);
     }
+
+    shareFrames(pMonitor, framesToShare);
+}
+
+void CScreencopyProtocol::shareFrames(PHLMONITOR pMonitor, const std::vector<SP<CScreencopyFrame>>& frames) {
+    // a recorder, a portal and a picker on the same monitor all want the same pixels, draw them once
+    std::vector<std::vector<SP<CScreencopyFrame>>> batches;
+
+    for (auto const& f : frames) {
+        const auto PERM = g_pDynamicPermissionManager->clientPermissionMode(f->m_resource->client(), PERMISSION_TYPE_SCREENCOPY);
+
+        if (PERM != PERMISSION_RULE_ALLOW_MODE_ALLOW || f->m_tempFb.isAllocated()) {
+            f->share();
+            continue;
+        }
+
+        auto batch = std::ranges::find_if(batches, [&](const auto& other) {
+            return other.front()->m_overlayCursor == f->m_overlayCursor && other.front()->isCMAware() == f->isCMAware();
+        });
+
+        if (batch == batches.end())
+            batches.emplace_back(std::vector{f});
+        else
+            batch->emplace_back(f);
+    }
+
+    for (auto const& b : batches) {
+        if (b.size() == 1)
+            b.front()->share();
+        else
+            shareBatch(pMonitor, b);
+    }
+}
+
+void CScreencopyProtocol::shareBatch(PHLMONITOR pMonitor, const std::vector<SP<CScreencopyFrame>>& frames) {
+    CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    auto fb = g_pHyprOpenGL->m_monitorRenderResources[pMonitor].framebuffers.acquire(pMonitor->m_pixelSize, pMonitor->m_output->state->state().drmFormat);
+
+    if (!g_pHyprRenderer->beginRender(pMonitor, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, fb.get(), true)) {
+        LOGM(Log::ERR, "Can't render a shared capture, sharing frames one by one");
+        for (auto const& f : frames) {
+            f->share();
+        }
+        return;
+    }
+
+    NScreencopy::renderMonitor(pMonitor, {{}, pMonitor->m_pixelSize}, frames.front()->m_overlayCursor, frames.front()->isCMAware());
+
+    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+    g_pHyprRenderer->endRender();
+
+    // dmabufs each get their region blitted, shm frames wanting the same pixels get one readback
+    std::vector<std::vector<SP<CScreencopyFrame>>> readbacks;
+
+    for (auto const& f : frames) {
+        if (f->m_bufferDMA) {
+            f->m_sharedFB = fb;
+            f->share();
+            f->m_sharedFB.reset();
+            continue;
+        }
+
+        auto readback = std::ranges::find_if(readbacks, [&](const auto& other) {
+            return other.front()->m_box == f->m_box && other.front()->m_buffer->shm().format == f->m_buffer->shm().format;
+        });
+
+        if (readback == readbacks.end())
+            readbacks.emplace_back(std::vector{f});
+        else
+            readback->emplace_back(f);
+    }
+
+    for (auto const& r : readbacks) {
+        readShared(pMonitor, fb, r);
+    }
+}
+
+void CScreencopyProtocol::readShared(PHLMONITOR pMonitor, SP<CFramebuffer> fb, const std::vector<SP<CScreencopyFrame>>& frames) {
+    const auto BOX     = frames.front()->m_box;
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(frames.front()->m_buffer->shm().format);
+
+    std::vector<std::pair<WP<CScreencopyFrame>, std::function<void(bool)>>> targets;
+    targets.reserve(frames.size());
+    for (auto const& f : frames) {
+        targets.emplace_back(f, f->onCopied());
+    }
+
+    if (!PFORMAT) {
+        LOGM(Log::ERR, "Can't copy: failed to find a pixel format");
+        for (auto const& [frame, callback] : targets) {
+            callback(false);
+        }
+        return;
+    }
+
+    const auto PACKSTRIDE = NFormatUtils::minStride(PFORMAT, BOX.w);
+    const auto ROWS       = sc<uint32_t>(BOX.h);
+    const auto GLFORMAT   = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
+
+    auto       copyOut = [targets, PACKSTRIDE, ROWS](const uint8_t* data, uint32_t stride) {
+        for (auto const& [frame, callback] : targets) {
+            if (frame.expired())
+                continue;
+
+            if (data) {
+                auto shm                      = frame->m_buffer->shm();
+                auto [pixelData, fmt, bufLen] = frame->m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+                CAsyncReadback::copyRows(pixelData, shm.stride, data, stride, PACKSTRIDE, ROWS);
+            }
+
+            callback(data != nullptr);
+        }
+    };
+
+    auto& monData = g_pHyprOpenGL->m_monitorRenderResources[pMonitor];
+
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pHyprOpenGL->m_renderData.pMonitor = pMonitor;
+    fb->bind();
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->getFBID());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    // one readback for all of them, stalling only if the gpu is behind
+    const bool ASYNC = monData.captureReadback->read(BOX, GLFORMAT, PFORMAT->glType, PACKSTRIDE, CAsyncReadback::DONE_FN{copyOut});
+
+    if (!ASYNC) {
+        std::vector<uint8_t> pixels(sc<size_t>(PACKSTRIDE) * ROWS);
+        glReadPixels(BOX.x, BOX.y, BOX.w, BOX.h, GLFORMAT, PFORMAT->glType, pixels.data());
+        copyOut(pixels.data(), PACKSTRIDE);
+    }
+
+    g_pHyprOpenGL->m_renderData.pMonitor.reset();
+
+    fb->unbind();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+void NScreencopy::renderMonitor(PHLMONITOR monitor, const CBox& box, bool overlayCursor, bool cmAware) {
+    auto    TEXTURE = makeShared<CTexture>(monitor->m_output->state->state().buffer);
+
+    CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+
+    CBox    monbox = CBox{0, 0, monitor->m_pixelSize.x, monitor->m_pixelSize.y}
+                   .translate({-box.x, -box.y}) // vvvv kinda ass-backwards but that's how I designed the renderer... sigh.
+                   .transform(Math::wlTransformToHyprutils(Math::invertTransform(monitor->m_transform)), monitor->m_pixelSize.x, monitor->m_pixelSize.y);
+    g_pHyprOpenGL->pushMonitorTransformEnabled(true);
+    g_pHyprOpenGL->setRenderModifEnabled(false);
+    g_pHyprOpenGL->renderTexture(TEXTURE, monbox,
+                                 {
+                                     .cmBackToSRGB       = !cmAware,
+                                     .cmBackToSRGBSource = !cmAware ? monitor : nullptr,
+                                 });
+    g_pHyprOpenGL->setRenderModifEnabled(true);
+    g_pHyprOpenGL->popMonitorTransformEnabled();
+
+    auto hidePopups = [&](Vector2D popupBaseOffset) {
+        return [&, popupBaseOffset](WP<Desktop::View::CPopup> popup, void*) {
+            if (!popup->wlSurface() || !popup->wlSurface()->resource() || !popup->visible())
+                return;
+
+            const auto popRel = popup->coordsRelativeToParent();
+            popup->wlSurface()->resource()->breadthfirst(
+                [&](SP<CWLSurfaceResource> surf, const Vector2D& localOff, void*) {
+                    const auto size    = surf->m_current.size;
+                    const auto surfBox = CBox{popupBaseOffset + popRel + localOff, size}.translate(monitor->m_position).scale(monitor->m_scale).translate(-box.pos());
+
+                    if LIKELY (surfBox.w > 0 && surfBox.h > 0)
+                        g_pHyprOpenGL->renderRect(surfBox, Colors::BLACK, {});
+                },
+                nullptr);
+        };
+    };
+
+    for (auto const& l : g_pCompositor->m_layers) {
+        if (!l->m_ruleApplicator->noScreenShare().valueOrDefault())
+            continue;
+
+        if UNLIKELY (!l->visible())
+            continue;
+
+        const auto REALPOS  = l->m_realPosition->value();
+        const auto REALSIZE = l->m_realSize->value();
+
+        const auto noScreenShareBox =
+            CBox{REALPOS.x, REALPOS.y, std::max(REALSIZE.x, 5.0), std::max(REALSIZE.y, 5.0)}.translate(-monitor->m_position).scale(monitor->m_scale).translate(-box.pos());
+
+        g_pHyprOpenGL->renderRect(noScreenShareBox, Colors::BLACK, {});
+
+        const auto     geom            = l->m_geometry;
+        const Vector2D popupBaseOffset = REALPOS - Vector2D{geom.pos().x, geom.pos().y};
+        if (l->m_popupHead)
+            l->m_popupHead->breadthfirst(hidePopups(popupBaseOffset), nullptr);
+    }
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        if (!w->m_ruleApplicator->noScreenShare().valueOrDefault())
+            continue;
+
+        if (!g_pHyprRenderer->shouldRenderWindow(w, monitor))
+            continue;
+
+        if (w->isHidden())
+            continue;
+
+        const auto PWORKSPACE = w->m_workspace;
+
+        if UNLIKELY (!PWORKSPACE && !w->m_fadingOut && w->m_alpha->value() != 0.f)
+            continue;
+
+        const auto renderOffset     = PWORKSPACE && !w->m_pinned ? PWORKSPACE->m_renderOffset->value() : Vector2D{};
+        const auto REALPOS          = w->m_realPosition->value() + renderOffset;
+        const auto noScreenShareBox = CBox{REALPOS.x, REALPOS.y, std::max(w->m_realSize->value().x, 5.0), std::max(w->m_realSize->value().y, 5.0)}
+                                          .translate(-monitor->m_position)
+                                          .scale(monitor->m_scale)
+                                          .translate(-box.pos());
+
+        const auto dontRound     = w->isEffectiveInternalFSMode(FSMODE_FULLSCREEN);
+        const auto rounding      = dontRound ? 0 : w->rounding() * monitor->m_scale;
+        const auto roundingPower = dontRound ? 2.0f : w->roundingPower();
+
+        g_pHyprOpenGL->renderRect(noScreenShareBox, Colors::BLACK, {.round = rounding, .roundingPower = roundingPower});
+
+        if (w->m_isX11 || !w->m_popupHead)
+            continue;
+
+        const auto     geom            = w->m_xdgSurface->m_current.geometry;
+        const Vector2D popupBaseOffset = REALPOS - Vector2D{geom.pos().x, geom.pos().y};
+
+        w->m_popupHead->breadthfirst(hidePopups(popupBaseOffset), nullptr);
+    }
+
+    if (overlayCursor)
+        g_pPointerManager->renderSoftwareCursorsFor(monitor, Time::steadyNow(), fakeDamage,
+                                                    g_pInputManager->getMouseCoordsInternal() - monitor->m_position - box.pos() / monitor->m_scale, true);
 }
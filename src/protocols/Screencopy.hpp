@@ -5,6 +5,7 @@
 #include "wlr-screencopy-unstable-v1.hpp"
 #include "WaylandProtocol.hpp"
 
+#include <functional>
 #include <list>
 #include <vector>
 #include "../managers/HookSystemManager.hpp"
@@ -79,11 +80,17 @@ class CScreencopyFrame {
 
     void         copy(CZwlrScreencopyFrameV1* pFrame, wl_resource* buffer);
     void         copyDmabuf(std::function<void(bool)> callback);
-    bool         copyShm();
+    void         copyShm(std::function<void(bool)> callback);
     void         renderMon();
     void         storeTempFB();
     void         share();
 
+    // the whole monitor, drawn once when several frames are shared on the same commit
+    SP<CFramebuffer>          m_sharedFB;
+
+    std::function<void(bool)> onCopied();
+    bool                      isCMAware();
+
     friend class CScreencopyProtocol;
 };
 
@@ -110,10 +117,21 @@ class CScreencopyProtocol : public IWaylandProtocol {
 
     uint32_t                           drmFormatForMonitor(PHLMONITOR pMonitor);
 
+    // frames drawing the same thing share one render of the monitor
+    void                               shareFrames(PHLMONITOR pMonitor, const std::vector<SP<CScreencopyFrame>>& frames);
+    void                               shareBatch(PHLMONITOR pMonitor, const std::vector<SP<CScreencopyFrame>>& frames);
+    void                               readShared(PHLMONITOR pMonitor, SP<CFramebuffer> fb, const std::vector<SP<CScreencopyFrame>>& frames);
+
     friend class CScreencopyFrame;
     friend class CScreencopyClient;
 };
 
+namespace NScreencopy {
+    // renders box (in buffer pixels) of what the monitor last committed, blacking out whatever doesn't allow screen sharing.
+    // Needs a render begun.
+    void renderMonitor(PHLMONITOR monitor, const CBox& box, bool overlayCursor, bool cmAware);
+}
+
 namespace PROTO {
     inline UP<CScreencopyProtocol> screencopy;
 };
@@ -10,6 +10,8 @@
 #include "../managers/input/InputManager.hpp"
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
+#include "../render/OpenGL.hpp"
+#include "../render/AsyncReadback.hpp"
 
 #include <algorithm>
 #include <hyprutils/math/Vector2D.hpp>
@@ -205,34 +207,36 @@ void CToplevelExportFrame::share() {
     if (!m_buffer || !validMapped(m_window))
         return;
 
-    if (m_bufferDMA) {
-        if (!copyDmabuf(Time::steadyNow())) {
-            m_resource->sendFailed();
+    auto callback = [this, weak = m_self](bool success) {
+        if (weak.expired())
             return;
-        }
-    } else {
-        if (!copyShm(Time::steadyNow())) {
+
+        if (!success) {
             m_resource->sendFailed();
             return;
         }
-    }
 
-    m_resource->sendFlags(sc<hyprlandToplevelExportFrameV1Flags>(0));
+        m_resource->sendFlags(sc<hyprlandToplevelExportFrameV1Flags>(0));
+
+        if (!m_ignoreDamage)
+            m_resource->sendDamage(0, 0, m_box.width, m_box.height);
 
-    if (!m_ignoreDamage)
-        m_resource->sendDamage(0, 0, m_box.width, m_box.height);
+        const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
 
-    const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
+        uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
+        uint32_t tvSecLo = sec & 0xFFFFFFFF;
+        m_resource->sendReady(tvSecHi, tvSecLo, nsec);
+    };
 
-    uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
-    uint32_t tvSecLo = sec & 0xFFFFFFFF;
-    m_resource->sendReady(tvSecHi, tvSecLo, nsec);
+    if (m_bufferDMA)
+        callback(copyDmabuf(Time::steadyNow()));
+    else
+        copyShm(Time::steadyNow(), callback);
 }
 
-bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
-    const auto PERM               = g_pDynamicPermissionManager->clientPermissionMode(m_resource->client(), PERMISSION_TYPE_SCREENCOPY);
-    auto       shm                = m_buffer->shm();
-    auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+void CToplevelExportFrame::copyShm(const Time::steady_tp& now, std::function<void(bool)> callback) {
+    const auto PERM = g_pDynamicPermissionManager->clientPermissionMode(m_resource->client(), PERMISSION_TYPE_SCREENCOPY);
+    auto       shm  = m_buffer->shm();
 
     // render the client
     const auto PMONITOR = m_window->m_monitor.lock();
@@ -240,8 +244,8 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer outFB;
-    outFB.alloc(PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y, PMONITOR->m_output->state->state().drmFormat);
+    auto& monData = g_pHyprOpenGL->m_monitorRenderResources[PMONITOR];
+    auto  outFB   = monData.framebuffers.acquire(PMONITOR->m_pixelSize, PMONITOR->m_output->state->state().drmFormat);
 
     auto overlayCursor = shouldOverlayCursor();
 
@@ -250,8 +254,10 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         g_pPointerManager->damageCursor(PMONITOR->m_self.lock());
     }
 
-    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &outFB))
-        return false;
+    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, outFB.get())) {
+        callback(false);
+        return;
+    }
 
     g_pHyprOpenGL->clear(CHyprColor(0, 0, 0, 1.0));
 
@@ -272,7 +278,8 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
     const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
     if (!PFORMAT) {
         g_pHyprRenderer->endRender();
-        return false;
+        callback(false);
+        return;
     }
 
     g_pHyprOpenGL->m_renderData.blockScreenShader = true;
@@ -280,9 +287,9 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
 
     g_pHyprRenderer->makeEGLCurrent();
     g_pHyprOpenGL->m_renderData.pMonitor = PMONITOR;
-    outFB.bind();
+    outFB->bind();
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB.getFBID());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB->getFBID());
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
 
     auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
@@ -308,17 +315,43 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         default: break;
     }
 
-    glReadPixels(origin.x, origin.y, m_box.width, m_box.height, glFormat, PFORMAT->glType, pixelData);
+    const auto PACKSTRIDE = NFormatUtils::minStride(PFORMAT, m_box.width);
+
+    auto       onReadback = [this, weak = m_self, callback, PACKSTRIDE](const uint8_t* data, uint32_t stride) {
+        if (weak.expired())
+            return;
+
+        if (!data) {
+            callback(false);
+            return;
+        }
+
+        auto shm                      = m_buffer->shm();
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+        CAsyncReadback::copyRows(pixelData, shm.stride, data, stride, PACKSTRIDE, m_box.height);
+
+        callback(true);
+    };
+
+    // finishes once the gpu is done, unless there are no fences or both pixel buffers are still busy
+    const bool ASYNC = monData.captureReadback->read({origin, m_box.size()}, glFormat, PFORMAT->glType, PACKSTRIDE, std::move(onReadback));
+
+    if (!ASYNC) {
+        auto [pixelData, fmt, bufLen] = m_buffer->beginDataPtr(0); // no need for end, cuz it's shm
+        glReadPixels(origin.x, origin.y, m_box.width, m_box.height, glFormat, PFORMAT->glType, pixelData);
+    }
 
     if (overlayCursor) {
         g_pPointerManager->unlockSoftwareForMonitor(PMONITOR->m_self.lock());
         g_pPointerManager->damageCursor(PMONITOR->m_self.lock());
     }
 
-    outFB.unbind();
+    outFB->unbind();
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 
-    return true;
+    if (!ASYNC)
+        callback(true);
 }
 
 bool CToplevelExportFrame::copyDmabuf(const Time::steady_tp& now) {
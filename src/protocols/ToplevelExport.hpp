@@ -62,7 +62,7 @@ class CToplevelExportFrame {
 
     void                               copy(CHyprlandToplevelExportFrameV1* pFrame, wl_resource* buffer, int32_t ignoreDamage);
     bool                               copyDmabuf(const Time::steady_tp& now);
-    bool                               copyShm(const Time::steady_tp& now);
+    void                               copyShm(const Time::steady_tp& now, std::function<void(bool)> callback);
     void                               share();
     bool                               shouldOverlayCursor() const;
 
@@ -247,6 +247,7 @@ void CWLSurfaceResource::destroy() {
     }
     m_events.destroy.emit();
     releaseBuffers(false);
+    invalidateSurfaceTrees();
     PROTO::compositor->destroyResource(this);
 }
 
@@ -343,7 +344,14 @@ void CWLSurfaceResource::resetRole() {
     m_role = makeShared<CDefaultSurfaceRole>();
 }
 
-void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
+// bumped whenever any subsurface tree changes shape, trees rebuild lazily on their next walk
+static uint64_t surfaceTreeGeneration = 1;
+
+void CWLSurfaceResource::invalidateSurfaceTrees() {
+    surfaceTreeGeneration++;
+}
+
+void CWLSurfaceResource::flattenTree(std::vector<SP<CWLSurfaceResource>> const& nodes, std::vector<STreeNode>& out) {
     std::vector<SP<CWLSurfaceResource>> nodes2;
     nodes2.reserve(nodes.size() * 2);
 
@@ -361,18 +369,16 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        flattenTree(nodes2, out);
 
     nodes2.clear();
 
     for (auto const& n : nodes) {
-        Vector2D offset = {};
-        if (n->m_role->role() == SURFACE_ROLE_SUBSURFACE) {
-            auto subsurface = sc<CSubsurfaceRole*>(n->m_role.get())->m_subsurface.lock();
-            offset          = subsurface->posRelativeToParent();
-        }
+        STreeNode node = {.surface = n};
+        if (n->m_role->role() == SURFACE_ROLE_SUBSURFACE)
+            node.subsurface = sc<CSubsurfaceRole*>(n->m_role.get())->m_subsurface;
 
-        fn(n, offset, data);
+        out.emplace_back(std::move(node));
     }
 
     for (auto const& n : nodes) {
@@ -386,13 +392,58 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        flattenTree(nodes2, out);
 }
 
-void CWLSurfaceResource::breadthfirst(std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
-    std::vector<SP<CWLSurfaceResource>> surfs;
-    surfs.emplace_back(m_self.lock());
-    bfHelper(surfs, fn, data);
+std::vector<CWLSurfaceResource::STreeNode>& CWLSurfaceResource::lockTree(std::vector<STreeNode>& fallback) {
+    auto* nodes = &m_tree.nodes;
+
+    if (m_tree.generation != surfaceTreeGeneration) {
+        // if someone up the stack is still walking our array, leave it alone and walk a temporary copy
+        if (m_tree.walking > 0)
+            nodes = &fallback;
+        else
+            m_tree.generation = surfaceTreeGeneration;
+
+        nodes->clear();
+        flattenTree({m_self.lock()}, *nodes);
+
+        for (auto& n : *nodes) {
+            const auto SUB = n.subsurface.lock();
+            if (!SUB || n.surface == m_self)
+                continue;
+
+            const auto PARENT = std::ranges::find_if(*nodes, [&SUB](const auto& other) { return other.surface == SUB->m_parent; });
+            n.parent          = PARENT == nodes->end() ? -1 : sc<int>(std::distance(nodes->begin(), PARENT));
+        }
+    }
+
+    // positions aren't part of the tree shape, re-read them every time.
+    // The root's offset is relative to its own parent, the same as posRelativeToParent().
+    Vector2D rootOffset = {};
+    if (m_role->role() == SURFACE_ROLE_SUBSURFACE) {
+        if (const auto SUB = sc<CSubsurfaceRole*>(m_role.get())->m_subsurface.lock(); SUB)
+            rootOffset = SUB->posRelativeToParent();
+    }
+
+    for (auto& n : *nodes) {
+        n.offset = rootOffset;
+
+        // bounded, in case a client managed to make a cycle
+        const STreeNode* it = &n;
+        for (size_t depth = 0; it->parent >= 0 && depth < nodes->size(); ++depth) {
+            if (const auto SUB = it->subsurface.lock(); SUB)
+                n.offset += SUB->m_position;
+            it = &(*nodes)[it->parent];
+        }
+    }
+
+    m_tree.walking++;
+    return *nodes;
+}
+
+void CWLSurfaceResource::unlockTree() {
+    m_tree.walking--;
 }
 
 SP<CWLSurfaceResource> CWLSurfaceResource::findFirstPreorderHelper(SP<CWLSurfaceResource> root, std::function<bool(SP<CWLSurfaceResource>)> fn) {
@@ -417,22 +468,32 @@ SP<CWLSurfaceResource> CWLSurfaceResource::findWithCM() {
 }
 
 std::pair<SP<CWLSurfaceResource>, Vector2D> CWLSurfaceResource::at(const Vector2D& localCoords, bool allowsInput) {
-    std::vector<std::pair<SP<CWLSurfaceResource>, Vector2D>> surfs;
-    breadthfirst([&surfs](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* data) { surfs.emplace_back(std::make_pair<>(surf, offset)); }, &surfs);
-
-    for (auto const& [surf, pos] : surfs | std::views::reverse) {
-        if (!allowsInput) {
-            const auto BOX = CBox{pos, surf->m_current.size};
-            if (BOX.containsPoint(localCoords))
-                return {surf, localCoords - pos};
-        } else {
-            const auto REGION = surf->m_current.input.copy().intersect(CBox{{}, surf->m_current.size}).translate(pos);
-            if (REGION.containsPoint(localCoords))
-                return {surf, localCoords - pos};
-        }
+    const auto             SELF = m_self.lock();
+    std::vector<STreeNode> fallback;
+    auto&                  nodes = lockTree(fallback);
+
+    std::pair<SP<CWLSurfaceResource>, Vector2D> result = {nullptr, {}};
+
+    for (auto const& n : nodes | std::views::reverse) {
+        const auto SURF = n.surface.lock();
+        if (!SURF)
+            continue;
+
+        const auto LOCAL = localCoords - n.offset;
+
+        if (!CBox{{}, SURF->m_current.size}.containsPoint(LOCAL))
+            continue;
+
+        if (allowsInput && !SURF->m_current.input.containsPoint(LOCAL))
+            continue;
+
+        result = {SURF, LOCAL};
+        break;
     }
 
-    return {nullptr, {}};
+    unlockTree();
+
+    return result;
 }
 
 uint32_t CWLSurfaceResource::id() {
@@ -599,6 +660,8 @@ void CWLSurfaceResource::sortSubsurfaces() {
     for (int i = 0; i < firstNonNegative; ++i) {
         m_subsurfaces.at(i)->m_zIndex = -firstNonNegative + i;
     }
+
+    invalidateSurfaceTrees();
 }
 
 bool CWLSurfaceResource::hasVisibleSubsurface() {
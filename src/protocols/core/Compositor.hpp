@@ -119,7 +119,6 @@ class CWLSurfaceResource {
     WP<CColorManagementSurface>            m_colorManagement;
     WP<CContentType>                       m_contentType;
 
-    void                                   breadthfirst(std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data);
     SP<CWLSurfaceResource>                 findFirstPreorder(std::function<bool(SP<CWLSurfaceResource>)> fn);
     SP<CWLSurfaceResource>                 findWithCM();
     void                                   presentFeedback(const Time::steady_tp& when, PHLMONITOR pMonitor, bool discarded = false);
@@ -133,17 +132,53 @@ class CWLSurfaceResource {
     // localCoords param is relative to 0,0 of this surface
     std::pair<SP<CWLSurfaceResource>, Vector2D> at(const Vector2D& localCoords, bool allowsInput = false);
 
+    // calls fn(surface, offset, data) for this surface and all its subsurfaces, bottom to top.
+    // Walks a cached, flattened copy of the tree, so this doesn't allocate unless the tree changed.
+    template <typename F>
+    void breadthfirst(F&& fn, void* data) {
+        const auto             SELF = m_self.lock(); // fn may drop the last ref to us
+        std::vector<STreeNode> fallback;
+        auto&                  nodes = lockTree(fallback);
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (const auto SURF = nodes[i].surface.lock(); SURF)
+                fn(SURF, nodes[i].offset, data);
+        }
+
+        unlockTree();
+    }
+
+    // call when any subsurface tree changes shape: a subsurface is added, destroyed or restacked.
+    static void invalidateSurfaceTrees();
+
   private:
-    SP<CWlSurface>         m_resource;
-    wl_client*             m_client = nullptr;
-
-    void                   destroy();
-    void                   releaseBuffers(bool onlyCurrent = true);
-    void                   dropPendingBuffer();
-    void                   dropCurrentBuffer();
-    void                   bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data);
-    SP<CWLSurfaceResource> findFirstPreorderHelper(SP<CWLSurfaceResource> root, std::function<bool(SP<CWLSurfaceResource>)> fn);
-    void                   updateCursorShm(CRegion damage = CBox{0, 0, INT16_MAX, INT16_MAX});
+    struct STreeNode {
+        WP<CWLSurfaceResource>    surface;
+        WP<CWLSubsurfaceResource> subsurface; // null for the root
+        int                       parent = -1;
+        Vector2D                  offset;
+    };
+
+    // m_subsurfaces flattened into draw order. Positions are re-read on every walk,
+    // so this only needs rebuilding when the tree itself changes.
+    struct {
+        std::vector<STreeNode> nodes;
+        uint64_t               generation = 0;
+        int                    walking    = 0;
+    } m_tree;
+
+    SP<CWlSurface>          m_resource;
+    wl_client*              m_client = nullptr;
+
+    void                    destroy();
+    void                    releaseBuffers(bool onlyCurrent = true);
+    void                    dropPendingBuffer();
+    void                    dropCurrentBuffer();
+    void                    flattenTree(std::vector<SP<CWLSurfaceResource>> const& nodes, std::vector<STreeNode>& out);
+    std::vector<STreeNode>& lockTree(std::vector<STreeNode>& fallback);
+    void                    unlockTree();
+    SP<CWLSurfaceResource>  findFirstPreorderHelper(SP<CWLSurfaceResource> root, std::function<bool(SP<CWLSurfaceResource>)> fn);
+    void                    updateCursorShm(CRegion damage = CBox{0, 0, INT16_MAX, INT16_MAX});
 
     friend class CWLPointerResource;
 };
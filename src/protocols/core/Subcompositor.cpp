@@ -94,6 +94,7 @@ CWLSubsurfaceResource::~CWLSubsurfaceResource() {
     m_events.destroy.emit();
     if (m_surface)
         m_surface->resetRole();
+    CWLSurfaceResource::invalidateSurfaceTrees();
 }
 
 void CWLSubsurfaceResource::destroy() {
@@ -116,7 +117,9 @@ Vector2D CWLSubsurfaceResource::posRelativeToParent() {
 
     while (surf->m_role->role() == SURFACE_ROLE_SUBSURFACE && std::ranges::find_if(surfacesVisited, [surf](const auto& other) { return surf == other; }) == surfacesVisited.end()) {
         surfacesVisited.emplace_back(surf);
-        auto subsurface = sc<CSubsurfaceRole*>(m_parent->m_role.get())->m_subsurface.lock();
+        auto subsurface = sc<CSubsurfaceRole*>(surf->m_role.get())->m_subsurface.lock();
+        if (!subsurface)
+            break;
         pos += subsurface->m_position;
         surf = subsurface->m_parent.lock();
     }
@@ -133,8 +136,10 @@ SP<CWLSurfaceResource> CWLSubsurfaceResource::t1Parent() {
 
     while (surf->m_role->role() == SURFACE_ROLE_SUBSURFACE && std::ranges::find_if(surfacesVisited, [surf](const auto& other) { return surf == other; }) == surfacesVisited.end()) {
         surfacesVisited.emplace_back(surf);
-        auto subsurface = sc<CSubsurfaceRole*>(m_parent->m_role.get())->m_subsurface.lock();
-        surf            = subsurface->m_parent.lock();
+        auto subsurface = sc<CSubsurfaceRole*>(surf->m_role.get())->m_subsurface.lock();
+        if (!subsurface)
+            break;
+        surf = subsurface->m_parent.lock();
     }
     return surf;
 }
@@ -185,6 +190,7 @@ CWLSubcompositorResource::CWLSubcompositorResource(SP<CWlSubcompositor> resource
         RESOURCE->m_self = RESOURCE;
         SURF->m_role     = makeShared<CSubsurfaceRole>(RESOURCE);
         PARENT->m_subsurfaces.emplace_back(RESOURCE);
+        CWLSurfaceResource::invalidateSurfaceTrees();
 
         LOGM(Log::DEBUG, "New wl_subsurface with id {} at {:x}", id, (uintptr_t)RESOURCE.get());
 
@@ -0,0 +1,100 @@
+#include "AsyncReadback.hpp"
+#include "OpenGL.hpp"
+#include "Renderer.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+SP<CAsyncReadback> CAsyncReadback::create() {
+    SP<CAsyncReadback> readback(new CAsyncReadback);
+    readback->m_self = readback;
+    return readback;
+}
+
+CAsyncReadback::~CAsyncReadback() {
+    if (!g_pHyprOpenGL)
+        return;
+
+    for (auto& s : m_slots) {
+        if (s.pbo)
+            glDeleteBuffers(1, &s.pbo);
+    }
+}
+
+bool CAsyncReadback::supported() {
+    return g_pHyprOpenGL && g_pHyprOpenGL->explicitSyncSupported();
+}
+
+bool CAsyncReadback::read(const CBox& box, GLenum glFormat, GLenum glType, uint32_t stride, DONE_FN&& done) {
+    if (!supported())
+        return false;
+
+    const auto SLOT = std::ranges::find_if(m_slots, [](const auto& s) { return !s.busy; });
+    if (SLOT == m_slots.end())
+        return false;
+
+    const size_t SIZE = sc<size_t>(stride) * sc<size_t>(box.h);
+
+    if (!SLOT->pbo)
+        glGenBuffers(1, &SLOT->pbo);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, SLOT->pbo);
+
+    if (SLOT->size != SIZE) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, SIZE, nullptr, GL_STREAM_READ);
+        SLOT->size = SIZE;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(box.x, box.y, box.w, box.h, glFormat, glType, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    SLOT->sync = CEGLSync::create();
+    if (!SLOT->sync || !SLOT->sync->isValid()) {
+        Log::logger->log(Log::ERR, "CAsyncReadback: failed to create a fence, reading synchronously");
+        SLOT->sync.reset();
+        return false;
+    }
+
+    SLOT->busy = true;
+
+    // hold ourselves, the monitor this belongs to could go away before the fence signals
+    g_pEventLoopManager->doOnReadable(SLOT->sync->fd().duplicate(), [self = m_self.lock(), &slot = *SLOT, stride, done = std::move(done)] { self->finish(slot, stride, done); });
+
+    return true;
+}
+
+void CAsyncReadback::finish(SSlot& slot, uint32_t stride, const DONE_FN& done) {
+    g_pHyprRenderer->makeEGLCurrent();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+
+    const auto DATA = sc<const uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT));
+    if (!DATA)
+        Log::logger->log(Log::ERR, "CAsyncReadback: failed to map the pixel buffer (GL Error: 0x{:x})", sc<int>(glGetError()));
+
+    done(DATA, stride);
+
+    if (DATA)
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.busy = false;
+    slot.sync.reset();
+}
+
+void CAsyncReadback::copyRows(uint8_t* dst, uint32_t dstStride, const uint8_t* src, uint32_t srcStride, uint32_t rowSize, uint32_t rows) {
+    if (rows == 0)
+        return;
+
+    if (dstStride == srcStride && rowSize == srcStride) {
+        std::memcpy(dst, src, sc<size_t>(srcStride) * rows);
+        return;
+    }
+
+    for (uint32_t i = 0; i < rows; ++i) {
+        std::memcpy(dst + sc<size_t>(i) * dstStride, src + sc<size_t>(i) * srcStride, rowSize);
+    }
+}
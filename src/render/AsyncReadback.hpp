@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include <GLES3/gl32.h>
+
+#include "../helpers/math/Math.hpp"
+#include "../helpers/memory/Memory.hpp"
+
+class CEGLSync;
+
+/*
+    Reads pixels back without waiting for the GPU. glReadPixels goes into one of two pixel pack
+    buffers, which gets mapped once its fence signals, on a later iteration of the event loop.
+    Two buffers let a capture of the next frame start while the last one is still being copied out.
+*/
+class CAsyncReadback {
+  public:
+    // data holds the rows of the box, stride bytes apart, and is only valid during the call.
+    // nullptr if the readback failed.
+    using DONE_FN = std::function<void(const uint8_t* data, uint32_t stride)>;
+
+    static SP<CAsyncReadback> create();
+    ~CAsyncReadback();
+
+    // needs native fences
+    static bool supported();
+
+    // reads box from the current read framebuffer, stride being the size of one of its rows.
+    // Returns false if nothing was read (both buffers in flight, no fences) and done will never be called,
+    // the caller should read synchronously then.
+    bool read(const CBox& box, GLenum glFormat, GLenum glType, uint32_t stride, DONE_FN&& done);
+
+    static void copyRows(uint8_t* dst, uint32_t dstStride, const uint8_t* src, uint32_t srcStride, uint32_t rowSize, uint32_t rows);
+
+  private:
+    CAsyncReadback() = default;
+
+    struct SSlot {
+        GLuint       pbo  = 0;
+        size_t       size = 0;
+        bool         busy = false;
+        UP<CEGLSync> sync;
+    };
+
+    void                 finish(SSlot& slot, uint32_t stride, const DONE_FN& done);
+
+    std::array<SSlot, 2> m_slots;
+    WP<CAsyncReadback>   m_self;
+};
@@ -0,0 +1,85 @@
+#include "FramebufferPool.hpp"
+
+SP<CFramebuffer> CFramebufferPool::acquire(const Vector2D& size, DRMFormat format, SP<CTexture> stencil) {
+    SEntry* found = nullptr;
+    SEntry* spare = nullptr;
+
+    for (auto& e : m_fbs) {
+        if (e.fb.strongRef() > 1)
+            continue;
+
+        if (e.fb->m_size == size && e.fb->m_drmFormat == format) {
+            found = &e;
+            break;
+        }
+
+        // a shared stencil has to stay the size of the monitor
+        if (!spare && !e.stencil)
+            spare = &e;
+    }
+
+    if (found)
+        m_reuses++;
+    else {
+        // none fits, but a free one can be reallocated instead of piling up new ones
+        found = spare ? spare : &m_fbs.emplace_back(SEntry{.fb = makeShared<CFramebuffer>()});
+        allocate(*found->fb, size, format);
+        m_allocations++;
+    }
+
+    if (stencil && found->stencil != stencil) {
+        attachStencil(*found->fb, stencil);
+        found->stencil = stencil;
+    }
+
+    found->lastAcquired = Time::steadyNow();
+
+    return found->fb;
+}
+
+void CFramebufferPool::releaseIdle(const Time::steady_dur& timeout, const Time::steady_tp& now) {
+    std::erase_if(m_fbs, [&](const auto& e) { return e.fb.strongRef() <= 1 && now - e.lastAcquired > timeout; });
+}
+
+std::optional<Time::steady_tp> CFramebufferPool::nextIdleRelease(const Time::steady_dur& timeout) const {
+    std::optional<Time::steady_tp> result;
+
+    for (const auto& e : m_fbs) {
+        if (e.fb.strongRef() <= 1 && (!result || e.lastAcquired + timeout < *result))
+            result = e.lastAcquired + timeout;
+    }
+
+    return result;
+}
+
+void CFramebufferPool::clear() {
+    std::erase_if(m_fbs, [](const auto& e) { return e.fb.strongRef() <= 1; });
+}
+
+bool CFramebufferPool::empty() const {
+    return m_fbs.empty();
+}
+
+void CFramebufferPool::allocate(CFramebuffer& fb, const Vector2D& size, DRMFormat format) {
+    fb.alloc(size.x, size.y, format);
+}
+
+void CFramebufferPool::attachStencil(CFramebuffer& fb, SP<CTexture> stencil) {
+    stencil->allocate();
+    fb.addStencil(stencil);
+}
+
+CFramebufferPool::SStats CFramebufferPool::stats() const {
+    SStats result = {.framebuffers = m_fbs.size(), .allocations = m_allocations, .reuses = m_reuses};
+
+    for (const auto& e : m_fbs) {
+        if (e.fb.strongRef() > 1)
+            result.inUse++;
+
+        const auto FMT = NFormatUtils::getPixelFormatFromDRM(e.fb->m_drmFormat);
+        if (FMT)
+            result.bytes += sc<size_t>(NFormatUtils::minStride(FMT, sc<int32_t>(e.fb->m_size.x))) * sc<size_t>(e.fb->m_size.y);
+    }
+
+    return result;
+}
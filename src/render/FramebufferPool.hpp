@@ -0,0 +1,55 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Framebuffer.hpp"
+#include "../helpers/time/Time.hpp"
+
+/*
+    Offscreen framebuffers of one monitor, for rendering and for capture. A framebuffer is in use
+    for as long as someone holds the pointer acquire() returned, after that it goes back to the pool
+    and the next acquire() of the same size and format gets it without allocating.
+*/
+class CFramebufferPool {
+  public:
+    struct SStats {
+        size_t framebuffers = 0;
+        size_t inUse        = 0;
+        size_t bytes        = 0; // of the color buffers
+        size_t allocations  = 0; // acquires that had to allocate, since the pool was made
+        size_t reuses       = 0; // and those that didn't
+    };
+
+    virtual ~CFramebufferPool() = default;
+
+    // needs a current context. The stencil, if any, is attached to what's returned,
+    // framebuffers sharing one must all be the size of the monitor.
+    SP<CFramebuffer>               acquire(const Vector2D& size, DRMFormat format, SP<CTexture> stencil = nullptr);
+
+    // drops the framebuffers nobody holds that weren't acquired within the timeout
+    void                           releaseIdle(const Time::steady_dur& timeout, const Time::steady_tp& now = Time::steadyNow());
+    // when releaseIdle() would drop something next, as long as nothing is acquired or released until then
+    std::optional<Time::steady_tp> nextIdleRelease(const Time::steady_dur& timeout) const;
+    // drops the framebuffers nobody holds
+    void                           clear();
+
+    bool                           empty() const;
+    SStats                         stats() const;
+
+  protected:
+    // the GL side of acquire()
+    virtual void allocate(CFramebuffer& fb, const Vector2D& size, DRMFormat format);
+    virtual void attachStencil(CFramebuffer& fb, SP<CTexture> stencil);
+
+  private:
+    struct SEntry {
+        SP<CFramebuffer> fb;
+        SP<CTexture>     stencil; // attached, resizing the framebuffer would resize it too
+        Time::steady_tp  lastAcquired;
+    };
+
+    std::vector<SEntry> m_fbs;
+    size_t              m_allocations = 0;
+    size_t              m_reuses      = 0;
+};
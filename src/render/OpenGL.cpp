@@ -56,6 +56,9 @@ const std::vector<const char*> ASSET_PATHS = {
     "/usr/local/share",
 };
 
+// offscreen buffers nothing used for this long are given back to the driver
+static constexpr auto IDLE_FRAMEBUFFER_TIMEOUT = std::chrono::seconds(10);
+
 static inline void loadGLProc(void* pProc, const char* name) {
     void* proc = rc<void*>(eglGetProcAddress(name));
     if (proc == nullptr) {
@@ -208,6 +211,8 @@ void CHyprOpenGLImpl::initEGL(bool gbm) {
     }
 
     eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, m_eglContext);
+
+    m_programCache = makeUnique<CProgramBinaryCache>();
 }
 
 static bool drmDeviceHasName(const drmDevice* device, const std::string& name) {
@@ -433,9 +438,15 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_drmFD(g_pCompositor->m_drmRenderNode.fd >
 
         addLastPressToHistory(TOUCH_COORDS, g_pInputManager->getClickMode() == CLICKMODE_KILL, true);
     });
+
+    m_idleFramebufferTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { releaseIdleFramebuffers(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_idleFramebufferTimer);
 }
 
 CHyprOpenGLImpl::~CHyprOpenGLImpl() {
+    if (g_pEventLoopManager && m_idleFramebufferTimer)
+        g_pEventLoopManager->removeTimer(m_idleFramebufferTimer);
+
     if (m_eglDisplay && m_eglContext != EGL_NO_CONTEXT)
         eglDestroyContext(m_eglDisplay, m_eglContext);
 
@@ -662,6 +673,11 @@ void CHyprOpenGLImpl::logShaderError(const GLuint& shader, bool program, bool si
 }
 
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag, bool dynamic, bool silent) {
+    if (m_programCache) {
+        if (const auto CACHED = m_programCache->load(vert, frag); CACHED)
+            return CACHED;
+    }
+
     auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert, dynamic, silent);
     if (dynamic) {
         if (vertCompiled == 0)
@@ -677,6 +693,8 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
         RASSERT(fragCompiled, "Compiling shader failed. FRAGMENT nullptr! Shader source:\n\n{}", frag);
 
     auto prog = glCreateProgram();
+    if (m_programCache)
+        m_programCache->prepare(prog);
     glAttachShader(prog, vertCompiled);
     glAttachShader(prog, fragCompiled);
     glLinkProgram(prog);
@@ -699,6 +717,9 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
         RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
     }
 
+    if (m_programCache)
+        m_programCache->store(prog, vert, frag);
+
     return prog;
 }
 
@@ -803,31 +824,40 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
 
     m_renderData.monitorProjection = pMonitor->m_projMatrix;
 
-    if (m_monitorRenderResources.contains(pMonitor) && m_monitorRenderResources.at(pMonitor).offloadFB.m_size != pMonitor->m_pixelSize)
-        destroyMonitorResources(pMonitor);
-
     m_renderData.pCurrentMonData = &m_monitorRenderResources[pMonitor];
 
+    // a mode change, nothing in the pool is of any use anymore.
+    // Dropped in place, captures may be holding on to the monitor's data right now.
+    if (auto& data = *m_renderData.pCurrentMonData; data.size != pMonitor->m_pixelSize) {
+        data.offloadFB.reset();
+        data.mirrorFB.reset();
+        data.mirrorSwapFB.reset();
+        data.offMainFB.reset();
+        data.monitorMirrorFB.reset();
+        data.blurFB.reset();
+        data.framebuffers.clear();
+
+        data.blurFBDirty = true;
+        data.size        = pMonitor->m_pixelSize;
+    }
+
     if (!m_shadersInitialized)
         initShaders();
 
     const auto DRM_FORMAT = fb ? fb->m_drmFormat : pMonitor->m_output->state->state().drmFormat;
 
-    // ensure a framebuffer for the monitor exists
-    if (m_renderData.pCurrentMonData->offloadFB.m_size != pMonitor->m_pixelSize || DRM_FORMAT != m_renderData.pCurrentMonData->offloadFB.m_drmFormat) {
-        m_renderData.pCurrentMonData->stencilTex->allocate();
-
-        m_renderData.pCurrentMonData->offloadFB.alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, DRM_FORMAT);
-        m_renderData.pCurrentMonData->mirrorFB.alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, DRM_FORMAT);
-        m_renderData.pCurrentMonData->mirrorSwapFB.alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, DRM_FORMAT);
+    // ensure a framebuffer for the monitor exists. Only damage is redrawn into it, so a new one,
+    // after a mode change or after it went idle, needs a full frame.
+    const auto PREVOFFLOAD = m_renderData.pCurrentMonData->offloadFB.get();
+    if (acquireMonitorFB(m_renderData.pCurrentMonData->offloadFB, DRM_FORMAT, true) != PREVOFFLOAD)
+        pMonitor->m_forceFullFrames = std::max(pMonitor->m_forceFullFrames, 1);
 
-        m_renderData.pCurrentMonData->offloadFB.addStencil(m_renderData.pCurrentMonData->stencilTex);
-        m_renderData.pCurrentMonData->mirrorFB.addStencil(m_renderData.pCurrentMonData->stencilTex);
-        m_renderData.pCurrentMonData->mirrorSwapFB.addStencil(m_renderData.pCurrentMonData->stencilTex);
-    }
+    if (m_renderData.pCurrentMonData->monitorMirrorFB && m_renderData.pMonitor->m_mirrors.empty())
+        m_renderData.pCurrentMonData->monitorMirrorFB.reset();
 
-    if (m_renderData.pCurrentMonData->monitorMirrorFB.isAllocated() && m_renderData.pMonitor->m_mirrors.empty())
-        m_renderData.pCurrentMonData->monitorMirrorFB.release();
+    m_renderData.pCurrentMonData->lastFrame = Time::steadyNow();
+    if (!m_idleFramebufferTimer->armed())
+        m_idleFramebufferTimer->updateTimeout(IDLE_FRAMEBUFFER_TIMEOUT);
 
     m_renderData.damage.set(damage_);
     m_renderData.finalDamage.set(finalDamage.value_or(damage_));
@@ -840,8 +870,8 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
         applyScreenShader(*PSHADER);
     }
 
-    m_renderData.pCurrentMonData->offloadFB.bind();
-    m_renderData.currentFB = &m_renderData.pCurrentMonData->offloadFB;
+    m_renderData.pCurrentMonData->offloadFB->bind();
+    m_renderData.currentFB = m_renderData.pCurrentMonData->offloadFB.get();
     m_offloadedFramebuffer = true;
 
     m_renderData.mainFB = m_renderData.currentFB;
@@ -879,9 +909,9 @@ void CHyprOpenGLImpl::end() {
         blend(false);
 
         if (m_finalScreenShader.program < 1 && !g_pHyprRenderer->m_crashingInProgress)
-            renderTexturePrimitive(m_renderData.pCurrentMonData->offloadFB.getTexture(), monbox);
+            renderTexturePrimitive(m_renderData.pCurrentMonData->offloadFB->getTexture(), monbox);
         else
-            renderTexture(m_renderData.pCurrentMonData->offloadFB.getTexture(), monbox, {});
+            renderTexture(m_renderData.pCurrentMonData->offloadFB->getTexture(), monbox, {});
 
         blend(true);
 
@@ -900,11 +930,11 @@ void CHyprOpenGLImpl::end() {
     m_renderData.outFB             = nullptr;
     popMonitorTransformEnabled();
 
-    // if we dropped to offMain, release it now.
-    // if there is a plugin constantly using it, this might be a bit slow,
-    // but I haven't seen a single plugin yet use these, so it's better to drop a bit of vram.
-    if (m_renderData.pCurrentMonData->offMainFB.isAllocated())
-        m_renderData.pCurrentMonData->offMainFB.release();
+    // give the scratch buffers back, the next frame most likely gets the same ones
+    // and if nothing needs them for a while the pool drops them.
+    m_renderData.pCurrentMonData->mirrorFB.reset();
+    m_renderData.pCurrentMonData->mirrorSwapFB.reset();
+    m_renderData.pCurrentMonData->offMainFB.reset();
 
     // check for gl errors
     const GLenum ERR = glGetError();
@@ -1428,7 +1458,7 @@ void CHyprOpenGLImpl::renderRectWithBlurInternal(const CBox& box, const CHyprCol
     CRegion damage{m_renderData.damage};
     damage.intersect(box);
 
-    CFramebuffer* POUTFB = data.xray ? &m_renderData.pCurrentMonData->blurFB : blurMainFramebufferWithDamage(data.blurA, &damage);
+    CFramebuffer* POUTFB = data.xray && m_renderData.pCurrentMonData->blurFB ? m_renderData.pCurrentMonData->blurFB.get() : blurMainFramebufferWithDamage(data.blurA, &damage);
 
     m_renderData.currentFB->bind();
 
@@ -1972,7 +2002,7 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
 CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* originalDamage) {
     if (!m_renderData.currentFB->getTexture()) {
         Log::logger->log(Log::ERR, "BUG THIS: null fb texture while attempting to blur main fb?! (introspection off?!)");
-        return &m_renderData.pCurrentMonData->mirrorFB; // return something to sample from at least
+        return getMirrorFB(); // return something to sample from at least
     }
 
     return blurFramebufferWithDamage(a, originalDamage, *m_renderData.currentFB);
@@ -2006,8 +2036,8 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
     damage.expand(std::clamp(*PBLURSIZE, sc<int64_t>(1), sc<int64_t>(40)) * pow(2, BLUR_PASSES));
 
     // helper
-    const auto    PMIRRORFB     = &m_renderData.pCurrentMonData->mirrorFB;
-    const auto    PMIRRORSWAPFB = &m_renderData.pCurrentMonData->mirrorSwapFB;
+    const auto    PMIRRORFB     = getMirrorFB();
+    const auto    PMIRRORSWAPFB = getMirrorSwapFB();
 
     CFramebuffer* currentRenderToFB = PMIRRORFB;
 
@@ -2279,9 +2309,7 @@ void CHyprOpenGLImpl::preBlurForCurrentMonitor() {
     const auto POUTFB = blurMainFramebufferWithDamage(1, &fakeDamage);
 
     // render onto blurFB
-    m_renderData.pCurrentMonData->blurFB.alloc(m_renderData.pMonitor->m_pixelSize.x, m_renderData.pMonitor->m_pixelSize.y,
-                                               m_renderData.pMonitor->m_output->state->state().drmFormat);
-    m_renderData.pCurrentMonData->blurFB.bind();
+    acquireMonitorFB(m_renderData.pCurrentMonData->blurFB, m_renderData.pMonitor->m_output->state->state().drmFormat, false)->bind();
 
     clear(CHyprColor(0, 0, 0, 0));
 
@@ -2317,7 +2345,7 @@ bool CHyprOpenGLImpl::shouldUseNewBlurOptimizations(PHLLS pLayer, PHLWINDOW pWin
     static auto PBLURNEWOPTIMIZE = CConfigValue<Hyprlang::INT>("decoration:blur:new_optimizations");
     static auto PBLURXRAY        = CConfigValue<Hyprlang::INT>("decoration:blur:xray");
 
-    if (!m_renderData.pCurrentMonData->blurFB.getTexture())
+    if (!m_renderData.pCurrentMonData->blurFB || !m_renderData.pCurrentMonData->blurFB->getTexture())
         return false;
 
     if (pWindow && pWindow->m_ruleApplicator->xray().hasValue() && !pWindow->m_ruleApplicator->xray().valueOrDefault())
@@ -2382,7 +2410,7 @@ void CHyprOpenGLImpl::renderTextureWithBlurInternal(SP<CTexture> tex, const CBox
         inverseOpaque.intersect(texDamage);
         POUTFB = blurMainFramebufferWithDamage(data.a, &inverseOpaque);
     } else
-        POUTFB = &m_renderData.pCurrentMonData->blurFB;
+        POUTFB = m_renderData.pCurrentMonData->blurFB.get();
 
     m_renderData.currentFB->bind();
 
@@ -2718,11 +2746,7 @@ void CHyprOpenGLImpl::renderRoundedShadow(const CBox& box, int round, float roun
 
 void CHyprOpenGLImpl::saveBufferForMirror(const CBox& box) {
 
-    if (!m_renderData.pCurrentMonData->monitorMirrorFB.isAllocated())
-        m_renderData.pCurrentMonData->monitorMirrorFB.alloc(m_renderData.pMonitor->m_pixelSize.x, m_renderData.pMonitor->m_pixelSize.y,
-                                                            m_renderData.pMonitor->m_output->state->state().drmFormat);
-
-    m_renderData.pCurrentMonData->monitorMirrorFB.bind();
+    acquireMonitorFB(m_renderData.pCurrentMonData->monitorMirrorFB, m_renderData.pMonitor->m_output->state->state().drmFormat, false)->bind();
 
     blend(false);
 
@@ -2753,8 +2777,8 @@ void CHyprOpenGLImpl::renderMirrored() {
     monbox.x = (monitor->m_transformedSize.x - monbox.w) / 2;
     monbox.y = (monitor->m_transformedSize.y - monbox.h) / 2;
 
-    const auto PFB = &m_monitorRenderResources[mirrored].monitorMirrorFB;
-    if (!PFB->isAllocated() || !PFB->getTexture())
+    const auto PFB = m_monitorRenderResources[mirrored].monitorMirrorFB;
+    if (!PFB || !PFB->isAllocated() || !PFB->getTexture())
         return;
 
     g_pHyprRenderer->m_renderPass.add(makeUnique<CClearPassElement>(CClearPassElement::SClearData{CHyprColor(0, 0, 0, 0)}));
@@ -2875,30 +2899,58 @@ SP<CTexture> CHyprOpenGLImpl::texFromCairo(cairo_surface_t* cairo) {
     return tex;
 }
 
+size_t CHyprOpenGLImpl::STextKeyHash::operator()(const STextKey& key) const {
+    size_t     hash    = std::hash<std::string_view>{}(key.text);
+    const auto combine = [&hash](size_t v) { hash ^= v + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+    combine(std::hash<std::string_view>{}(key.font));
+    combine(key.color);
+    combine(key.pt);
+    combine(key.maxWidth);
+    combine((key.weight << 1) | key.italic);
+
+    return hash;
+}
+
 SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
-    SP<CTexture>          tex = makeShared<CTexture>();
+    static auto FONT = CConfigValue<std::string>("misc:font_family");
+
+    // group bar titles, notifications and errors keep asking for the same few strings.
+    // Textures handed out are shared, nobody draws into them after this.
+    STextKey key = {
+        .text     = text,
+        .font     = fontFamily.empty() ? FONT.view() : std::string_view{fontFamily},
+        .pt       = pt,
+        .maxWidth = maxWidth,
+        .weight   = weight,
+        .italic   = italic,
+        .color    = col.getAsHex(),
+    };
 
-    static auto           FONT = CConfigValue<std::string>("misc:font_family");
+    if (const auto IT = m_textCache.byKey.find(key); IT != m_textCache.byKey.end()) {
+        m_textCache.lru.splice(m_textCache.lru.begin(), m_textCache.lru, IT->second);
+        return IT->second->tex;
+    }
 
-    const auto            FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
-    const auto            FONTSIZE   = pt;
-    const auto            COLOR      = col;
+    // from here on, the key has to view strings we own
+    auto& entry = m_textCache.lru.emplace_front(STextEntry{.text = text, .font = std::string{key.font}});
+    key.text    = entry.text;
+    key.font    = entry.font;
+    entry.key   = key;
+    entry.tex   = makeShared<CTexture>();
 
-    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1920, 1080 /* arbitrary, just for size */);
-    auto                  CAIRO        = cairo_create(CAIROSURFACE);
+    // only needed for the layout to pick up the same font options as the surface we draw into
+    auto                  MEASURESURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    auto                  MEASURECAIRO   = cairo_create(MEASURESURFACE);
 
-    PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
+    PangoLayout*          layoutText = pango_cairo_create_layout(MEASURECAIRO);
     PangoFontDescription* pangoFD    = pango_font_description_new();
 
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
+    pango_font_description_set_family_static(pangoFD, entry.font.c_str());
+    pango_font_description_set_absolute_size(pangoFD, pt * PANGO_SCALE);
     pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
     pango_font_description_set_weight(pangoFD, sc<PangoWeight>(weight));
     pango_layout_set_font_description(layoutText, pangoFD);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
-    int textW = 0, textH = 0;
     pango_layout_set_text(layoutText, text.c_str(), -1);
 
     if (maxWidth > 0) {
@@ -2906,53 +2958,61 @@ SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col
         pango_layout_set_ellipsize(layoutText, PANGO_ELLIPSIZE_END);
     }
 
+    int textW = 0, textH = 0;
     pango_layout_get_size(layoutText, &textW, &textH);
     textW /= PANGO_SCALE;
     textH /= PANGO_SCALE;
 
     pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
+    cairo_destroy(MEASURECAIRO);
+    cairo_surface_destroy(MEASURESURFACE);
 
-    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
-    CAIRO        = cairo_create(CAIROSURFACE);
+    // draw the layout we just measured, no need to shape it again
+    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
+    const auto CAIRO        = cairo_create(CAIROSURFACE);
 
-    layoutText = pango_cairo_create_layout(CAIRO);
-    pangoFD    = pango_font_description_new();
+    pango_cairo_update_layout(CAIRO, layoutText);
 
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, sc<PangoWeight>(weight));
-    pango_layout_set_font_description(layoutText, pangoFD);
-    pango_layout_set_text(layoutText, text.c_str(), -1);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+    cairo_set_source_rgba(CAIRO, col.r, col.g, col.b, col.a);
 
     cairo_move_to(CAIRO, 0, 0);
     pango_cairo_show_layout(CAIRO, layoutText);
 
-    pango_font_description_free(pangoFD);
     g_object_unref(layoutText);
 
     cairo_surface_flush(CAIROSURFACE);
 
-    tex->allocate();
-    tex->m_size = {cairo_image_surface_get_width(CAIROSURFACE), cairo_image_surface_get_height(CAIROSURFACE)};
+    entry.tex->allocate();
+    entry.tex->m_size = {cairo_image_surface_get_width(CAIROSURFACE), cairo_image_surface_get_height(CAIROSURFACE)};
 
     const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    tex->bind();
-    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->m_size.x, tex->m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    entry.tex->bind();
+    entry.tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    entry.tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    entry.tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    entry.tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, entry.tex->m_size.x, entry.tex->m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
 
     cairo_destroy(CAIRO);
     cairo_surface_destroy(CAIROSURFACE);
 
-    return tex;
+    const size_t BYTES = sc<size_t>(textW) * textH * 4;
+
+    m_textCache.byKey.emplace(key, m_textCache.lru.begin());
+    m_textCache.bytes += BYTES;
+
+    constexpr size_t MAX_CACHED_TEXTS = 128;
+    constexpr size_t MAX_CACHED_BYTES = 32 * 1024 * 1024;
+
+    // least recently used go first, but always keep what we just made
+    while (m_textCache.lru.size() > 1 && (m_textCache.lru.size() > MAX_CACHED_TEXTS || m_textCache.bytes > MAX_CACHED_BYTES)) {
+        const auto& OLD = m_textCache.lru.back();
+        m_textCache.bytes -= sc<size_t>(OLD.tex->m_size.x) * OLD.tex->m_size.y * 4;
+        m_textCache.byKey.erase(OLD.key);
+        m_textCache.lru.pop_back();
+    }
+
+    return entry.tex;
 }
 
 void CHyprOpenGLImpl::initMissingAssetTexture() {
@@ -3226,12 +3286,7 @@ void CHyprOpenGLImpl::destroyMonitorResources(PHLMONITORREF pMonitor) {
 
     auto RESIT = g_pHyprOpenGL->m_monitorRenderResources.find(pMonitor);
     if (RESIT != g_pHyprOpenGL->m_monitorRenderResources.end()) {
-        RESIT->second.mirrorFB.release();
-        RESIT->second.offloadFB.release();
-        RESIT->second.mirrorSwapFB.release();
-        RESIT->second.monitorMirrorFB.release();
-        RESIT->second.blurFB.release();
-        RESIT->second.offMainFB.release();
+        // frames still being captured keep their framebuffers, the rest go with the pool
         RESIT->second.stencilTex->destroyTexture();
         g_pHyprOpenGL->m_monitorRenderResources.erase(RESIT);
     }
@@ -3259,16 +3314,61 @@ void CHyprOpenGLImpl::restoreMatrix() {
 }
 
 void CHyprOpenGLImpl::bindOffMain() {
-    if (!m_renderData.pCurrentMonData->offMainFB.isAllocated()) {
-        m_renderData.pCurrentMonData->offMainFB.alloc(m_renderData.pMonitor->m_pixelSize.x, m_renderData.pMonitor->m_pixelSize.y,
-                                                      m_renderData.pMonitor->m_output->state->state().drmFormat);
+    m_renderData.currentFB = acquireMonitorFB(m_renderData.pCurrentMonData->offMainFB, m_renderData.pMonitor->m_output->state->state().drmFormat, true);
+    m_renderData.currentFB->bind();
+    clear(CHyprColor(0, 0, 0, 0));
+}
+
+CFramebuffer* CHyprOpenGLImpl::getMirrorFB() {
+    return acquireMonitorFB(m_renderData.pCurrentMonData->mirrorFB, m_renderData.mainFB->m_drmFormat, true);
+}
+
+CFramebuffer* CHyprOpenGLImpl::getMirrorSwapFB() {
+    return acquireMonitorFB(m_renderData.pCurrentMonData->mirrorSwapFB, m_renderData.mainFB->m_drmFormat, true);
+}
+
+CFramebuffer* CHyprOpenGLImpl::acquireMonitorFB(SP<CFramebuffer>& fb, DRMFormat format, bool stencil) {
+    const auto DATA = m_renderData.pCurrentMonData;
+    const auto SIZE = m_renderData.pMonitor->m_pixelSize;
+
+    if (!fb || fb->m_size != SIZE || fb->m_drmFormat != format)
+        fb = DATA->framebuffers.acquire(SIZE, format, stencil ? DATA->stencilTex : nullptr);
+
+    return fb.get();
+}
 
-        m_renderData.pCurrentMonData->offMainFB.addStencil(m_renderData.pCurrentMonData->stencilTex);
+void CHyprOpenGLImpl::releaseIdleFramebuffers() {
+    g_pHyprRenderer->makeEGLCurrent();
+
+    const auto                     NOW = Time::steadyNow();
+    std::optional<Time::steady_tp> next;
+
+    const auto                     releaseAt = [&next](const Time::steady_tp& when) {
+        if (!next || when < *next)
+            next = when;
+    };
+
+    for (auto& [monitor, data] : m_monitorRenderResources) {
+        if (NOW - data.lastFrame > IDLE_FRAMEBUFFER_TIMEOUT) {
+            // begin() redraws everything once it has to get a new offload buffer
+            if (data.blurFB)
+                data.blurFBDirty = true;
+
+            data.offloadFB.reset();
+            data.blurFB.reset();
+        } else if (data.offloadFB || data.blurFB)
+            releaseAt(data.lastFrame + IDLE_FRAMEBUFFER_TIMEOUT);
+
+        data.framebuffers.releaseIdle(IDLE_FRAMEBUFFER_TIMEOUT, NOW);
+
+        if (const auto AT = data.framebuffers.nextIdleRelease(IDLE_FRAMEBUFFER_TIMEOUT); AT)
+            releaseAt(*AT);
     }
 
-    m_renderData.pCurrentMonData->offMainFB.bind();
-    clear(CHyprColor(0, 0, 0, 0));
-    m_renderData.currentFB = &m_renderData.pCurrentMonData->offMainFB;
+    // only come back for what can go idle, anything acquired in use stays until its holder lets go
+    // and the next frame arms us again
+    if (next)
+        m_idleFramebufferTimer->updateTimeout(std::max<Time::steady_dur>(*next - NOW, std::chrono::seconds(1)));
 }
 
 void CHyprOpenGLImpl::renderOffToMain(CFramebuffer* off) {
@@ -10,16 +10,21 @@
 #include <GLES3/gl32.h>
 #include <cstdint>
 #include <list>
+#include <string_view>
 #include <string>
 #include <stack>
 #include <map>
+#include <unordered_map>
 
 #include <cairo/cairo.h>
 
 #include "Shader.hpp"
+#include "ProgramCache.hpp"
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
 #include "Renderbuffer.hpp"
+#include "FramebufferPool.hpp"
+#include "AsyncReadback.hpp"
 #include "pass/Pass.hpp"
 
 #include <EGL/egl.h>
@@ -100,18 +105,27 @@ struct SPreparedShaders {
     SShader     m_shCM;
 };
 
+// offscreen buffers come from the pool when a frame needs them. mirrorFB, mirrorSwapFB and offMainFB go back
+// at the end of the frame, the rest once they're not needed anymore or the monitor has been idle for a while
 struct SMonitorRenderData {
-    CFramebuffer offloadFB;
-    CFramebuffer mirrorFB;     // these are used for some effects,
-    CFramebuffer mirrorSwapFB; // etc
-    CFramebuffer offMainFB;
-    CFramebuffer monitorMirrorFB; // used for mirroring outputs, does not contain artifacts like offloadFB
-    CFramebuffer blurFB;
+    SP<CFramebuffer>   offloadFB;
+    SP<CFramebuffer>   mirrorFB;     // these are used for some effects,
+    SP<CFramebuffer>   mirrorSwapFB; // etc
+    SP<CFramebuffer>   offMainFB;
+    SP<CFramebuffer>   monitorMirrorFB; // used for mirroring outputs, does not contain artifacts like offloadFB
+    SP<CFramebuffer>   blurFB;
 
-    SP<CTexture> stencilTex = makeShared<CTexture>();
+    SP<CTexture>       stencilTex = makeShared<CTexture>();
 
-    bool         blurFBDirty        = true;
-    bool         blurFBShouldRender = false;
+    bool               blurFBDirty        = true;
+    bool               blurFBShouldRender = false;
+
+    Vector2D           size; // of the monitor when the buffers were made
+    Time::steady_tp    lastFrame;
+
+    // all of the above, screencopy and toplevel export
+    CFramebufferPool   framebuffers;
+    SP<CAsyncReadback> captureReadback = CAsyncReadback::create();
 };
 
 struct SCurrentRenderData {
@@ -171,6 +185,7 @@ class CEGLSync {
 };
 
 class CGradientValueData;
+class CEventLoopTimer;
 
 class CHyprOpenGLImpl {
   public:
@@ -261,6 +276,10 @@ class CHyprOpenGLImpl {
     void         renderOffToMain(CFramebuffer* off);
     void         bindBackOnMain();
 
+    // scratch buffers of the monitor being rendered, valid until end()
+    CFramebuffer* getMirrorFB();
+    CFramebuffer* getMirrorSwapFB();
+
     std::string  resolveAssetPath(const std::string& file);
     SP<CTexture> loadAsset(const std::string& file);
     SP<CTexture> texFromCairo(cairo_surface_t* cairo);
@@ -396,6 +415,39 @@ class CHyprOpenGLImpl {
     GLint                                                m_pressedHistoryKilled    = 0;
     GLint                                                m_pressedHistoryTouched   = 0;
 
+    // renderText results, least recently used evicted first.
+    // Keys only view the strings, so a lookup doesn't have to copy anything.
+    struct STextKey {
+        std::string_view text;
+        std::string_view font;
+        int              pt       = 0;
+        int              maxWidth = 0;
+        int              weight   = 0;
+        bool             italic   = false;
+        uint32_t         color    = 0;
+
+        bool             operator==(const STextKey&) const = default;
+    };
+
+    struct STextKeyHash {
+        size_t operator()(const STextKey& key) const;
+    };
+
+    struct STextEntry {
+        std::string  text;
+        std::string  font;
+        STextKey     key; // views the two above
+        SP<CTexture> tex;
+    };
+
+    struct {
+        std::list<STextEntry>                                               lru; // most recently used first
+        std::unordered_map<STextKey, decltype(lru)::iterator, STextKeyHash> byKey;
+        size_t                                                              bytes = 0;
+    } m_textCache;
+
+    UP<CProgramBinaryCache> m_programCache;
+
     //
     std::optional<std::vector<uint64_t>> getModsForFormat(EGLint format);
 
@@ -416,6 +468,11 @@ class CHyprOpenGLImpl {
 
     void          preBlurForCurrentMonitor();
 
+    // (re)acquires fb from the current monitor's pool unless it already fits
+    CFramebuffer*       acquireMonitorFB(SP<CFramebuffer>& fb, DRMFormat format, bool stencil);
+    void                releaseIdleFramebuffers();
+    SP<CEventLoopTimer> m_idleFramebufferTimer;
+
     friend class CHyprRenderer;
     friend class CTexPassElement;
     friend class CPreBlurElement;
@@ -0,0 +1,253 @@
+#include "ProgramCache.hpp"
+#include "../debug/log/Logger.hpp"
+#include "../helpers/memory/Memory.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+constexpr uint32_t CACHE_MAGIC = 0x48504243; // HPBC
+
+// loading an entry refreshes it, so only binaries of drivers and shaders nobody runs anymore get this old
+constexpr std::chrono::hours CACHE_ENTRY_MAX_AGE = std::chrono::days(30);
+constexpr std::chrono::hours CACHE_TMP_MAX_AGE   = std::chrono::hours(1);
+
+struct SCacheHeader {
+    uint32_t magic  = CACHE_MAGIC;
+    uint32_t format = 0;
+    uint32_t length = 0;
+    uint64_t check  = 0;
+};
+
+static uint64_t fnv1a(uint64_t hash, std::string_view data) {
+    for (const auto c : data) {
+        hash ^= sc<uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t hashKey(uint64_t seed, const std::string& driver, const std::string& vert, const std::string& frag) {
+    // lengths first, so moving text between the sources changes the hash
+    auto hash = fnv1a(seed, std::format("{}:{}:{}:", driver.size(), vert.size(), frag.size()));
+    hash      = fnv1a(hash, driver);
+    hash      = fnv1a(hash, vert);
+    return fnv1a(hash, frag);
+}
+
+CProgramBinaryCache::CProgramBinaryCache() {
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        Log::logger->log(Log::DEBUG, "CProgramBinaryCache: the driver can't give us program binaries, not caching");
+        return;
+    }
+
+    const auto glString = [](GLenum name) {
+        const auto STR = rc<const char*>(glGetString(name));
+        return std::string{STR ? STR : ""};
+    };
+
+    m_driver = glString(GL_VENDOR) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+
+    const auto CACHE_HOME = getenv("XDG_CACHE_HOME");
+    const auto HOME       = getenv("HOME");
+
+    std::filesystem::path root;
+    if (CACHE_HOME && CACHE_HOME[0] == '/')
+        root = std::filesystem::path{CACHE_HOME} / "hyprland" / "shaders";
+    else if (HOME)
+        root = std::filesystem::path{HOME} / ".cache" / "hyprland" / "shaders";
+    else {
+        Log::logger->log(Log::DEBUG, "CProgramBinaryCache: no $XDG_CACHE_HOME or $HOME, not caching");
+        return;
+    }
+
+    if (useDirectory(root))
+        prune();
+}
+
+CProgramBinaryCache::CProgramBinaryCache(const std::filesystem::path& root, const std::string& driver) : m_driver(driver) {
+    useDirectory(root);
+}
+
+bool CProgramBinaryCache::useDirectory(const std::filesystem::path& root) {
+    // nested sessions and other GPUs share the root, never mix their binaries
+    const auto      DIR = root / std::format("{:016x}", fnv1a(0xcbf29ce484222325ULL, m_driver));
+
+    std::error_code ec;
+    std::filesystem::create_directories(DIR, ec);
+    if (ec) {
+        Log::logger->log(Log::ERR, "CProgramBinaryCache: can't create {}: {}, not caching", DIR.string(), ec.message());
+        return false;
+    }
+
+    m_dir = DIR;
+    return true;
+}
+
+bool CProgramBinaryCache::enabled() {
+    return m_dir.has_value();
+}
+
+CProgramBinaryCache::SKey CProgramBinaryCache::keyFor(const std::string& vert, const std::string& frag) {
+    const auto NAME = hashKey(0xcbf29ce484222325ULL, m_driver, vert, frag);
+
+    return {.path = *m_dir / std::format("{:016x}.bin", NAME), .check = hashKey(0x84222325cbf29ce4ULL, m_driver, vert, frag)};
+}
+
+std::optional<CProgramBinaryCache::SEntry> CProgramBinaryCache::readEntry(const std::string& vert, const std::string& frag) {
+    const auto    KEY = keyFor(vert, frag);
+
+    std::ifstream file(KEY.path, std::ios::binary);
+    if (!file.good())
+        return std::nullopt;
+
+    SCacheHeader header;
+    file.read(rc<char*>(&header), sizeof(header));
+
+    SEntry entry;
+    if (file.good() && header.magic == CACHE_MAGIC && header.check == KEY.check) {
+        entry.format = header.format;
+        entry.data.resize(header.length);
+        file.read(entry.data.data(), header.length);
+    }
+
+    if (entry.data.empty() || !file.good()) {
+        Log::logger->log(Log::DEBUG, "CProgramBinaryCache: dropping bad entry {}", KEY.path.string());
+        std::error_code ec;
+        std::filesystem::remove(KEY.path, ec);
+        return std::nullopt;
+    }
+
+    // what's still loaded doesn't age out
+    std::error_code ec;
+    std::filesystem::last_write_time(KEY.path, std::filesystem::file_time_type::clock::now(), ec);
+
+    return entry;
+}
+
+bool CProgramBinaryCache::writeEntry(const std::string& vert, const std::string& frag, const SEntry& entry) {
+    const auto   KEY    = keyFor(vert, frag);
+    SCacheHeader header = {.format = entry.format, .length = sc<uint32_t>(entry.data.size()), .check = KEY.check};
+
+    // write aside and rename, another instance might be reading the same entry
+    const auto TMP = std::filesystem::path{KEY.path}.concat(std::format(".{}.tmp", getpid()));
+    {
+        std::ofstream file(TMP, std::ios::binary | std::ios::trunc);
+        file.write(rc<const char*>(&header), sizeof(header));
+        file.write(entry.data.data(), entry.data.size());
+
+        if (!file.good()) {
+            Log::logger->log(Log::DEBUG, "CProgramBinaryCache: failed writing {}", TMP.string());
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(TMP, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(TMP, KEY.path, ec);
+    if (ec) {
+        std::filesystem::remove(TMP, ec);
+        return false;
+    }
+
+    return true;
+}
+
+GLuint CProgramBinaryCache::load(const std::string& vert, const std::string& frag) {
+    if (!enabled())
+        return 0;
+
+    const auto ENTRY = readEntry(vert, frag);
+    if (!ENTRY)
+        return 0;
+
+    const auto PROG = glCreateProgram();
+    glProgramBinary(PROG, ENTRY->format, ENTRY->data.data(), ENTRY->data.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(PROG, GL_LINK_STATUS, &ok);
+    if (ok != GL_TRUE) {
+        // usually a driver update that kept its version string, rebuild from source
+        const auto PATH = keyFor(vert, frag).path;
+        Log::logger->log(Log::DEBUG, "CProgramBinaryCache: driver rejected {}, recompiling", PATH.string());
+        glDeleteProgram(PROG);
+        std::error_code ec;
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    return PROG;
+}
+
+void CProgramBinaryCache::prepare(GLuint program) {
+    if (enabled())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void CProgramBinaryCache::store(GLuint program, const std::string& vert, const std::string& frag) {
+    if (!enabled())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> data(length);
+    GLenum            format  = 0;
+    GLsizei           written = 0;
+    glGetProgramBinary(program, length, &written, &format, data.data());
+    if (written <= 0)
+        return;
+
+    data.resize(written);
+    writeEntry(vert, frag, {.format = format, .data = std::move(data)});
+}
+
+void CProgramBinaryCache::prune() {
+    if (!enabled())
+        return;
+
+    const auto                         NOW = std::filesystem::file_time_type::clock::now();
+
+    std::vector<std::filesystem::path> stale;
+    std::vector<std::filesystem::path> otherDrivers;
+    std::error_code                    ec;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(m_dir->parent_path(), ec)) {
+        const auto NAME = entry.path().filename().string();
+
+        if (entry.is_directory(ec)) {
+            if (entry.path() != *m_dir)
+                otherDrivers.emplace_back(entry.path());
+            continue;
+        }
+
+        // a .tmp is a store another instance is in the middle of, unless it died there
+        const auto MAXAGE = NAME.ends_with(".tmp") ? std::optional{CACHE_TMP_MAX_AGE} : NAME.ends_with(".bin") ? std::optional{CACHE_ENTRY_MAX_AGE} : std::nullopt;
+        if (!MAXAGE)
+            continue;
+
+        std::error_code timeEc;
+        const auto      WRITTEN = std::filesystem::last_write_time(entry.path(), timeEc);
+        if (!timeEc && WRITTEN < NOW - *MAXAGE)
+            stale.emplace_back(entry.path());
+    }
+
+    for (const auto& path : stale)
+        std::filesystem::remove(path, ec);
+
+    // only goes if it's empty by now
+    for (const auto& path : otherDrivers)
+        std::filesystem::remove(path, ec);
+
+    if (!stale.empty())
+        Log::logger->log(Log::DEBUG, "CProgramBinaryCache: pruned {} stale entries", stale.size());
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <GLES3/gl32.h>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+    On-disk cache of linked GL programs, in the driver's own binary format.
+    Entries are keyed by both shader sources and the GL vendor, renderer and version strings,
+    so a driver update or a changed shader just misses. A binary the driver refuses is dropped
+    and the program is compiled from source again. Each driver gets its own directory, other
+    sessions may well be using another one. Entries nobody loaded for a while are pruned.
+*/
+class CProgramBinaryCache {
+  public:
+    // needs a current GLES 3 context
+    CProgramBinaryCache();
+
+    bool enabled();
+
+    // a linked program, or 0 if there's nothing usable cached
+    GLuint load(const std::string& vert, const std::string& frag);
+
+    // call before linking a program that'll be stored
+    void prepare(GLuint program);
+    void store(GLuint program, const std::string& vert, const std::string& frag);
+
+    // removes entries of any driver that haven't been loaded or stored in a while
+    void prune();
+
+  protected:
+    // no GL, and no pruning
+    CProgramBinaryCache(const std::filesystem::path& root, const std::string& driver);
+
+    struct SEntry {
+        GLenum            format = 0;
+        std::vector<char> data;
+    };
+
+    std::optional<SEntry> readEntry(const std::string& vert, const std::string& frag);
+    bool                  writeEntry(const std::string& vert, const std::string& frag, const SEntry& entry);
+
+  private:
+    struct SKey {
+        std::filesystem::path path;
+        uint64_t              check = 0; // independent hash of the same inputs, guards against collisions in the name
+    };
+
+    SKey                                 keyFor(const std::string& vert, const std::string& frag);
+    bool                                 useDirectory(const std::filesystem::path& root);
+
+    std::optional<std::filesystem::path> m_dir;
+    std::string                          m_driver;
+};
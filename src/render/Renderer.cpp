@@ -28,6 +28,7 @@
 #include "../hyprerror/HyprError.hpp"
 #include "../debug/HyprDebugOverlay.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
+#include "../debug/FrameProfiler.hpp"
 #include "../i18n/Engine.hpp"
 #include "helpers/CursorShapes.hpp"
 #include "helpers/Monitor.hpp"
@@ -1290,8 +1291,13 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
     if (!g_pCompositor->m_sessionActive)
         return;
 
-    if (g_pAnimationManager)
-        g_pAnimationManager->frameTick();
+    TRACY_CPU_ZONE("RenderMonitor");
+    CProfilerFrame profilerFrame(pMonitor->m_id);
+
+    if (g_pAnimationManager) {
+        PROFILER_ZONE(PROFILER_STAGE_ANIMATION, "AnimationTick", pMonitor->m_id);
+        g_pAnimationManager->frameTick(pMonitor);
+    }
 
     if (pMonitor->m_id == m_mostHzMonitor->m_id ||
         *PVFR == 1) { // unfortunately with VFR we don't have the guarantee mostHz is going to be updated all the time, so we have to ignore that
@@ -1373,7 +1379,9 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         g_pHyprOpenGL->m_renderData.useNearestNeighbor = false;
     }
 
-    CRegion damage, finalDamage;
+    const auto PLAN_BEGIN = Time::steadyNow();
+
+    CRegion    damage, finalDamage;
     if (!beginRender(pMonitor, damage, RENDER_MODE_NORMAL)) {
         Log::logger->log(Log::ERR, "renderer: couldn't beginRender()!");
         return;
@@ -1461,7 +1469,12 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
 
     EMIT_HOOK_EVENT("render", RENDER_LAST_MOMENT);
 
-    endRender();
+    g_pFrameProfiler->addZone(PROFILER_STAGE_PLAN, "PlanPass", pMonitor->m_id, PLAN_BEGIN, Time::steadyNow());
+
+    {
+        PROFILER_ZONE(PROFILER_STAGE_RENDER, "RenderPass", pMonitor->m_id);
+        endRender();
+    }
 
     TRACY_GPU_COLLECT;
 
@@ -1487,8 +1500,10 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
     pMonitor->m_output->state->setPresentationMode(shouldTear ? Aquamarine::eOutputPresentationMode::AQ_OUTPUT_PRESENTATION_IMMEDIATE :
                                                                 Aquamarine::eOutputPresentationMode::AQ_OUTPUT_PRESENTATION_VSYNC);
 
-    if (commit)
+    if (commit) {
+        PROFILER_ZONE(PROFILER_STAGE_COMMIT, "Commit", pMonitor->m_id);
         commitPendingAndDoExplicitSync(pMonitor);
+    }
 
     if (shouldTear)
         pMonitor->m_tearingState.busy = true;
@@ -1932,10 +1947,12 @@ void CHyprRenderer::damageSurface(SP<CWLSurfaceResource> pSurface, double x, dou
 
     damageBox.translate({x, y});
 
-    CRegion damageBoxForEach;
+    const auto EXTENTS = damageBox.getExtents();
+
+    CRegion    damageBoxForEach;
 
     for (auto const& m : g_pCompositor->m_monitors) {
-        if (!m->m_output)
+        if (!m->m_output || !m->logicalBox().overlaps(EXTENTS))
             continue;
 
         damageBoxForEach.set(damageBox);
@@ -1999,7 +2016,7 @@ void CHyprRenderer::damageBox(const CBox& box, bool skipFrameSchedule) {
         if (m->isMirror())
             continue; // don't damage mirrors traditionally
 
-        if (!skipFrameSchedule) {
+        if (!skipFrameSchedule && m->logicalBox().overlaps(box)) {
             CBox damageBox = box.copy().translate(-m->m_position).scale(m->m_scale).round();
             m->addDamage(damageBox);
         }
@@ -2017,7 +2034,38 @@ void CHyprRenderer::damageBox(const int& x, const int& y, const int& w, const in
 }
 
 void CHyprRenderer::damageRegion(const CRegion& rg) {
-    rg.forEachRect([this](const auto& RECT) { damageBox(RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1); });
+    if (g_pCompositor->m_unsafeState || rg.empty())
+        return;
+
+    const auto EXTENTS = rg.getExtents();
+    CRegion    damageForEach;
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        if (m->isMirror())
+            continue; // don't damage mirrors traditionally
+
+        const auto BOX = m->logicalBox();
+        if (!BOX.overlaps(EXTENTS))
+            continue;
+
+        // clip first, so rects on other monitors don't widen what this one gets
+        damageForEach = rg.copy().intersect(BOX);
+        if (damageForEach.empty())
+            continue;
+
+        // the ring would merge this many rects anyway, don't transform each of them
+        if (damageForEach.getRects().size() > DAMAGE_RING_MAX_RECTS)
+            damageForEach = damageForEach.getExtents();
+
+        damageForEach.translate({-m->m_position.x, -m->m_position.y}).scale(m->m_scale);
+
+        m->addDamage(damageForEach);
+    }
+
+    static auto PLOGDAMAGE = CConfigValue<Hyprlang::INT>("debug:log_damage");
+
+    if (*PLOGDAMAGE)
+        Log::logger->log(Log::DEBUG, "Damage: Region (extents): xy: {}, {} wh: {}, {}", EXTENTS.x, EXTENTS.y, EXTENTS.w, EXTENTS.h);
 }
 
 void CHyprRenderer::damageMirrorsWith(PHLMONITOR pMonitor, const CRegion& pRegion) {
@@ -166,6 +166,7 @@ class CHyprRenderer {
 
     friend class CHyprOpenGLImpl;
     friend class CToplevelExportFrame;
+    friend class CImageCopyCaptureFrame;
     friend class CInputManager;
     friend class CPointerManager;
     friend class CMonitor;
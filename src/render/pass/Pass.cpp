@@ -10,6 +10,7 @@
 #include "../../render/Renderer.hpp"
 #include "../../desktop/state/FocusState.hpp"
 #include "../../protocols/core/Compositor.hpp"
+#include "../../helpers/time/Time.hpp"
 
 bool CRenderPass::empty() const {
     return false;
@@ -28,10 +29,38 @@ void CRenderPass::simplify() {
 
     // TODO: use precompute blur for instances where there is nothing in between
 
+    const auto PLANSTART = Time::steadyNow();
+    const auto SCALE     = g_pHyprOpenGL->m_renderData.pMonitor->m_scale;
+
     // if there is live blur, we need to NOT occlude any area where it will be influenced
     const auto WILLBLUR = std::ranges::any_of(m_passElements, [](const auto& el) { return el->element->needsLiveBlur(); });
 
-    CRegion    newDamage = m_damage.copy().intersect(CBox{{}, g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize});
+    // the live blur region below an element only changes at live blur elements, so build all of them
+    // in a single walk from the bottom, instead of walking everything below each opaque element.
+    // Expanding a union is the same as the union of the expanded parts.
+    m_liveBlurPrefixes.clear();
+    if (WILLBLUR) {
+        CRegion prefix;
+        for (auto& el : m_passElements) {
+            el->liveBlurPrefix = m_liveBlurPrefixes.size();
+
+            if (!el->element->needsLiveBlur())
+                continue;
+
+            const auto BB = el->element->boundingBox();
+            RASSERT(BB, "No bounding box for an element with live blur is illegal");
+
+            m_liveBlurPrefixes.emplace_back(prefix.copy());
+            prefix.add(CRegion{*BB}.scale(SCALE).expand(oneBlurRadius() * 2.F));
+            m_stats.regionOps += 3;
+        }
+
+        m_liveBlurPrefixes.emplace_back(std::move(prefix));
+    }
+
+    CRegion newDamage = m_damage.copy().intersect(CBox{{}, g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize});
+    m_stats.regionOps++;
+
     for (auto& el : m_passElements | std::views::reverse) {
 
         if (newDamage.empty() && !el->element->undiscardable()) {
@@ -44,9 +73,10 @@ void CRenderPass::simplify() {
         if (!bb1 || newDamage.empty())
             continue;
 
-        auto bb = bb1->scale(g_pHyprOpenGL->m_renderData.pMonitor->m_scale);
+        auto bb = bb1->scale(SCALE);
 
         // drop if empty
+        m_stats.regionOps++;
         if (CRegion copy = newDamage.copy(); copy.intersect(bb).empty()) {
             el->discard = true;
             continue;
@@ -55,37 +85,24 @@ void CRenderPass::simplify() {
         auto opaque = el->element->opaqueRegion();
 
         if (!opaque.empty()) {
-            opaque.scale(g_pHyprOpenGL->m_renderData.pMonitor->m_scale);
+            opaque.scale(SCALE);
 
             // if this intersects the liveBlur region, allow live blur to operate correctly.
             // do not occlude a border near it.
+            // if the blur is above us, we don't care, it will work fine.
             if (WILLBLUR) {
-                CRegion liveBlurRegion;
-                for (auto& el2 : m_passElements) {
-                    // if we reach self, no problem, we can break.
-                    // if the blur is above us, we don't care, it will work fine.
-                    if (el2 == el)
-                        break;
-
-                    if (!el2->element->needsLiveBlur())
-                        continue;
-
-                    const auto BB = el2->element->boundingBox();
-                    RASSERT(BB, "No bounding box for an element with live blur is illegal");
-
-                    liveBlurRegion.add(*BB);
-                }
+                const auto& LIVEBLURREGION = m_liveBlurPrefixes[el->liveBlurPrefix];
 
-                // expand the region: this area needs to be proper to blur it right.
-                liveBlurRegion.scale(g_pHyprOpenGL->m_renderData.pMonitor->m_scale).expand(oneBlurRadius() * 2.F);
-
-                if (auto infringement = opaque.copy().intersect(liveBlurRegion); !infringement.empty()) {
+                m_stats.regionOps++;
+                if (auto infringement = opaque.copy().intersect(LIVEBLURREGION); !infringement.empty()) {
                     // eh, this is not the correct solution, but it will do...
                     // TODO: is this *easily* fixable?
                     opaque.subtract(infringement);
+                    m_stats.regionOps++;
                 }
             }
             newDamage.subtract(opaque);
+            m_stats.regionOps++;
             if (*PDEBUGPASS)
                 m_occludedRegions.emplace_back(opaque);
         }
@@ -99,9 +116,15 @@ void CRenderPass::simplify() {
             const auto BB = el2->element->boundingBox();
             RASSERT(BB, "No bounding box for an element with live blur is illegal");
 
-            m_totalLiveBlurRegion.add(BB->copy().scale(g_pHyprOpenGL->m_renderData.pMonitor->m_scale));
+            m_totalLiveBlurRegion.add(BB->copy().scale(SCALE));
         }
     }
+
+    m_stats.planningUs = std::chrono::duration_cast<std::chrono::nanoseconds>(Time::steadyNow() - PLANSTART).count() / 1000.F;
+}
+
+const CRenderPass::SPassStats& CRenderPass::stats() const {
+    return m_stats;
 }
 
 void CRenderPass::clear() {
@@ -113,6 +136,9 @@ CRegion CRenderPass::render(const CRegion& damage_) {
 
     const auto  WILLBLUR = std::ranges::any_of(m_passElements, [](const auto& el) { return el->element->needsLiveBlur(); });
 
+    m_stats          = {};
+    m_stats.elements = m_passElements.size();
+
     m_damage = *PDEBUGPASS ? CRegion{CBox{{}, {INT32_MAX, INT32_MAX}}} : damage_.copy();
     if (*PDEBUGPASS) {
         m_occludedRegions.clear();
@@ -177,6 +203,7 @@ CRegion CRenderPass::render(const CRegion& damage_) {
     for (auto& el : m_passElements) {
         if (el->discard) {
             el->element->discard();
+            m_stats.discarded++;
             continue;
         }
 
@@ -17,6 +17,16 @@ class CRenderPass {
 
     CRegion render(const CRegion& damage_);
 
+    // counters of the last rendered pass
+    struct SPassStats {
+        size_t elements   = 0;
+        size_t discarded  = 0;
+        size_t regionOps  = 0; // region operations done while planning the pass
+        float  planningUs = 0;
+    };
+
+    const SPassStats& stats() const;
+
   private:
     CRegion              m_damage;
     std::vector<CRegion> m_occludedRegions;
@@ -25,11 +35,16 @@ class CRenderPass {
     struct SPassElementData {
         CRegion          elementDamage;
         UP<IPassElement> element;
-        bool             discard = false;
+        bool             discard        = false;
+        size_t           liveBlurPrefix = 0; // index into m_liveBlurPrefixes: live blur below this element
     };
 
     std::vector<UP<SPassElementData>> m_passElements;
 
+    // m_liveBlurPrefixes[n] is the scaled, expanded area of the first n live blur elements
+    std::vector<CRegion>              m_liveBlurPrefixes;
+    SPassStats                        m_stats;
+
     void                              simplify();
     float                             oneBlurRadius();
     void                              renderDebugData();
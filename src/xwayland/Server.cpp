@@ -14,6 +14,7 @@
 #include <unistd.h>
 #include <exception>
 #include <filesystem>
+#include <ranges>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -25,6 +26,7 @@
 #include "../defines.hpp"
 #include "../Compositor.hpp"
 #include "../managers/CursorManager.hpp"
+#include "../helpers/Launcher.hpp"
 using namespace Hyprutils::OS;
 
 // Constants
@@ -292,25 +294,29 @@ bool CXWaylandServer::create() {
     return true;
 }
 
-void CXWaylandServer::runXWayland(CFileDescriptor& notifyFD) {
-    if (!m_xFDs[0].setFlags(m_xFDs[0].getFlags() & ~FD_CLOEXEC) || !m_xFDs[1].setFlags(m_xFDs[1].getFlags() & ~FD_CLOEXEC) ||
-        !m_waylandFDs[1].setFlags(m_waylandFDs[1].getFlags() & ~FD_CLOEXEC) || !m_xwmFDs[1].setFlags(m_xwmFDs[1].getFlags() & ~FD_CLOEXEC)) {
-        Log::logger->log(Log::ERR, "Failed to unset cloexec on fds");
-        _exit(EXIT_FAILURE);
-    }
+bool CXWaylandServer::runXWayland(CFileDescriptor& notifyFD) {
+    const auto               LISTENFD0 = std::to_string(m_xFDs[0].get());
+    const auto               LISTENFD1 = std::to_string(m_xFDs[1].get());
+    const auto               DISPLAYFD = std::to_string(notifyFD.get());
+    const auto               WMFD      = std::to_string(m_xwmFDs[1].get());
 
-    auto cmd = std::format("exec Xwayland {} -rootless -core -listenfd {} -listenfd {} -displayfd {} -wm {}", m_displayName, m_xFDs[0].get(), m_xFDs[1].get(), notifyFD.get(),
-                           m_xwmFDs[1].get());
+    std::vector<std::string> argv = {"Xwayland", m_displayName, "-rootless", "-core", "-listenfd", LISTENFD0, "-listenfd", LISTENFD1, "-displayfd", DISPLAYFD, "-wm", WMFD};
 
-    auto waylandSocket = std::format("{}", m_waylandFDs[1].get());
-    setenv("WAYLAND_SOCKET", waylandSocket.c_str(), true);
+    Log::logger->log(Log::DEBUG, "Starting XWayland with \"{}\", bon voyage!", argv | std::views::join_with(' ') | std::ranges::to<std::string>());
 
-    Log::logger->log(Log::DEBUG, "Starting XWayland with \"{}\", bon voyage!", cmd);
+    const auto PID = NLauncher::spawn({
+        .argv       = std::move(argv),
+        .env        = {{"WAYLAND_SOCKET", std::format("{}", m_waylandFDs[1].get())}},
+        .inheritFDs = {m_xFDs[0].get(), m_xFDs[1].get(), m_waylandFDs[1].get(), m_xwmFDs[1].get(), notifyFD.get()},
+        .silence    = false,
+    });
 
-    execl("/bin/sh", "/bin/sh", "-c", cmd.c_str(), nullptr);
+    if (PID < 0) {
+        Log::logger->log(Log::ERR, "XWayland failed to open: {}", strerror(errno));
+        return false;
+    }
 
-    Log::logger->log(Log::ERR, "XWayland failed to open");
-    _exit(1);
+    return true;
 }
 
 bool CXWaylandServer::start() {
@@ -373,14 +379,9 @@ bool CXWaylandServer::start() {
     m_pipeSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, notifyFds[0].get(), WL_EVENT_READABLE, ::xwaylandReady, nullptr);
     m_pipeFd     = std::move(notifyFds[0]);
 
-    auto serverPID = fork();
-    if (serverPID < 0) {
-        Log::logger->log(Log::ERR, "fork failed");
+    if (!runXWayland(notifyFds[1])) {
         die();
         return false;
-    } else if (serverPID == 0) {
-        runXWayland(notifyFds[1]);
-        _exit(0);
     }
 
     return true;
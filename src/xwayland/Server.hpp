@@ -28,7 +28,7 @@ class CXWaylandServer {
 
   private:
     bool                                          tryOpenSockets();
-    void                                          runXWayland(Hyprutils::OS::CFileDescriptor& notifyFD);
+    bool                                          runXWayland(Hyprutils::OS::CFileDescriptor& notifyFD);
 
     std::string                                   m_displayName;
     int                                           m_display = -1;
@@ -62,6 +62,7 @@ void CXWM::handleCreate(xcb_create_notify_event_t* e) {
     const auto WINDOW = Desktop::View::CWindow::create(XSURF);
     g_pCompositor->m_windows.emplace_back(WINDOW);
     WINDOW->m_self = WINDOW;
+    g_pCompositor->invalidateWindowIndex();
     Log::logger->log(Log::DEBUG, "[xwm] New XWayland window at {:x} for surf {:x}", rc<uintptr_t>(WINDOW.get()), rc<uintptr_t>(XSURF.get()));
 }
 
@@ -0,0 +1,45 @@
+#include <config/ConfigChanges.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace NConfigChanges;
+
+TEST(Config, changeCategories) {
+    EXPECT_EQ(categoryOf("input:kb_layout"), CONFIG_CHANGE_INPUT);
+    EXPECT_EQ(categoryOf("device[my-mouse]:sensitivity"), CONFIG_CHANGE_INPUT);
+    EXPECT_EQ(categoryOf("general:col.active_border"), CONFIG_CHANGE_DECORATION);
+    EXPECT_EQ(categoryOf("general:gaps_in"), CONFIG_CHANGE_LAYOUT);
+    EXPECT_EQ(categoryOf("group:groupbar:font_size"), CONFIG_CHANGE_DECORATION);
+    EXPECT_EQ(categoryOf("binds:scroll_event_delay"), CONFIG_CHANGE_BINDS);
+    EXPECT_EQ(categoryOf("misc:vrr"), CONFIG_CHANGE_MISC);
+
+    EXPECT_EQ(categoryOf("bindel"), CONFIG_CHANGE_BINDS);
+    EXPECT_EQ(categoryOf("monitor"), CONFIG_CHANGE_MONITORS);
+    EXPECT_EQ(categoryOf("monitorv2"), CONFIG_CHANGE_MONITORS);
+    EXPECT_EQ(categoryOf("bezier"), CONFIG_CHANGE_ANIMATIONS);
+    EXPECT_EQ(categoryOf("windowrule"), CONFIG_CHANGE_RULES);
+    EXPECT_EQ(categoryOf("workspace"), CONFIG_CHANGE_RULES);
+    EXPECT_EQ(categoryOf("exec-once"), CONFIG_CHANGE_MISC);
+}
+
+TEST(Config, changesToString) {
+    CONFIG_CHANGES changes;
+    EXPECT_EQ(toString(changes), "");
+
+    changes.set(CONFIG_CHANGE_INPUT);
+    changes.set(CONFIG_CHANGE_RULES);
+    EXPECT_EQ(toString(changes), "input,rules");
+}
+
+TEST(Config, changesOfKeys) {
+    const auto ALL = CONFIG_CHANGES{}.set();
+
+    EXPECT_EQ(changesOf("general:gaps_in"), CONFIG_CHANGES{}.set(CONFIG_CHANGE_LAYOUT));
+    EXPECT_EQ(changesOf("misc:vrr"), CONFIG_CHANGES{}.set(CONFIG_CHANGE_MISC));
+    EXPECT_EQ(changesOf("exec-once"), CONFIG_CHANGES{}.set(CONFIG_CHANGE_MISC));
+    EXPECT_EQ(changesOf("env"), CONFIG_CHANGES{}.set(CONFIG_CHANGE_MISC));
+
+    // plugins and keywords we don't know about may affect anything
+    EXPECT_EQ(changesOf("plugin:hyprbars:bar_height"), ALL);
+    EXPECT_EQ(changesOf("hyprbars-button"), ALL);
+}
@@ -0,0 +1,86 @@
+#include <debug/FrameProfiler.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(Debug, frameProfilerStages) {
+    CFrameProfiler profiler;
+    const auto     T0 = Time::steadyNow();
+
+    // input between frames counts towards the next one
+    profiler.enterZone();
+    profiler.addZone(PROFILER_STAGE_RULES, "rules", MONITOR_INVALID, T0, T0 + 1ms);
+    profiler.leaveZone(PROFILER_STAGE_INPUT, "input", MONITOR_INVALID, T0, T0 + 3ms);
+
+    // nothing drawn, dropped
+    profiler.beginFrame(1);
+    profiler.addZone(PROFILER_STAGE_ANIMATION, "anim", 1, T0, T0 + 1ms);
+    profiler.endFrame(1);
+    EXPECT_TRUE(profiler.frames(1).empty());
+
+    profiler.beginFrame(1);
+    profiler.addZone(PROFILER_STAGE_PLAN, "plan", 1, T0, T0 + 2ms);
+    profiler.addZone(PROFILER_STAGE_RENDER, "render", 1, T0, T0 + 4ms);
+    profiler.endFrame(1);
+
+    auto frames = profiler.frames(1);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].stages[PROFILER_STAGE_PLAN], 2ms);
+    EXPECT_EQ(frames[0].stages[PROFILER_STAGE_RENDER], 4ms);
+    EXPECT_EQ(frames[0].stages[PROFILER_STAGE_RULES], 1ms);
+    EXPECT_EQ(frames[0].stages[PROFILER_STAGE_INPUT], 2ms); // minus the nested rules
+    EXPECT_EQ(frames[0].stages[PROFILER_STAGE_ANIMATION], Time::steady_dur{});
+
+    // the unbound time was taken by that frame
+    profiler.beginFrame(1);
+    profiler.addZone(PROFILER_STAGE_PLAN, "plan", 1, T0, T0 + 6ms);
+    profiler.endFrame(1);
+
+    frames = profiler.frames(1);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1].stages[PROFILER_STAGE_INPUT], Time::steady_dur{});
+
+    const auto SUMMARY = profiler.summarize(1);
+    EXPECT_EQ(SUMMARY.frames, 2u);
+    EXPECT_EQ(SUMMARY.stages[PROFILER_STAGE_PLAN].avg, 4ms);
+    EXPECT_EQ(SUMMARY.stages[PROFILER_STAGE_PLAN].max, 6ms);
+
+    const auto TRACE = profiler.chromeTrace();
+    EXPECT_TRUE(TRACE.starts_with("{\"traceEvents\":["));
+    EXPECT_TRUE(TRACE.contains("\"name\":\"input\""));
+    EXPECT_TRUE(TRACE.contains("\"name\":\"monitor 1\""));
+}
+
+TEST(Debug, frameProfilerRing) {
+    CFrameProfiler profiler;
+    const auto     T0 = Time::steadyNow();
+
+    for (size_t i = 0; i < CFrameProfiler::FRAMES_PER_MONITOR + 10; ++i) {
+        profiler.beginFrame(0);
+        profiler.addZone(PROFILER_STAGE_RENDER, "render", 0, T0, T0 + std::chrono::microseconds(i));
+        profiler.endFrame(0);
+    }
+
+    const auto FRAMES = profiler.frames(0);
+    ASSERT_EQ(FRAMES.size(), CFrameProfiler::FRAMES_PER_MONITOR);
+    EXPECT_EQ(FRAMES.front().stages[PROFILER_STAGE_RENDER], 10us);
+    EXPECT_EQ(FRAMES.back().stages[PROFILER_STAGE_RENDER], std::chrono::microseconds(CFrameProfiler::FRAMES_PER_MONITOR + 9));
+}
+
+TEST(Debug, frameProfilerRemoveMonitor) {
+    CFrameProfiler profiler;
+    const auto     T0 = Time::steadyNow();
+
+    for (MONITORID id : {0, 1}) {
+        profiler.beginFrame(id);
+        profiler.addZone(PROFILER_STAGE_RENDER, "render", id, T0, T0 + 1ms);
+        profiler.endFrame(id);
+    }
+
+    // a gone monitor takes its frames with it
+    profiler.removeMonitor(0);
+    EXPECT_EQ(profiler.monitors(), std::vector<MONITORID>({1}));
+    EXPECT_TRUE(profiler.frames(0).empty());
+    EXPECT_EQ(profiler.frames(1).size(), 1u);
+}
@@ -0,0 +1,55 @@
+#include <debug/HyprCtlBinary.hpp>
+
+#include <gtest/gtest.h>
+
+static uint32_t readU32(const std::string& data, size_t offset) {
+    uint32_t v = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        v |= sc<uint32_t>(sc<uint8_t>(data[offset + i])) << (i * 8);
+    }
+    return v;
+}
+
+TEST(Debug, hyprCtlBinaryWriter) {
+    HyprCtl::CBinaryWriter w;
+
+    w.begin(HyprCtl::CBinaryWriter::KIND_WORKSPACES);
+    w.beginRecord();
+    w.writeI64(-1);
+    w.writeString("abc");
+    w.beginRecord();
+    w.writeBool(true);
+    w.endRecord();
+    w.endRecord();
+    w.beginRecord();
+    w.writeU32(0xAABBCCDD);
+    w.endRecord();
+
+    const auto OUT = w.finish();
+
+    // header
+    EXPECT_EQ(OUT.substr(0, 3), "HYB");
+    EXPECT_EQ(sc<uint8_t>(OUT[3]), HyprCtl::CBinaryWriter::VERSION);
+    EXPECT_EQ(readU32(OUT, 4), OUT.size() - 8);
+    EXPECT_EQ(sc<uint8_t>(OUT[8]), HyprCtl::CBinaryWriter::KIND_WORKSPACES);
+    EXPECT_EQ(readU32(OUT, 9), 2U);
+
+    // first record: i64 + (u32 + 3) + nested (u32 + u8)
+    EXPECT_EQ(readU32(OUT, 13), 8U + 7U + 5U);
+    EXPECT_EQ(OUT.substr(17, 8), std::string(8, '\xFF'));
+    EXPECT_EQ(readU32(OUT, 25), 3U);
+    EXPECT_EQ(OUT.substr(29, 3), "abc");
+    EXPECT_EQ(readU32(OUT, 32), 1U);
+    EXPECT_EQ(OUT[36], 1);
+
+    // second record
+    EXPECT_EQ(readU32(OUT, 37), 4U);
+    EXPECT_EQ(readU32(OUT, 41), 0xAABBCCDD);
+    EXPECT_EQ(OUT.size(), 45UL);
+
+    // the writer is reusable
+    w.begin(HyprCtl::CBinaryWriter::KIND_ACTIVEWINDOW);
+    const auto EMPTY = w.finish();
+    EXPECT_EQ(EMPTY.size(), 13UL);
+    EXPECT_EQ(readU32(EMPTY, 9), 0U);
+}
@@ -0,0 +1,103 @@
+#include <debug/log/RollingLogFollow.hpp>
+
+#include <atomic>
+#include <thread>
+#include <poll.h>
+
+#include <gtest/gtest.h>
+
+TEST(Debug, logRingReaders) {
+    Log::CLogRing ring(16);
+
+    uint64_t      a = ring.end(), b = ring.end();
+    std::string   outA, outB;
+
+    ring.push("abc");
+    ring.push("de");
+
+    // readers don't disturb each other
+    EXPECT_EQ(ring.read(a, outA, 4), 0u);
+    EXPECT_EQ(outA, "abc\n");
+    EXPECT_EQ(ring.read(b, outB, 100), 0u);
+    EXPECT_EQ(outB, "abc\nde\n");
+    EXPECT_EQ(ring.read(a, outA, 100), 0u);
+    EXPECT_EQ(outA, outB);
+
+    // lap the reader, it gets told how much it missed and the newest ring's worth
+    ring.push("0123456");
+    ring.push("0123456");
+    ring.push("xy");
+
+    outA.clear();
+    EXPECT_EQ(ring.read(a, outA, 100), 3u);
+    EXPECT_EQ(outA, "3456\n0123456\nxy\n");
+    EXPECT_EQ(a, ring.end());
+}
+
+TEST(Debug, logRingConcurrentWriters) {
+    Log::CLogRing            ring(1024);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&ring] {
+            for (int j = 0; j < 1000; ++j) {
+                ring.push("line");
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(ring.end(), 4u * 1000 * 5);
+
+    // whatever is still in the ring is whole lines
+    uint64_t    cursor = ring.end() - 1000;
+    std::string out;
+    EXPECT_EQ(ring.read(cursor, out, 1000), 0u);
+    EXPECT_EQ(out.size(), 1000u);
+    for (size_t i = 0; i < out.size(); i += 5) {
+        EXPECT_EQ(out.substr(i, 5), "line\n");
+    }
+}
+
+TEST(Debug, logFollowWakeups) {
+    auto&      follow   = Log::CRollingLogFollow::get();
+    const auto readable = [&follow] {
+        pollfd pfd = {.fd = follow.wakeFD(), .events = POLLIN};
+        return poll(&pfd, 1, 0) == 1;
+    };
+
+    ASSERT_GE(follow.wakeFD(), 0);
+
+    follow.startFollower();
+
+    follow.addLog("a");
+    EXPECT_TRUE(readable());
+    follow.ackWake();
+    EXPECT_FALSE(readable());
+    follow.addLog("b");
+    EXPECT_TRUE(readable());
+
+    // lines logged while we ack must never leave the flag set with nothing to wake us
+    std::atomic<bool> done = false;
+    std::thread       producer([&] {
+        while (!done.load()) {
+            follow.addLog("line");
+        }
+    });
+
+    for (int i = 0; i < 100000; ++i) {
+        follow.ackWake();
+    }
+
+    done = true;
+    producer.join();
+
+    follow.addLog("last");
+    EXPECT_TRUE(readable());
+
+    follow.ackWake();
+    follow.stopFollower();
+}
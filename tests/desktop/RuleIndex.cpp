@@ -0,0 +1,72 @@
+#include <desktop/rule/RuleIndex.hpp>
+#include <desktop/rule/windowRule/WindowRule.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Desktop::Rule;
+
+TEST(Desktop, ruleIndex) {
+    std::vector<SP<IRule>> rules;
+
+    auto literal = makeShared<CWindowRule>("literal");
+    literal->registerMatch(RULE_PROP_CLASS, "kitty");
+    rules.emplace_back(literal);
+
+    auto regex = makeShared<CWindowRule>("regex");
+    regex->registerMatch(RULE_PROP_CLASS, "(firefox|chromium)");
+    regex->registerMatch(RULE_PROP_TITLE, ".*Picture-in-Picture.*");
+    rules.emplace_back(regex);
+
+    auto negative = makeShared<CWindowRule>("negative");
+    negative->registerMatch(RULE_PROP_CLASS, "negative:kitty");
+    rules.emplace_back(negative);
+
+    auto unconstrained = makeShared<CWindowRule>("unconstrained");
+    unconstrained->registerMatch(RULE_PROP_FLOATING, "true");
+    rules.emplace_back(unconstrained);
+
+    auto broken = makeShared<CWindowRule>("broken");
+    broken->registerMatch(RULE_PROP_CLASS, "(kitty");
+    rules.emplace_back(broken);
+
+    CRuleIndex index;
+    index.rebuild(rules);
+
+    EXPECT_EQ(index.size(), rules.size());
+
+    // INDEXED_PROPS[0] is class, [1] is title
+    std::vector<uint8_t> out;
+
+    index.match(0, "kitty", out);
+    ASSERT_EQ(out.size(), rules.size());
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 0);
+    EXPECT_EQ(out[3], 1);
+    EXPECT_EQ(out[4], 0);
+
+    index.match(0, "firefox", out);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 1);
+    EXPECT_EQ(out[2], 1);
+    EXPECT_EQ(out[3], 1);
+
+    // anchored on both ends, like FullMatch
+    index.match(0, "firefox-esr", out);
+    EXPECT_EQ(out[1], 0);
+
+    index.match(1, "Picture-in-Picture - YouTube", out);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 1);
+
+    index.match(1, "YouTube", out);
+    EXPECT_EQ(out[1], 0);
+
+    const auto GEN = index.generation();
+    rules.pop_back();
+    index.rebuild(rules);
+
+    EXPECT_NE(index.generation(), GEN);
+    index.match(0, "kitty", out);
+    EXPECT_EQ(out.size(), rules.size());
+}
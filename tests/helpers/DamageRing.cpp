@@ -0,0 +1,50 @@
+#include <helpers/DamageRing.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(Helpers, damageRingSince) {
+    CDamageRing ring;
+    ring.setSize({100, 100});
+    ring.rotate();
+
+    const auto START = ring.frames();
+    EXPECT_TRUE(ring.getDamageSince(START).empty());
+
+    ring.damage(CBox{0, 0, 10, 10});
+    ring.rotate();
+    ring.damage(CBox{50, 50, 10, 10});
+
+    // both the rendered frame and what's pending
+    auto damage = ring.getDamageSince(START);
+    EXPECT_TRUE(damage.containsPoint({5, 5}));
+    EXPECT_TRUE(damage.containsPoint({55, 55}));
+    EXPECT_FALSE(damage.containsPoint({30, 30}));
+
+    EXPECT_FALSE(ring.getDamageSince(ring.frames()).containsPoint({5, 5}));
+
+    // further back than the ring remembers
+    for (int i = 0; i < DAMAGE_RING_PREVIOUS_LEN; ++i) {
+        ring.rotate();
+    }
+    EXPECT_TRUE(ring.getDamageSince(START).containsPoint({30, 30}));
+}
+
+TEST(Helpers, damageRingCoalesce) {
+    CDamageRing ring;
+    ring.setSize({1000, 1000});
+
+    // a few rects are kept as they are
+    ring.damage(CBox{0, 0, 10, 10});
+    ring.damage(CBox{100, 100, 10, 10});
+    EXPECT_FALSE(ring.getBufferDamage(1).containsPoint({50, 50}));
+
+    // lots of them get merged
+    for (int i = 0; i < DAMAGE_RING_MAX_RECTS * 4; ++i) {
+        ring.damage(CBox{i * 20, 500, 5, 5});
+    }
+
+    auto damage = ring.getBufferDamage(1);
+    EXPECT_LE(damage.getRects().size(), size_t{DAMAGE_RING_MAX_RECTS});
+    EXPECT_TRUE(damage.containsPoint({5, 5}));
+    EXPECT_TRUE(damage.containsPoint({(DAMAGE_RING_MAX_RECTS * 4 - 1) * 20 + 2, 502}));
+}
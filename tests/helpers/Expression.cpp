@@ -0,0 +1,23 @@
+#include <helpers/math/Expression.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(Helpers, expressionCompiled) {
+    double            w = 100, h = 50;
+
+    Math::CExpression expr;
+    expr.bindVariable("window_w", &w);
+    expr.bindVariable("window_h", &h);
+
+    ASSERT_TRUE(expr.compile("window_w * 0.5 + window_h"));
+    EXPECT_EQ(expr.evaluate(), 100.0);
+
+    // bound variables are read on every evaluation
+    w = 300;
+    h = 10;
+    EXPECT_EQ(expr.evaluate(), 160.0);
+
+    Math::CExpression broken;
+    broken.bindVariable("window_w", &w);
+    EXPECT_FALSE(broken.compile("window_w * monitor_w"));
+}
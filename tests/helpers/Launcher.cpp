@@ -0,0 +1,49 @@
+#include <helpers/Launcher.hpp>
+
+#include <sys/wait.h>
+
+#include <gtest/gtest.h>
+
+static int exitCodeOf(pid_t pid) {
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status))
+        return -1;
+    return WEXITSTATUS(status);
+}
+
+TEST(Helpers, launcherSplit) {
+    auto argv = NLauncher::splitSimpleCommand("  kitty\t--class  term ");
+    ASSERT_TRUE(argv.has_value());
+    EXPECT_EQ(*argv, (std::vector<std::string>{"kitty", "--class", "term"}));
+
+    EXPECT_TRUE(NLauncher::splitSimpleCommand("foot --override=font=mono").has_value());
+
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("").has_value());
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("FOO=bar kitty").has_value());
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("grim - | wl-copy").has_value());
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("notify-send \"hi there\"").has_value());
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("kitty ~/notes").has_value());
+    EXPECT_FALSE(NLauncher::splitSimpleCommand("echo $HOME").has_value());
+}
+
+TEST(Helpers, launcherSpawn) {
+    const auto BEFORE = NLauncher::stats();
+
+    // direct exec, and the environment override reaches the child
+    auto pid = NLauncher::spawn({.argv = {"sh", "-c", "exit $LAUNCHER_TEST"}, .env = {{"LAUNCHER_TEST", "3"}}});
+    ASSERT_GT(pid, 0);
+    EXPECT_EQ(exitCodeOf(pid), 3);
+
+    // needs a shell
+    pid = NLauncher::spawn({.command = "exit 4"});
+    ASSERT_GT(pid, 0);
+    EXPECT_EQ(exitCodeOf(pid), 4);
+
+    // nothing to exec and no shell to fall back to
+    EXPECT_EQ(NLauncher::spawn({.argv = {"/nonexistent/launcher-test"}}), -1);
+
+    const auto& AFTER = NLauncher::stats();
+    EXPECT_EQ(AFTER.spawns, BEFORE.spawns + 2);
+    EXPECT_EQ(AFTER.direct, BEFORE.direct + 1);
+    EXPECT_EQ(AFTER.failures, BEFORE.failures + 1);
+}
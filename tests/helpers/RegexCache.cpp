@@ -0,0 +1,23 @@
+#include <helpers/RegexCache.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(Helpers, regexCacheReuse) {
+    CRegexCache cache(2);
+
+    const auto* first = &cache.get("kitty|foot");
+    EXPECT_TRUE(re2::RE2::FullMatch("foot", *first));
+    EXPECT_EQ(&cache.get("kitty|foot"), first);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // least recently used goes first
+    cache.get("firefox");
+    cache.get("kitty|foot");
+    cache.get("^(steam)$");
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(&cache.get("kitty|foot"), first);
+
+    // invalid patterns are cached too, they just never match
+    EXPECT_FALSE(cache.get("(").ok());
+    EXPECT_FALSE(re2::RE2::FullMatch("(", cache.get("(")));
+}
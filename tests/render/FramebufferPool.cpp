@@ -0,0 +1,88 @@
+#include <render/FramebufferPool.hpp>
+
+#include <drm_fourcc.h>
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+    // keeps the bookkeeping, skips GL
+    class CTestFramebufferPool : public CFramebufferPool {
+      protected:
+        void allocate(CFramebuffer& fb, const Vector2D& size, DRMFormat format) override {
+            fb.m_size      = size;
+            fb.m_drmFormat = format;
+        }
+
+        void attachStencil(CFramebuffer& fb, SP<CTexture> stencil) override {
+            ;
+        }
+    };
+}
+
+TEST(Render, framebufferPoolReuse) {
+    CTestFramebufferPool pool;
+
+    auto                 a = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+    auto                 b = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+    EXPECT_NE(a.get(), b.get());
+
+    const auto A = a.get();
+    a.reset();
+    auto c = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+    EXPECT_EQ(c.get(), A);
+
+    // a free one of another size is reallocated rather than piling up
+    b.reset();
+    auto d = pool.acquire({50, 50}, DRM_FORMAT_XRGB8888);
+    EXPECT_EQ(d->m_size, Vector2D(50, 50));
+
+    const auto STATS = pool.stats();
+    EXPECT_EQ(STATS.framebuffers, 2u);
+    EXPECT_EQ(STATS.inUse, 2u);
+    EXPECT_EQ(STATS.allocations, 3u);
+    EXPECT_EQ(STATS.reuses, 1u);
+    EXPECT_EQ(STATS.bytes, 100u * 100 * 4 + 50 * 50 * 4);
+}
+
+TEST(Render, framebufferPoolStencil) {
+    CTestFramebufferPool pool;
+    const auto           STENCIL = makeShared<CTexture>();
+
+    auto                 a = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888, STENCIL);
+    const auto           A = a.get();
+    a.reset();
+
+    // the stencil has to stay the size of the monitor, so its framebuffer isn't resized
+    auto b = pool.acquire({50, 50}, DRM_FORMAT_XRGB8888);
+    EXPECT_NE(b.get(), A);
+    EXPECT_EQ(pool.stats().framebuffers, 2u);
+
+    auto c = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+    EXPECT_EQ(c.get(), A);
+}
+
+TEST(Render, framebufferPoolReleaseIdle) {
+    CTestFramebufferPool pool;
+
+    auto                 held = pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+    pool.acquire({100, 100}, DRM_FORMAT_XRGB8888);
+
+    const auto NOW = Time::steadyNow();
+
+    // only what nobody holds can go
+    ASSERT_TRUE(pool.nextIdleRelease(10s).has_value());
+    EXPECT_LE(*pool.nextIdleRelease(10s), NOW + 10s);
+
+    pool.releaseIdle(10s, NOW);
+    EXPECT_EQ(pool.stats().framebuffers, 2u);
+
+    pool.releaseIdle(10s, NOW + 11s);
+    EXPECT_EQ(pool.stats().framebuffers, 1u);
+    EXPECT_EQ(pool.stats().inUse, 1u);
+    EXPECT_FALSE(pool.nextIdleRelease(10s).has_value());
+
+    held.reset();
+    pool.releaseIdle(10s, NOW + 11s);
+    EXPECT_TRUE(pool.empty());
+}
@@ -0,0 +1,145 @@
+#include <render/ProgramCache.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+namespace {
+    // only the files, skips GL
+    class CTestProgramCache : public CProgramBinaryCache {
+      public:
+        CTestProgramCache(const std::filesystem::path& dir, const std::string& driver) : CProgramBinaryCache(dir, driver) {
+            ;
+        }
+
+        using CProgramBinaryCache::readEntry;
+        using CProgramBinaryCache::SEntry;
+        using CProgramBinaryCache::writeEntry;
+    };
+
+    // a fresh cache directory, gone again with the test
+    class CTempDir {
+      public:
+        CTempDir() : m_path(std::filesystem::temp_directory_path() / std::format("hyprland-program-cache-test-{}", getpid())) {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+
+        ~CTempDir() {
+            std::error_code ec;
+            std::filesystem::remove_all(m_path, ec);
+        }
+
+        std::filesystem::path m_path;
+    };
+
+    size_t filesIn(const std::filesystem::path& dir) {
+        return std::ranges::count_if(std::filesystem::recursive_directory_iterator(dir), [](const auto& entry) { return entry.is_regular_file(); });
+    }
+
+    size_t directoriesIn(const std::filesystem::path& dir) {
+        return std::ranges::count_if(std::filesystem::directory_iterator(dir), [](const auto& entry) { return entry.is_directory(); });
+    }
+
+    void backdateAll(const std::filesystem::path& dir, std::chrono::hours by) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+            if (entry.is_regular_file())
+                std::filesystem::last_write_time(entry.path(), std::filesystem::file_time_type::clock::now() - by);
+        }
+    }
+}
+
+TEST(Render, programCacheRoundTrip) {
+    CTempDir          tmp;
+
+    CTestProgramCache cache(tmp.m_path, "driver");
+
+    EXPECT_FALSE(cache.readEntry("vert", "frag").has_value());
+    ASSERT_TRUE(cache.writeEntry("vert", "frag", {.format = 42, .data = {1, 2, 3}}));
+
+    const auto ENTRY = cache.readEntry("vert", "frag");
+    ASSERT_TRUE(ENTRY.has_value());
+    EXPECT_EQ(ENTRY->format, 42u);
+    EXPECT_EQ(ENTRY->data, std::vector<char>({1, 2, 3}));
+
+    // either source or the driver changing misses
+    EXPECT_FALSE(cache.readEntry("vert", "frag2").has_value());
+    EXPECT_FALSE(CTestProgramCache(tmp.m_path, "driver2").readEntry("vert", "frag").has_value());
+}
+
+TEST(Render, programCacheDriversApart) {
+    CTempDir          tmp;
+
+    CTestProgramCache a(tmp.m_path, "driver");
+    CTestProgramCache b(tmp.m_path, "driver2");
+
+    a.writeEntry("vert", "frag", {.format = 1, .data = {1}});
+    b.writeEntry("vert", "frag", {.format = 2, .data = {2}});
+
+    // a nested session or another GPU prunes without touching what's fresh for us
+    b.prune();
+    EXPECT_EQ(directoriesIn(tmp.m_path), 2u);
+    EXPECT_EQ(filesIn(tmp.m_path), 2u);
+    EXPECT_EQ(a.readEntry("vert", "frag").value().format, 1u);
+    EXPECT_EQ(b.readEntry("vert", "frag").value().format, 2u);
+}
+
+TEST(Render, programCachePruneByAge) {
+    CTempDir          tmp;
+
+    CTestProgramCache cache(tmp.m_path, "driver");
+    cache.writeEntry("vert", "frag", {.format = 1, .data = {1}});
+    cache.writeEntry("vert", "oldFrag", {.format = 1, .data = {2}});
+    CTestProgramCache(tmp.m_path, "oldDriver").writeEntry("vert", "frag", {.format = 1, .data = {3}});
+
+    backdateAll(tmp.m_path, std::chrono::days(60));
+
+    // loading refreshes an entry, whatever nobody loaded for long goes, and so does the other driver's emptied directory
+    EXPECT_TRUE(cache.readEntry("vert", "frag").has_value());
+    cache.prune();
+
+    EXPECT_EQ(filesIn(tmp.m_path), 1u);
+    EXPECT_EQ(directoriesIn(tmp.m_path), 1u);
+    EXPECT_TRUE(cache.readEntry("vert", "frag").has_value());
+
+    // recent entries stay even when this run didn't use them
+    cache.writeEntry("vert", "cmFrag", {.format = 1, .data = {4}});
+    CTestProgramCache(tmp.m_path, "driver").prune();
+    EXPECT_EQ(filesIn(tmp.m_path), 2u);
+}
+
+TEST(Render, programCachePruneLeftovers) {
+    CTempDir          tmp;
+
+    CTestProgramCache cache(tmp.m_path, "driver");
+    cache.writeEntry("vert", "frag", {.format = 1, .data = {1}});
+
+    // a store that died before its rename, and one that is still going on
+    const auto OLD = tmp.m_path / "0000000000000000.bin.1.tmp";
+    const auto NEW = tmp.m_path / "0000000000000000.bin.2.tmp";
+    std::ofstream(OLD) << "x";
+    std::ofstream(NEW) << "x";
+    std::filesystem::last_write_time(OLD, std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+
+    // not ours, left alone
+    std::ofstream(tmp.m_path / "README") << "x";
+
+    cache.prune();
+
+    EXPECT_FALSE(std::filesystem::exists(OLD));
+    EXPECT_TRUE(std::filesystem::exists(NEW));
+    EXPECT_TRUE(std::filesystem::exists(tmp.m_path / "README"));
+    EXPECT_TRUE(cache.readEntry("vert", "frag").has_value());
+
+    // a truncated entry is dropped on read
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(tmp.m_path)) {
+        if (entry.path().extension() == ".bin")
+            std::filesystem::resize_file(entry.path(), 4);
+    }
+
+    EXPECT_FALSE(cache.readEntry("vert", "frag").has_value());
+    EXPECT_EQ(filesIn(tmp.m_path), 2u);
+}